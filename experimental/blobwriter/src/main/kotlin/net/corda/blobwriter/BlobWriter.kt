@@ -2,15 +2,32 @@
 
 package net.corda.blobwriter
 
+import net.corda.core.contracts.AlwaysAcceptAttachmentConstraint
+import net.corda.core.contracts.Command
+import net.corda.core.contracts.CommandData
+import net.corda.core.contracts.ContractState
+import net.corda.core.contracts.PrivacySalt
+import net.corda.core.contracts.TransactionState
+import net.corda.core.crypto.Crypto
+import net.corda.core.crypto.SignableData
+import net.corda.core.crypto.SignatureMetadata
+import net.corda.core.crypto.sign
+import net.corda.core.identity.AbstractParty
+import net.corda.core.identity.CordaX500Name
+import net.corda.core.identity.Party
+import net.corda.core.internal.createComponentGroups
 import net.corda.core.serialization.SerializationContext
 import net.corda.core.serialization.SerializationDefaults
 import net.corda.core.serialization.internal.SerializationEnvironment
 import net.corda.core.serialization.internal._contextSerializationEnv
 import net.corda.core.serialization.serialize
+import net.corda.core.transactions.SignedTransaction
+import net.corda.core.transactions.WireTransaction
 import net.corda.serialization.internal.*
 import net.corda.serialization.internal.amqp.AbstractAMQPSerializationScheme
 import net.corda.serialization.internal.amqp.amqpMagic
 import java.io.File
+import java.math.BigInteger
 
 object AMQPInspectorSerializationScheme : AbstractAMQPSerializationScheme(emptyList()) {
     override fun canDeserializeVersion (
@@ -74,6 +91,46 @@ data class _L_i__ (val listy: List<_i_>)
 
 data class _ALd_ (val a: Array<List<Double>>)
 
+data class _state_ (val a: Int, override val participants: List<AbstractParty>) : ContractState
+data class _command_ (val a: Int) : CommandData
+
+/**
+ * A transaction with one output and one command, both signed for by the
+ * notary, written as a WireTransaction and as a SignedTransaction. Each
+ * file is named for the id Corda gives the transaction so the inspector
+ * can check it recomputes the same one.
+ */
+fun writeTransactions (path: String) {
+    val keys = Crypto.deriveKeyPairFromEntropy (Crypto.EDDSA_ED25519_SHA512, BigInteger.valueOf (1))
+    val notary = Party (CordaX500Name ("Notary", "London", "GB"), keys.public)
+
+    val state = TransactionState (
+            _state_ (1, listOf (notary)),
+            "net.corda.blobwriter.Contract",
+            notary,
+            constraint = AlwaysAcceptAttachmentConstraint)
+
+    val wtx = WireTransaction (
+            createComponentGroups (
+                    emptyList(),
+                    listOf (state),
+                    listOf (Command (_command_ (2), keys.public)),
+                    emptyList(),
+                    notary,
+                    null,
+                    emptyList(),
+                    null),
+            PrivacySalt (ByteArray (32) { (it + 1).toByte() }))
+
+    val signature = keys.sign (SignableData (
+            wtx.id,
+            SignatureMetadata (4, Crypto.findSignatureScheme (keys.public).schemeNumberID)))
+
+    File ("$path/${wtx.id}.wtx").writeBytes (wtx.serialize().bytes)
+    File ("$path/${wtx.id}.stx").writeBytes (
+            SignedTransaction (wtx, listOf (signature)).serialize().bytes)
+}
+
 fun main (args: Array<String>) {
     initialiseSerialization()
     val path = "../cpp-serializer/bin/test-files";
@@ -146,6 +203,8 @@ fun main (args: Array<String>) {
 
     )
 
+    writeTransactions (path)
+
 
 }
 
@@ -0,0 +1,230 @@
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <iostream>
+
+#include <sys/stat.h>
+
+#include "amqp/JSON.h"
+#include "amqp/Binary.h"
+#include "amqp/AMQPHeader.h"
+#include "amqp/Validation.h"
+#include "amqp/ReaderCache.h"
+
+#include "CordaBytes.h"
+#include "BlobInspector.h"
+
+/******************************************************************************/
+
+/**
+ * Decode each blob given to us repeatedly, once with every node checked,
+ * once trusting it and once with every node checked but the readers
+ * kept from one decode to the next, and report what each costs.
+ *
+ *     blob-bench <iterations> <blob>...
+ *
+ * Or escape the whole of each file as though it were one JSON string
+ * with each engine that can here, against the scalar one.
+ *
+ *     blob-bench --escape <iterations> <file>...
+ *
+ * Or render each file as hex and as base64, as though it were one
+ * binary value, the same way.
+ *
+ *     blob-bench --binary <iterations> <file>...
+ */
+
+/******************************************************************************/
+
+namespace {
+
+    double
+    time (BlobInspector & inspector_, long iterations_) {
+        auto start = std::chrono::steady_clock::now();
+
+        std::size_t chars { 0 };
+        for (long i { 0 } ; i < iterations_ ; ++i) {
+            chars += inspector_.dump().size();
+        }
+
+        auto end = std::chrono::steady_clock::now();
+
+        // make sure the work can't be optimised away
+        if (!chars) {
+            std::cerr << "nothing decoded" << std::endl;
+        }
+
+        return std::chrono::duration<double, std::nano> (end - start).count()
+            / iterations_;
+    }
+
+    /**
+     * Time [encode_] appending the whole of [text_] to a string
+     */
+    template<class Encode>
+    double
+    time (const std::string & text_, Encode encode_, long iterations_) {
+        std::string out;
+        out.reserve (2 * text_.size());
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::size_t chars { 0 };
+        for (long i { 0 } ; i < iterations_ ; ++i) {
+            out.clear();
+            encode_ (text_, out);
+            chars += out.size();
+        }
+
+        auto end = std::chrono::steady_clock::now();
+
+        if (!chars && !text_.empty()) {
+            std::cerr << "nothing encoded" << std::endl;
+        }
+
+        return std::chrono::duration<double, std::nano> (end - start).count()
+            / iterations_;
+    }
+
+    /**
+     * Time [encoder_] with each of its [kernels_] the CPU has against its
+     * scalar one over each file, reported under [label_]
+     */
+    template<class Encoder>
+    void
+    compare (
+        const char * label_,
+        const std::string & text_,
+        amqp::internal::cpu::Kernels kernels_,
+        Encoder encoder_,
+        long iterations_
+    ) {
+        using amqp::internal::cpu::Engine;
+
+        auto with = [&encoder_](Engine engine_) {
+            return [&encoder_, engine_](const std::string & in_, std::string & out_) {
+                encoder_ (in_, out_, engine_);
+            };
+        };
+
+        auto scalar = time (text_, with (Engine::Scalar), iterations_);
+
+        std::cout << "  " << label_ << " : scalar " << scalar << " ns";
+
+        for (auto engine : amqp::internal::cpu::available (kernels_)) {
+            if (engine == Engine::Best || engine == Engine::Scalar) continue;
+
+            auto t = time (text_, with (engine), iterations_);
+
+            std::cout << ", " << amqp::internal::cpu::toString (engine) << " " << t << " ns"
+                      << " (" << (scalar / t) << "x)";
+        }
+
+        std::cout << std::endl;
+    }
+
+    int
+    encode (int argc, char **argv, bool binary_, long iterations_) {
+        namespace json = amqp::internal::json;
+        namespace binary = amqp::internal::binary;
+
+        for (int i { 3 } ; i < argc ; ++i) {
+            std::ifstream in (argv[i], std::ios::binary);
+
+            if (!in) {
+                std::cerr << argv[i] << " : missing" << std::endl;
+                continue;
+            }
+
+            std::stringstream text;
+            text << in.rdbuf();
+
+            std::cout << argv[i] << std::endl;
+
+            if (binary_) {
+                compare ("hex", text.str(), binary::KERNELS,
+                    [](auto & in_, auto & out_, auto e_) { binary::hex (in_, out_, e_); },
+                    iterations_);
+                compare ("base64", text.str(), binary::KERNELS,
+                    [](auto & in_, auto & out_, auto e_) { binary::base64 (in_, out_, e_); },
+                    iterations_);
+            } else {
+                compare ("escape", text.str(), json::KERNELS,
+                    [](auto & in_, auto & out_, auto e_) { json::escape (in_, out_, e_); },
+                    iterations_);
+            }
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+}
+
+/******************************************************************************/
+
+int
+main (int argc, char **argv) {
+    std::string mode { argc > 1 ? argv[1] : "" };
+    bool encoding = mode == "--escape" || mode == "--binary";
+
+    if (argc < (encoding ? 4 : 3)) {
+        std::cerr << "usage: " << argv[0] << " [--escape | --binary] <iterations> <blob>..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    long iterations = std::atol (argv[encoding ? 2 : 1]);
+
+    if (iterations <= 0) {
+        std::cerr << "iterations must be positive" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (encoding) {
+        return encode (argc, argv, mode == "--binary", iterations);
+    }
+
+    for (int i { 2 } ; i < argc ; ++i) {
+        struct stat results { };
+
+        if (stat (argv[i], &results) != 0) {
+            std::cerr << argv[i] << " : missing" << std::endl;
+            continue;
+        }
+
+        CordaBytes cb (argv[i]);
+
+        if (cb.encoding() != amqp::DATA_AND_STOP) {
+            std::cerr << argv[i] << " : bad encoding" << std::endl;
+            continue;
+        }
+
+        amqp::internal::ReaderCache readers;
+
+        BlobInspector strict (cb, amqp::Validation::Strict);
+        BlobInspector trusted (cb, amqp::Validation::Trusted);
+        BlobInspector cached (cb, readers);
+
+        try {
+            auto s = time (strict, iterations);
+            auto t = time (trusted, iterations);
+            auto c = time (cached, iterations);
+
+            std::cout << argv[i]
+                      << " : strict " << s << " ns"
+                      << ", trusted " << t << " ns"
+                      << " (" << (100.0 * (s - t) / s) << "% saved)"
+                      << ", cached " << c << " ns"
+                      << " (" << (100.0 * (s - c) / s) << "% saved)"
+                      << std::endl;
+        } catch (const std::exception & e) {
+            std::cerr << argv[i] << " : " << e.what() << std::endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************/
@@ -1,72 +1,326 @@
 #include "BlobInspector.h"
 #include "CordaBytes.h"
 
+#include <optional>
 #include <iostream>
-#include <sstream>
 
 #include "proton/codec.h"
 #include "proton/proton_wrapper.h"
 
 #include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
 
+#include "amqp/Budget.h"
+#include "amqp/Binary.h"
+#include "amqp/Nested.h"
+#include "amqp/Verifier.h"
+#include "amqp/Evolution.h"
+#include "amqp/RawEnvelope.h"
+#include "amqp/ReaderCache.h"
 #include "amqp/CompositeFactory.h"
+#include "amqp/LazyCompositeFactory.h"
+#include "amqp/schema/described-types/IndexedSchema.h"
+#include "amqp/schema/descriptors/corda-descriptors/EnvelopeDescriptor.h"
 #include "amqp/schema/described-types/Envelope.h"
 
 /******************************************************************************/
 
-BlobInspector::BlobInspector (CordaBytes & cb_)
-    : m_data { pn_data (cb_.size()) }
+BlobInspector::BlobInspector (
+    CordaBytes & cb_,
+    amqp::Validation validation_,
+    const amqp::Limits & limits_,
+    const amqp::Rendering & rendering_
+) : m_data { nullptr }
+  , m_size (cb_.size())
+  , m_validation (validation_)
+  , m_limits (limits_)
+  , m_share (nullptr)
+  , m_rendering (rendering_)
+  , m_evolution (nullptr)
+  , m_cache (nullptr)
+  , m_section (nullptr)
 {
-    // returns how many bytes we processed which right now we don't care
-    // about but I assume there is a case where it doesn't process the
-    // entire file
-    auto rtn = pn_data_decode (m_data, cb_.bytes(), cb_.size());
-    assert (rtn == cb_.size());
+    if (m_size > m_limits.bytes) {
+        throw amqp::LimitExceeded ("blob exceeds its byte limit");
+    }
+
+    decode (std::string_view (cb_.bytes(), cb_.size()));
+}
+
+/******************************************************************************/
+
+BlobInspector::BlobInspector (
+    CordaBytes & cb_,
+    const amqp::internal::Evolution & evolution_,
+    amqp::Validation validation_,
+    const amqp::Limits & limits_,
+    const amqp::Rendering & rendering_
+) : BlobInspector (cb_, validation_, limits_, rendering_) {
+    m_evolution = &evolution_;
+}
+
+/******************************************************************************/
+
+BlobInspector::BlobInspector (
+    CordaBytes & cb_,
+    amqp::internal::ReaderCache & cache_,
+    const amqp::Limits & limits_,
+    const amqp::Rendering & rendering_
+) : BlobInspector (std::string_view (cb_.bytes(), cb_.size()), cache_, limits_, rendering_)
+{ }
+
+/******************************************************************************/
+
+BlobInspector::BlobInspector (
+    std::string_view blob_,
+    amqp::internal::ReaderCache & cache_,
+    const amqp::Limits & limits_,
+    const amqp::Rendering & rendering_
+) : m_data { nullptr }
+  , m_size (blob_.size())
+  , m_validation (cache_.validation())
+  , m_limits (limits_)
+  , m_share (nullptr)
+  , m_rendering (rendering_)
+  , m_evolution (nullptr)
+  , m_cache (&cache_)
+  , m_section (nullptr)
+{
+    if (m_size > m_limits.bytes) {
+        throw amqp::LimitExceeded ("blob exceeds its byte limit");
+    }
+
+    if (auto raw = amqp::internal::RawEnvelope::locate (blob_)) {
+        try {
+            m_section = &cache_.section (raw->schema, raw->transforms, m_limits);
+        } catch (const std::runtime_error &) {
+            // leave it to the full decode to report what's wrong with it
+        }
+
+        if (m_section) {
+            decode (raw->value);
+            return;
+        }
+    }
+
+    decode (blob_);
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::decode (std::string_view bytes_) {
+    m_data = pn_data (bytes_.size());
+
+    // returns how many bytes we processed, anything short of the whole
+    // blob means it's malformed
+    auto rtn = pn_data_decode (m_data, bytes_.data(), bytes_.size());
+
+    if (rtn < 0 || static_cast<size_t>(rtn) != bytes_.size()) {
+        pn_data_free (m_data);
+        throw std::runtime_error ("Failed to decode blob");
+    }
+}
+
+/******************************************************************************/
+
+BlobInspector::~BlobInspector() {
+    pn_data_free (m_data);
 }
 
 /******************************************************************************/
 
+/**
+ * Everything we read from here on is charged to the blob's budget, its
+ * size is taken off the top as that's already been spent. Blobs nested
+ * in ours share whatever of it we leave, a level deeper, and are only
+ * stringified once they've all been decoded.
+ */
 std::string
 BlobInspector::dump() {
-    std::unique_ptr<amqp::internal::schema::Envelope> envelope;
+    amqp::internal::Nested nested;
+    amqp::internal::binary::Scope rendering (m_rendering);
+
+    uPtr<amqp::reader::IValue> value;
+    std::optional<amqp::internal::Budget::Share> left;
+
+    {
+        std::optional<amqp::internal::Budget> budget;
+
+        if (m_share) {
+            budget.emplace (*m_share);
+        } else {
+            budget.emplace (m_limits);
+        }
+
+        amqp::internal::Budget::Scope scope (*budget);
+        amqp::internal::Budget::bytes (m_size);
+
+        amqp::internal::Nested::Scope collecting (nested);
+
+        value = m_section ? dumpValue() : dumpEnvelope();
+        left = budget->nested();
+    }
+
+    if (nested.size()) {
+        inspect (nested, *left);
+    }
+
+    // We wrap our output like this to make sure it's valid JSON to
+    // facilitate easy pretty printing
+    return value->dump() + " }";
+}
 
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+BlobInspector::dumpEnvelope() {
     if (pn_data_is_described (m_data)) {
         proton::auto_enter p (m_data);
 
         auto a = pn_data_get_ulong(m_data);
 
-        envelope.reset (
-                dynamic_cast<amqp::internal::schema::Envelope *> (
-                        amqp::internal::AMQPDescriptorRegistory[a]->build(m_data).release()));
+        // types are only built when a reader needs them, if at all
+        m_envelope = dynamic_cast<const amqp::internal::schema::descriptors::EnvelopeDescriptor &> (
+                amqp::internal::registeredDescriptor (a)).index (m_data);
     }
 
-    amqp::internal::CompositeFactory cf;
+    // a one off decode only needs the readers for the types it reaches
+    const amqp::internal::CompositeFactory * cf;
 
-    cf.process (envelope->schema());
+    if (m_cache) {
+        cf = &m_cache->factory (m_envelope->schema(), &m_envelope->transforms());
+    } else {
+        m_factory = std::make_unique<amqp::internal::LazyCompositeFactory> (
+            m_validation, m_evolution, &m_envelope->transforms());
+        m_factory->process (m_envelope->schema());
+        cf = m_factory.get();
+    }
 
-    auto reader = cf.byDescriptor (envelope->descriptor());
+    auto reader = cf->byDescriptor (m_envelope->descriptor());
     assert (reader);
 
+    // move to the actual blob entry in the tree - ideally we'd have
+    // saved this on the Envelope but that's not easily doable as we
+    // can't grab an actual copy of our data pointer
+    proton::auto_enter p (m_data);
+    pn_data_next (m_data);
+    proton::is_list (m_data);
+    assert (pn_data_get_list (m_data) == 3);
+
+    proton::auto_enter p2 (m_data);
+
+    return reader->dump ("{ Parsed", m_data, m_envelope->schema());
+}
+
+/******************************************************************************/
+
+/**
+ * All we decoded was the value, everything else comes from the section
+ * we share with every blob carrying the same schema bytes
+ */
+uPtr<amqp::reader::IValue>
+BlobInspector::dumpValue() {
+    pn_data_rewind (m_data);
+    pn_data_next (m_data);
+
+    std::string descriptor;
     {
-        // move to the actual blob entry in the tree - ideally we'd have
-        // saved this on the Envelope but that's not easily doable as we
-        // can't grab an actual copy of our data pointer
+        proton::is_described (m_data);
         proton::auto_enter p (m_data);
-        pn_data_next (m_data);
-        proton::is_list (m_data);
-        assert (pn_data_get_list (m_data) == 3);
-        {
-            proton::auto_enter p (m_data);
+        descriptor = proton::get_symbol<std::string> (m_data);
+    }
+
+    auto reader = m_section->factory.byDescriptor (descriptor);
+
+    if (!reader) {
+        throw std::runtime_error ("No reader for " + descriptor);
+    }
+
+    return reader->dump ("{ Parsed", m_data, *m_section->schema);
+}
+
+/******************************************************************************/
+
+/**
+ * Nested blobs are rendered as they'd be on their own, one we can't
+ * decode, that's nested deeper than our limits allow, or that there's no
+ * time left to start on, is left as the bytes it would have been shown
+ * as anyway
+ */
+void
+BlobInspector::inspect (
+    amqp::internal::Nested & nested_,
+    const amqp::internal::Budget::Share & share_
+) {
+    if (!share_.depth()) {
+        return;
+    }
+
+    std::optional<amqp::internal::ReaderCache> local;
+
+    auto & cache = m_cache
+        ? *m_cache
+        : local.emplace (m_validation, 32, m_evolution);
+
+    nested_.inspect ([&cache, &share_, this](std::string_view blob_) -> std::optional<std::string> {
+        if (share_.expired()) {
+            return std::nullopt;
+        }
+
+        try {
+            BlobInspector inspector (blob_, cache, share_.limits(), m_rendering);
+            inspector.m_share = &share_;
 
-            std::stringstream ss;
+            auto rtn = inspector.tryDump();
 
-            // We wrap our output like this to make sure it's valid JSON to
-            // facilitate easy pretty printing
-            ss << reader->dump ("{ Parsed", m_data, envelope->schema())->dump()
-               << " }";
+            if (rtn.ok()) {
+                return std::move (rtn.value);
+            }
+        } catch (const std::exception &) {
+            // leave it as bytes
+        }
+
+        return std::nullopt;
+    });
+}
+
+/******************************************************************************/
 
-            return ss.str();
+/**
+ * Check the blob's structure before decoding so the common failures are
+ * reported without an exception. Anything the verifier passes that the
+ * readers still reject is caught here, that should be rare enough not to
+ * matter.
+ */
+amqp::DecodeResult
+BlobInspector::tryDump() noexcept {
+    try {
+        auto rtn = m_section
+            ? amqp::internal::Verifier::verify (m_data, *m_section->verifier, m_limits)
+            : amqp::internal::Verifier::verify (m_data, m_limits);
+
+        if (rtn.ok()) {
+            rtn.value = dump();
         }
+
+        return rtn;
+    } catch (const amqp::LimitExceeded & e) {
+        amqp::DecodeResult rtn;
+        rtn.status = amqp::DecodeStatus::LimitExceeded;
+        rtn.what = e.what();
+
+        return rtn;
+    } catch (const std::exception & e) {
+        amqp::DecodeResult rtn;
+        rtn.status = amqp::DecodeStatus::Failed;
+        rtn.what = e.what();
+
+        return rtn;
+    } catch (...) {
+        amqp::DecodeResult rtn;
+        rtn.status = amqp::DecodeStatus::Failed;
+
+        return rtn;
     }
 }
 
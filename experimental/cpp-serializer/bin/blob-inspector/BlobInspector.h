@@ -1,23 +1,147 @@
 #pragma once
 
 #include <iosfwd>
+#include <string_view>
 #include "CordaBytes.h"
 
+#include "types.h"
+
+#include "amqp/Limits.h"
+#include "amqp/Budget.h"
+#include "amqp/Rendering.h"
+#include "amqp/Validation.h"
+#include "amqp/DecodeResult.h"
+#include "amqp/reader/IReader.h"
+
 /******************************************************************************/
 
 struct pn_data_t;
 
+namespace amqp::internal {
+    class Nested;
+    class Evolution;
+    class ReaderCache;
+    struct SchemaSection;
+    class LazyCompositeFactory;
+}
+
+namespace amqp::internal::schema {
+    class Envelope;
+}
+
 /******************************************************************************/
 
 class BlobInspector {
     private :
         pn_data_t * m_data;
+        std::size_t m_size;
+
+        amqp::Validation m_validation;
+
+        amqp::Limits m_limits;
+
+        /**
+         * Set if ours is a blob nested in another, what we decode is
+         * then charged to it, along with our siblings, rather than to
+         * a budget of our own
+         */
+        const amqp::internal::Budget::Share * m_share;
+
+        amqp::Rendering m_rendering;
+
+        /**
+         * The types to read the blob as, nullptr to read it as written
+         */
+        const amqp::internal::Evolution * m_evolution;
+
+        amqp::internal::ReaderCache * m_cache;
+
+        /**
+         * Set when our schema section is one [m_cache] has seen before,
+         * [m_data] then holds only our value
+         */
+        const amqp::internal::SchemaSection * m_section;
+
+        /**
+         * What a full decode read our types from and, without a cache,
+         * built their readers from. The values dumped from the blob can
+         * point into either, an enum's constant for one, so they're kept
+         * for as long as that tree might be stringified.
+         */
+        uPtr<amqp::internal::schema::Envelope> m_envelope;
+        uPtr<amqp::internal::LazyCompositeFactory> m_factory;
+
+        void decode (std::string_view);
+
+        uPtr<amqp::reader::IValue> dumpEnvelope();
+        uPtr<amqp::reader::IValue> dumpValue();
+
+        /**
+         * Replace the blobs [nested_] found in ours with what they decode
+         * to, sharing our cache or, if we haven't one, one of their own.
+         * Between them they may use no more than [share_], what decoding
+         * ours left.
+         */
+        void inspect (
+            amqp::internal::Nested & nested_,
+            const amqp::internal::Budget::Share & share_);
 
     public :
-        BlobInspector (CordaBytes &);
+        explicit BlobInspector (
+            CordaBytes &,
+            amqp::Validation = amqp::Validation::Strict,
+            const amqp::Limits & = amqp::Limits(),
+            const amqp::Rendering & = amqp::Rendering());
+
+        /**
+         * Read the blob as if written by the version of its CorDapp
+         * [evolution_] expects, which must outlive us
+         */
+        BlobInspector (
+            CordaBytes &,
+            const amqp::internal::Evolution & evolution_,
+            amqp::Validation = amqp::Validation::Strict,
+            const amqp::Limits & = amqp::Limits(),
+            const amqp::Rendering & = amqp::Rendering());
 
+        /**
+         * Take our readers from [cache_], and validate as it does,
+         * rather than building them ourselves. A blob whose schema
+         * section [cache_] has seen before doesn't decode it at all.
+         */
+        BlobInspector (
+            CordaBytes &,
+            amqp::internal::ReaderCache & cache_,
+            const amqp::Limits & = amqp::Limits(),
+            const amqp::Rendering & = amqp::Rendering());
+
+        /**
+         * As above but over a blob we already hold, [blob_] being
+         * everything past its header
+         */
+        BlobInspector (
+            std::string_view blob_,
+            amqp::internal::ReaderCache & cache_,
+            const amqp::Limits & = amqp::Limits(),
+            const amqp::Rendering & = amqp::Rendering());
+
+        ~BlobInspector();
+
+        BlobInspector (const BlobInspector &) = delete;
+
+        /**
+         * Any Corda blobs nested in ours as binary are decoded too, at
+         * once, and shown as what they decode to rather than as bytes
+         */
         std::string dump();
 
+        /**
+         * As [dump] but never throws, a blob we can't decode, or that
+         * would take more than our limits allow, is reported in the
+         * result rather than unwinding the caller
+         */
+        amqp::DecodeResult tryDump() noexcept;
+
 };
 
 /******************************************************************************/
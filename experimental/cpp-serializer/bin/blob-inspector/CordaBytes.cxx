@@ -6,7 +6,7 @@
 
 /******************************************************************************/
 
-CordaBytes::CordaBytes (const std::string & file_)
+CordaBytes::CordaBytes (const std::string & file_, size_t maxSize_)
     : m_blob { nullptr }
 {
     std::ifstream file { file_, std::ios::in | std::ios::binary };
@@ -17,7 +17,17 @@ CordaBytes::CordaBytes (const std::string & file_)
     }
 
     // Disregard the Corda header
-    m_size = results.st_size - (amqp::AMQP_HEADER.size() + 1);
+    auto headerSize = amqp::AMQP_HEADER.size() + 1;
+
+    if (static_cast<size_t>(results.st_size) < headerSize) {
+        throw std::runtime_error ("Not a Corda stream");
+    }
+
+    m_size = results.st_size - headerSize;
+
+    if (m_size > maxSize_) {
+        throw amqp::LimitExceeded ("blob exceeds its byte limit");
+    }
 
     std::array<char, 7> header { };
     file.read (header.data(), 7);
@@ -26,7 +36,11 @@ CordaBytes::CordaBytes (const std::string & file_)
         throw std::runtime_error ("Not a Corda stream");
     }
 
-    file.read (reinterpret_cast<char *>(&m_encoding), 1);
+    // a single byte on the wire, reading it straight into the enum would
+    // leave the rest of it uninitialised
+    char encoding { };
+    file.read (&encoding, 1);
+    m_encoding = static_cast<amqp::amqp_section_id_t> (encoding);
 
     m_blob = new char[m_size];
 
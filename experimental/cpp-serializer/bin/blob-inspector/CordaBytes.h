@@ -2,6 +2,7 @@
 
 #include "string"
 #include <fstream>
+#include "amqp/Limits.h"
 #include "amqp/AMQPSectionId.h"
 
 /******************************************************************************/
@@ -13,7 +14,12 @@ class CordaBytes {
         char * m_blob;
 
     public :
-        explicit CordaBytes (const std::string &);
+        /**
+         * A file bigger than [maxSize_] is refused before we read any of it
+         */
+        explicit CordaBytes (
+            const std::string &,
+            size_t maxSize_ = amqp::Limits().bytes);
 
         ~CordaBytes() {
             delete [] m_blob;
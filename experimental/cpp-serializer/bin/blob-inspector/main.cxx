@@ -2,6 +2,8 @@
 #include <iomanip>
 #include <fstream>
 #include <cstddef>
+#include <cstdlib>
+#include <algorithm>
 
 #include <assert.h>
 #include <string.h>
@@ -18,25 +20,261 @@
 #include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
 
 #include "amqp/schema/described-types/Envelope.h"
+#include "amqp/Evolution.h"
+#include "amqp/ReaderCache.h"
+#include "amqp/Transaction.h"
 #include "amqp/CompositeFactory.h"
 #include "CordaBytes.h"
 #include "BlobInspector.h"
 
 /******************************************************************************/
 
+namespace {
+
+    /**
+     * Given several blobs, decode each and report how it went rather than
+     * stopping at the first one we can't read. Blobs of the same types
+     * share their readers.
+     *
+     * With [plans_] the readers for every schema met in an earlier scan
+     * using the same file are built before we start, and the file is
+     * updated with any new ones when we're done.
+     *
+     * With [evolution_] every blob is read as the types it expects.
+     */
+    int
+    scan (
+        int first_,
+        int argc,
+        char **argv,
+        const char * plans_,
+        const amqp::internal::Evolution * evolution_,
+        const amqp::Rendering & rendering_
+    ) {
+        int failed { 0 };
+
+        amqp::internal::ReaderCache cache (
+            amqp::Validation::Strict, 32, evolution_);
+
+        if (plans_) {
+            cache.preload (amqp::internal::PlanFile (plans_));
+        }
+
+        for (int i { first_ } ; i < argc ; ++i) {
+            struct stat results { };
+
+            if (stat (argv[i], &results) != 0) {
+                std::cout << argv[i] << " : missing" << std::endl;
+                ++failed;
+                continue;
+            }
+
+            amqp::DecodeResult result;
+
+            try {
+                CordaBytes cb (argv[i]);
+
+                if (cb.encoding() != amqp::DATA_AND_STOP) {
+                    std::cout << argv[i] << " : bad encoding" << std::endl;
+                    ++failed;
+                    continue;
+                }
+
+                result = BlobInspector (cb, cache, amqp::Limits(), rendering_).tryDump();
+            } catch (const amqp::LimitExceeded & e) {
+                result.status = amqp::DecodeStatus::LimitExceeded;
+                result.what = e.what();
+            } catch (const std::exception & e) {
+                result.status = amqp::DecodeStatus::Failed;
+                result.what = e.what();
+            }
+
+            if (result.ok()) {
+                std::cout << argv[i] << " : " << result.value << std::endl;
+            } else {
+                std::cout << argv[i] << " : " << amqp::toString (result.status)
+                          << " at node " << result.node;
+
+                if (!result.path.empty()) {
+                    std::cout << " (" << result.path << ")";
+                }
+
+                std::cout << " - " << result.what << std::endl;
+                ++failed;
+            }
+        }
+
+        if (plans_) {
+            try {
+                cache.save (plans_);
+            } catch (const std::exception & e) {
+                std::cerr << e.what() << std::endl;
+            }
+        }
+
+        return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+
+    /**
+     * A file named for a transaction id, ignoring any extension, as an
+     * archive of them is likely to be
+     */
+    std::string
+    namedId (const std::string & path_) {
+        auto name = path_.substr (path_.find_last_of ('/') + 1);
+        name = name.substr (0, name.find ('.'));
+
+        if (name.size() != 64
+            || name.find_first_not_of ("0123456789abcdefABCDEF") != std::string::npos)
+        {
+            return { };
+        }
+
+        std::transform (name.begin(), name.end(), name.begin(), ::toupper);
+
+        return name;
+    }
+
+    /**
+     * Report the id of the transaction in each blob, recomputed from its
+     * component groups, and check it against the one a blob is named
+     * for if it is
+     */
+    int
+    ids (int first_, int argc, char **argv) {
+        int failed { 0 };
+
+        amqp::internal::binding::Binder binder;
+        amqp::internal::ReaderCache cache;
+
+        for (int i { first_ } ; i < argc ; ++i) {
+            try {
+                CordaBytes cb (argv[i]);
+
+                auto id = amqp::internal::sha256::toString (
+                    amqp::internal::transaction::id (
+                        std::string_view (cb.bytes(), cb.size()), binder, cache));
+
+                auto named = namedId (argv[i]);
+
+                std::cout << argv[i] << " : " << id;
+
+                if (!named.empty() && named != id) {
+                    std::cout << " - MISMATCH";
+                    ++failed;
+                }
+
+                std::cout << std::endl;
+            } catch (const std::exception & e) {
+                std::cout << argv[i] << " : failed - " << e.what() << std::endl;
+                ++failed;
+            }
+        }
+
+        return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    /**
+     * The options that are followed by a value
+     */
+    bool
+    valued (const char * arg_) {
+        return strcmp (arg_, "--truncate") == 0
+            || strcmp (arg_, "--plans") == 0
+            || strcmp (arg_, "--expect") == 0;
+    }
+
+    int
+    usage (const char * name_) {
+        std::cerr << "usage: " << name_
+            << " [--txid] [--base64] [--truncate <bytes>] [--plans <file>]"
+               " [--expect <blob>] <blob>..." << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * blob-inspector [--txid] [--base64] [--truncate <bytes>] [--plans <file>]
+ *                [--expect <blob>] <blob>...
+ *
+ * --expect reads every blob as the types the given blob was written with,
+ * as a CorDapp of that version would
+ *
+ * --txid reports the id of the transaction in each blob rather than
+ * dumping it, a blob of a SignedTransaction or of a WireTransaction
+ *
+ * --base64 shows binary as base64 rather than hex, --truncate only the
+ * first so many bytes of any longer binary
+ */
 int
 main (int argc, char **argv) {
+    int first { 1 };
+    const char * plans { nullptr };
+    uPtr<amqp::internal::Evolution> evolution;
+    bool txid { false };
+    amqp::Rendering rendering;
+
+    while (first < argc) {
+        if (strcmp (argv[first], "--txid") == 0) {
+            txid = true;
+            ++first;
+            continue;
+        } else if (strcmp (argv[first], "--base64") == 0) {
+            rendering.binary = amqp::Rendering::Binary::Base64;
+            ++first;
+            continue;
+        } else if (!valued (argv[first])) {
+            break;
+        } else if (first + 1 == argc) {
+            return usage (argv[0]);
+        } else if (strcmp (argv[first], "--truncate") == 0) {
+            rendering.truncate = std::strtoul (argv[first + 1], nullptr, 10);
+        } else if (strcmp (argv[first], "--plans") == 0) {
+            plans = argv[first + 1];
+        } else if (strcmp (argv[first], "--expect") == 0) {
+            try {
+                CordaBytes cb (argv[first + 1]);
+                evolution = amqp::internal::Evolution::fromBlob (
+                    std::string_view (cb.bytes(), cb.size()));
+            } catch (const std::exception & e) {
+                std::cerr << argv[first + 1] << " : " << e.what() << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        first += 2;
+    }
+
+    // options alone leave us nothing to read
+    if (first >= argc) {
+        return usage (argv[0]);
+    }
+
+    if (txid) {
+        return ids (first, argc, argv);
+    }
+
+    if (plans || argc - first > 1) {
+        return scan (first, argc, argv, plans, evolution.get(), rendering);
+    }
+
     struct stat results { };
 
-    if (stat(argv[1], &results) != 0) {
+    if (stat(argv[first], &results) != 0) {
         return EXIT_FAILURE;
     }
 
-    CordaBytes cb (argv[1]);
+    CordaBytes cb (argv[first]);
     
     if (cb.encoding() == amqp::DATA_AND_STOP) {
-        BlobInspector blobInspector (cb);
-        auto val = blobInspector.dump();
+        auto val = evolution
+            ? BlobInspector (cb, *evolution, amqp::Validation::Strict, amqp::Limits(), rendering).dump()
+            : BlobInspector (cb, amqp::Validation::Strict, amqp::Limits(), rendering).dump();
         std::cout << val << std::endl;
     } else {
         std::cerr << "BAD ENCODING " << cb.encoding() << " != "
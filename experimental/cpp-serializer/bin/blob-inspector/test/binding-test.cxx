@@ -0,0 +1,451 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <optional>
+#include <algorithm>
+#include <filesystem>
+
+#include "CordaBytes.h"
+#include "BlobInspector.h"
+
+#include "amqp/Binding.h"
+#include "amqp/ReaderCache.h"
+#include "amqp/Transaction.h"
+
+#include "serialiser/Serialiser.h"
+
+#include "TestUtils.h"
+
+/******************************************************************************/
+
+namespace {
+
+    const std::string filepath ("../../test-files/"); // NOLINT
+
+    struct IS {
+        int32_t a;
+        std::string b;
+    };
+
+    struct I_IS {
+        int32_t a;
+        IS b;
+    };
+
+    /**
+     * Only the fields we want, and one the blob doesn't have
+     */
+    struct Partial {
+        IS b;
+        std::string missing { "untouched" };
+    };
+
+    struct I {
+        int32_t a;
+    };
+
+    struct L_I {
+        std::vector<I> listy;
+    };
+
+    struct AI {
+        std::vector<int32_t> z;
+    };
+
+    struct OI {
+        std::optional<int32_t> a;
+    };
+
+    struct LS {
+        std::vector<std::string> s;
+    };
+
+    /**
+     * Holds both the shapes bound to "_i_is__"
+     */
+    struct Both {
+        I_IS whole;
+        Partial partial;
+    };
+
+    /**
+     * [a] is an int on the wire
+     */
+    struct Wrong {
+        int64_t a;
+    };
+
+}
+
+/******************************************************************************/
+
+AMQP_BINDING (IS, "net.corda.blobwriter._is_",
+    AMQP_MEMBER (IS, a),
+    AMQP_MEMBER (IS, b))
+
+AMQP_BINDING (I_IS, "net.corda.blobwriter._i_is__",
+    AMQP_MEMBER (I_IS, a),
+    AMQP_MEMBER (I_IS, b))
+
+AMQP_BINDING (Partial, "net.corda.blobwriter._i_is__",
+    AMQP_MEMBER (Partial, b),
+    AMQP_MEMBER (Partial, missing))
+
+AMQP_BINDING (I, "net.corda.blobwriter._i_",
+    AMQP_MEMBER (I, a))
+
+AMQP_BINDING (L_I, "net.corda.blobwriter._L_i__",
+    AMQP_MEMBER (L_I, listy))
+
+AMQP_BINDING (AI, "net.corda.blobwriter._Ai_",
+    AMQP_MEMBER (AI, z))
+
+AMQP_BINDING (OI, "net.corda.blobwriter._Oi_",
+    AMQP_MEMBER (OI, a))
+
+AMQP_BINDING (Wrong, "net.corda.blobwriter._i_",
+    AMQP_MEMBER (Wrong, a))
+
+AMQP_BINDING (LS, "net.corda.blobwriter._Ls_",
+    AMQP_MEMBER (LS, s))
+
+AMQP_BINDING (Both, "net.corda.blobwriter.Both",
+    AMQP_MEMBER (Both, whole),
+    AMQP_MEMBER (Both, partial))
+
+/******************************************************************************/
+
+namespace {
+
+    using test::body;
+
+    template<class T>
+    T
+    decode (
+        const std::string & file_,
+        const amqp::internal::binding::Binder & binder_,
+        amqp::internal::ReaderCache & cache_
+    ) {
+        CordaBytes cb (filepath + file_);
+
+        return binder_.decode<T> (std::string_view (cb.bytes(), cb.size()), cache_);
+    }
+
+    /**
+     * What the inspector makes of a blob we've written
+     */
+    std::string
+    inspect (const std::string & blob_) {
+        const auto path = ::testing::TempDir() + "binding-encoded";
+        std::ofstream (path, std::ios::binary | std::ios::trunc) << blob_;
+
+        CordaBytes cb (path);
+        auto rtn = BlobInspector (cb).dump();
+
+        std::remove (path.c_str());
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Nested composites straight into nested structs
+ */
+TEST (Binding, nested) { // NOLINT
+    amqp::internal::binding::Binder binder;
+    amqp::internal::ReaderCache cache;
+
+    for (int i { 0 } ; i < 2 ; ++i) {
+        auto v = decode<I_IS> ("_i_is__", binder, cache);
+
+        EXPECT_EQ (1, v.a);
+        EXPECT_EQ (2, v.b.a);
+        EXPECT_EQ ("three", v.b.b);
+    }
+
+    // one plan for each struct, however many times they're read
+    EXPECT_EQ (2U, binder.size());
+}
+
+/******************************************************************************/
+
+/**
+ * Each thread remembers the plans it's run, but never takes one binder's
+ * for another's, even one built where the last one was, and a binder's
+ * plans are built once however many threads run them
+ */
+TEST (Binding, recentPlans) { // NOLINT
+    amqp::internal::ReaderCache cache;
+
+    for (int i { 0 } ; i < 3 ; ++i) {
+        amqp::internal::binding::Binder binder;
+
+        EXPECT_EQ ("three", decode<I_IS> ("_i_is__", binder, cache).b.b);
+        EXPECT_EQ (2U, binder.size());
+    }
+
+    amqp::internal::binding::Binder binder;
+    std::atomic<int> wrong { 0 };
+
+    std::vector<std::thread> threads;
+    for (int t { 0 } ; t < 4 ; ++t) {
+        threads.emplace_back ([&]() {
+            for (int i { 0 } ; i < 50 ; ++i) {
+                auto v = decode<I_IS> ("_i_is__", binder, cache);
+
+                if (v.a != 1 || v.b.a != 2 || v.b.b != "three") {
+                    ++wrong;
+                }
+            }
+        });
+    }
+
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ (0, wrong);
+    EXPECT_EQ (2U, binder.size());
+}
+
+/******************************************************************************/
+
+/**
+ * Fields we don't bind are stepped over, members the blob doesn't have
+ * are left alone
+ */
+TEST (Binding, partial) { // NOLINT
+    amqp::internal::binding::Binder binder;
+    amqp::internal::ReaderCache cache;
+
+    auto v = decode<Partial> ("_i_is__", binder, cache);
+
+    EXPECT_EQ (2, v.b.a);
+    EXPECT_EQ ("three", v.b.b);
+    EXPECT_EQ ("untouched", v.missing);
+}
+
+/******************************************************************************/
+
+TEST (Binding, containers) { // NOLINT
+    amqp::internal::binding::Binder binder;
+    amqp::internal::ReaderCache cache;
+
+    auto l = decode<L_I> ("_L_i__", binder, cache);
+
+    ASSERT_EQ (3U, l.listy.size());
+    EXPECT_EQ (1, l.listy[0].a);
+    EXPECT_EQ (3, l.listy[2].a);
+
+    auto a = decode<AI> ("_Ai_", binder, cache);
+
+    EXPECT_EQ ((std::vector<int32_t> { 1, 2, 3, 4, 5, 6 }), a.z);
+
+    auto o = decode<OI> ("_Oi_", binder, cache);
+
+    ASSERT_TRUE (o.a);
+    EXPECT_EQ (1, *o.a);
+}
+
+/******************************************************************************/
+
+/**
+ * A member that can't hold what's on the wire
+ */
+TEST (Binding, mismatch) { // NOLINT
+    amqp::internal::binding::Binder binder;
+    amqp::internal::ReaderCache cache;
+
+    EXPECT_THROW (decode<Wrong> ("_i_", binder, cache), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * What we write reads back, both through the schema it carries and into
+ * the struct it came from
+ */
+TEST (Binding, encode) { // NOLINT
+    serialiser::Serialiser serialiser;
+    amqp::internal::binding::Binder binder;
+    amqp::internal::ReaderCache cache;
+
+    auto blob = serialiser.serialise (I_IS { 1, IS { 2, "three" } });
+
+    EXPECT_EQ (
+        R"({ Parsed : { a : 1, b : { a : 2, b : "three" } } })",
+        inspect (blob));
+
+    auto v = binder.decode<I_IS> (body (blob), cache);
+
+    EXPECT_EQ (1, v.a);
+    EXPECT_EQ (2, v.b.a);
+    EXPECT_EQ ("three", v.b.b);
+}
+
+/******************************************************************************/
+
+TEST (Binding, encodeContainers) { // NOLINT
+    serialiser::Serialiser serialiser;
+    amqp::internal::binding::Binder binder;
+    amqp::internal::ReaderCache cache;
+
+    auto l = serialiser.serialise (L_I { { I { 1 }, I { 2 }, I { 3 } } });
+
+    EXPECT_EQ (
+        "{ Parsed : { listy : [ { a : 1 }, { a : 2 }, { a : 3 } ] } }",
+        inspect (l));
+    EXPECT_EQ (3U, binder.decode<L_I> (body (l), cache).listy.size());
+
+    auto a = serialiser.serialise (AI { { 1, 2, 3 } });
+
+    EXPECT_EQ ("{ Parsed : { z : [ 1, 2, 3 ] } }", inspect (a));
+    EXPECT_EQ (
+        (std::vector<int32_t> { 1, 2, 3 }),
+        binder.decode<AI> (body (a), cache).z);
+
+    OI present { 1 };
+    EXPECT_EQ ("{ Parsed : { a : 1 } }", inspect (serialiser.serialise (present)));
+
+    OI absent { 5 };
+    absent = binder.decode<OI> (body (serialiser.serialise (OI { })), cache);
+    EXPECT_FALSE (absent.a);
+
+    auto s = serialiser.serialise (LS { { "a", "b" } });
+
+    EXPECT_EQ (R"({ Parsed : { s : [ "a", "b" ] } })", inspect (s));
+    EXPECT_EQ (
+        (std::vector<std::string> { "a", "b" }),
+        binder.decode<LS> (body (s), cache).s);
+}
+
+/******************************************************************************/
+
+/**
+ * Lists are named as Java would name them, with boxed type parameters
+ */
+TEST (Binding, javaType) { // NOLINT
+    using amqp::internal::binding::javaType;
+
+    EXPECT_EQ ("int", javaType<int32_t>());
+    EXPECT_EQ ("java.util.List<java.lang.Integer>", javaType<std::vector<int32_t>>());
+    EXPECT_EQ ("java.util.List<java.lang.String>", javaType<std::vector<std::string>>());
+    EXPECT_EQ ("java.util.List<java.lang.Long>", javaType<std::vector<std::optional<int64_t>>>());
+    EXPECT_EQ ("java.util.List<ulong>", javaType<std::vector<uint64_t>>());
+    EXPECT_EQ (
+        "java.util.List<java.util.List<net.corda.blobwriter._i_>>",
+        javaType<std::vector<std::vector<I>>>());
+}
+
+/******************************************************************************/
+
+/**
+ * Two structs bound to the one class can each be read into, but a blob
+ * can't describe both of them
+ */
+TEST (Binding, encodeMismatched) { // NOLINT
+    serialiser::Serialiser serialiser;
+
+    EXPECT_THROW (serialiser.serialise (Both { }), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * A decode is held to its limits as the inspector is, however many
+ * elements or levels of nesting the blob has
+ */
+TEST (Binding, limits) { // NOLINT
+    serialiser::Serialiser serialiser;
+    amqp::internal::binding::Binder binder;
+    amqp::internal::ReaderCache cache;
+
+    auto l = serialiser.serialise (L_I { std::vector<I> (1000, I { 1 }) });
+    auto v = serialiser.serialise (I_IS { 1, IS { 2, "three" } });
+
+    amqp::Limits nodes;
+    nodes.nodes = 100;
+
+    EXPECT_THROW (binder.decode<L_I> (body (l), cache, nodes), amqp::LimitExceeded); // NOLINT
+
+    amqp::Limits depth;
+    depth.depth = 1;
+
+    EXPECT_THROW (binder.decode<I_IS> (body (v), cache, depth), amqp::LimitExceeded); // NOLINT
+
+    amqp::Limits bytes;
+    bytes.bytes = body (v).size() - 1;
+
+    EXPECT_THROW (binder.decode<I_IS> (body (v), cache, bytes), amqp::LimitExceeded); // NOLINT
+
+    EXPECT_EQ (1000U, binder.decode<L_I> (body (l), cache).listy.size());
+    EXPECT_EQ ("three", binder.decode<I_IS> (body (v), cache).b.b);
+}
+
+/******************************************************************************/
+
+/**
+ * Every blob of a type ends with the same sections, encoded once
+ */
+TEST (Binding, sectionsCached) { // NOLINT
+    serialiser::Serialiser serialiser;
+
+    const auto & sections = amqp::internal::binding::sections<IS>();
+
+    for (int i { 0 } ; i < 3 ; ++i) {
+        auto blob = serialiser.serialise (IS { i, std::string (i, 'x') });
+
+        ASSERT_GT (blob.size(), sections.size());
+        EXPECT_EQ (sections, blob.substr (blob.size() - sections.size()));
+        EXPECT_EQ (&sections, &amqp::internal::binding::sections<IS>());
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Transactions Corda itself wrote, each named for the id Corda gave it
+ * and written as a WireTransaction, ".wtx", and a SignedTransaction,
+ * ".stx". None are checked in yet, the blobwriter writes them alongside
+ * the other test files, so until then there's nothing to check.
+ */
+TEST (Binding, cordaTransactions) { // NOLINT
+    amqp::internal::binding::Binder binder;
+    amqp::internal::ReaderCache cache;
+
+    int checked { 0 };
+
+    for (const auto & entry : std::filesystem::directory_iterator (filepath)) {
+        const auto & path = entry.path();
+
+        if (path.extension() != ".wtx" && path.extension() != ".stx") {
+            continue;
+        }
+
+        auto named = path.stem().string();
+        std::transform (named.begin(), named.end(), named.begin(), ::toupper);
+
+        CordaBytes cb (path.string());
+
+        EXPECT_EQ (
+            named,
+            amqp::internal::sha256::toString (amqp::internal::transaction::id (
+                std::string_view (cb.bytes(), cb.size()), binder, cache))) << path;
+
+        ++checked;
+    }
+
+    if (!checked) {
+        GTEST_SKIP() << "No Corda written transactions in " << filepath;
+    }
+}
+
+/******************************************************************************/
@@ -1,7 +1,29 @@
 #include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
 #include "CordaBytes.h"
 #include "BlobInspector.h"
 
+#include "amqp/Nested.h"
+#include "amqp/AMQPHeader.h"
+#include "amqp/Encoding.h"
+#include "amqp/Evolution.h"
+#include "amqp/RawEnvelope.h"
+#include "amqp/ReaderCache.h"
+#include "amqp/schema/described-types/Envelope.h"
+#include "amqp/schema/described-types/FlatSchema.h"
+#include "amqp/schema/described-types/IndexedSchema.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+#include "amqp/schema/descriptors/corda-descriptors/EnvelopeDescriptor.h"
+
+#include "proton/codec.h"
+#include "proton/proton_wrapper.h"
+
+#include "TestUtils.h"
+
 const std::string filepath ("../../test-files/"); // NOLINT
 
 /******************************************************************************
@@ -11,7 +33,7 @@ const std::string filepath ("../../test-files/"); // NOLINT
  ******************************************************************************/
 
 void
-test (const std::string & file_, const std::string & result_) {
+inspect (const std::string & file_, const std::string & result_) {
     auto path { filepath + file_ } ;
     CordaBytes cb (path);
     auto val = BlobInspector (cb).dump();
@@ -24,7 +46,7 @@ test (const std::string & file_, const std::string & result_) {
  * int
  */
 TEST (BlobInspector, _i_) { // NOLINT
-    test ("_i_", "{ Parsed : { a : 69 } }");
+    inspect ("_i_", "{ Parsed : { a : 69 } }");
 }
 
 /******************************************************************************/
@@ -33,7 +55,7 @@ TEST (BlobInspector, _i_) { // NOLINT
  * long
  */
 TEST (BlobInspector, _l_) { // NOLINT
-    test ("_l_", "{ Parsed : { x : 100000000000 } }");
+    inspect ("_l_", "{ Parsed : { x : 100000000000 } }");
 }
 
 /******************************************************************************/
@@ -42,7 +64,7 @@ TEST (BlobInspector, _l_) { // NOLINT
  * int
  */
 TEST (BlobInspector, _Oi_) { // NOLINT
-    test ("_Oi_", "{ Parsed : { a : 1 } }");
+    inspect ("_Oi_", "{ Parsed : { a : 1 } }");
 }
 
 /******************************************************************************/
@@ -51,7 +73,7 @@ TEST (BlobInspector, _Oi_) { // NOLINT
  * int
  */
 TEST (BlobInspector, _Ai_) { // NOLINT
-    test ("_Ai_", "{ Parsed : { z : [ 1, 2, 3, 4, 5, 6 ] } }");
+    inspect ("_Ai_", "{ Parsed : { z : [ 1, 2, 3, 4, 5, 6 ] } }");
 }
 
 /******************************************************************************/
@@ -60,7 +82,7 @@ TEST (BlobInspector, _Ai_) { // NOLINT
  * List of ints
  */
 TEST (BlobInspector, _Li_) { // NOLINT
-    test ("_Li_", "{ Parsed : { a : [ 1, 2, 3, 4, 5, 6 ] } }");
+    inspect ("_Li_", "{ Parsed : { a : [ 1, 2, 3, 4, 5, 6 ] } }");
 }
 
 /******************************************************************************/
@@ -69,7 +91,7 @@ TEST (BlobInspector, _Li_) { // NOLINT
  * List of a class with a single int property
  */
 TEST (BlobInspector, _L_i__) { // NOLINT
-    test (
+    inspect (
         "_L_i__",
         "{ Parsed : { listy : [ { a : 1 }, { a : 2 }, { a : 3 } ] } }");
 }
@@ -77,7 +99,7 @@ TEST (BlobInspector, _L_i__) { // NOLINT
 /******************************************************************************/
 
 TEST (BlobInspector, _Le_) { // NOLINT
-    test ("_Le_", "{ Parsed : { listy : [ A, B, C ] } }");
+    inspect ("_Le_", "{ Parsed : { listy : [ A, B, C ] } }");
 }
 
 /******************************************************************************/
@@ -85,7 +107,7 @@ TEST (BlobInspector, _Le_) { // NOLINT
 TEST (BlobInspector,_Le_2) { // NOLINT
     EXPECT_THROW (
         {
-            test ("_Le_2", "");
+            inspect ("_Le_2", "");
         },
         std::runtime_error);
 }
@@ -96,7 +118,7 @@ TEST (BlobInspector,_Le_2) { // NOLINT
  * A map of ints to strings
  */
 TEST (BlobInspector, _Mis_) { // NOLINT
-    test ("_Mis_",
+    inspect ("_Mis_",
         R"({ Parsed : { a : { 1 : "two", 3 : "four", 5 : "six" } } })");
 }
 
@@ -106,7 +128,7 @@ TEST (BlobInspector, _Mis_) { // NOLINT
  * A map of ints to lists of Strings
  */
 TEST (BlobInspector, _MiLs_) { // NOLINT
-    test ("_MiLs_",
+    inspect ("_MiLs_",
         R"({ Parsed : { a : { 1 : [ "two", "three", "four" ], 5 : [ "six" ], 7 : [  ] } } })");
 }
 
@@ -116,27 +138,27 @@ TEST (BlobInspector, _MiLs_) { // NOLINT
  * a map of ints to a composite with a n int and string property
  */
 TEST (BlobInspector, _Mi_is__) { // NOLINT
-    test ("_Mi_is__",
+    inspect ("_Mi_is__",
         R"({ Parsed : { a : { 1 : { a : 2, b : "three" }, 4 : { a : 5, b : "six" }, 7 : { a : 8, b : "nine" } } } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector,_Pls_) { // NOLINT
-    test ("_Pls_",
+    inspect ("_Pls_",
             R"({ Parsed : { a : { first : 1, second : "two" } } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector, _e_) { // NOLINT
-    test ("_e_", "{ Parsed : { e : A } }");
+    inspect ("_e_", "{ Parsed : { e : A } }");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector, _i_is__) { // NOLINT
-    test ("_i_is__",
+    inspect ("_i_is__",
             R"({ Parsed : { a : 1, b : { a : 2, b : "three" } } })");
 }
 
@@ -144,7 +166,7 @@ TEST (BlobInspector, _i_is__) { // NOLINT
 
 // Array of unboxed integers
 TEST (BlobInspector, _Ci_) { // NOLINT
-    test ("_Ci_",
+    inspect ("_Ci_",
         R"({ Parsed : { z : [ 1, 2, 3 ] } })");
 }
 
@@ -157,15 +179,716 @@ TEST (BlobInspector, _Ci_) { // NOLINT
  *   * one list property that is a list of Maps of int to strings
  */
 TEST (BlobInspector, __i_LMis_l__) { // NOLINT
-    test ("__i_LMis_l__",
+    inspect ("__i_LMis_l__",
         R"({ Parsed : { x : [ { 1 : "two", 3 : "four", 5 : "six" }, { 7 : "eight", 9 : "ten" } ], y : { x : 1000000 }, z : { a : 666 } } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector, _ALd_) { // NOLINT
-    test ("_ALd_",
+    inspect ("_ALd_",
             R"({ Parsed : { a : [ [ 10.100000, 11.200000, 12.300000 ], [  ], [ 13.400000 ] ] } })");
 }
 
 /******************************************************************************/
+
+/**
+ * Properties declared as interfaces, "*" in the schema, holding
+ *   * a described type
+ *   * a boxed int
+ *   * null
+ *   * the described type again, this time from the polymorphic cache
+ */
+TEST (BlobInspector, _poly_) { // NOLINT
+    inspect ("_poly_",
+        R"({ Parsed : { a : { x : 5 }, b : 7, c : null, d : { x : 6 } } })");
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Non throwing decode
+ *
+ ******************************************************************************/
+
+TEST (BlobInspector, tryDump) { // NOLINT
+    CordaBytes cb (filepath + "_i_is__");
+    auto result = BlobInspector (cb).tryDump();
+
+    ASSERT_TRUE (result.ok());
+    EXPECT_EQ ("{ Parsed : { a : 1, b : { a : 2, b : \"three\" } } }", result.value);
+}
+
+/******************************************************************************/
+
+/**
+ * The last element of the list is a back reference to the first which
+ * we can't decode, we should be told where it is rather than have to
+ * catch anything
+ */
+TEST (BlobInspector, tryDumpUnsupported) { // NOLINT
+    CordaBytes cb (filepath + "_Le_2");
+    auto result = BlobInspector (cb).tryDump();
+
+    EXPECT_EQ (amqp::DecodeStatus::Unsupported, result.status);
+    EXPECT_EQ ("value.listy[3]", result.path);
+    EXPECT_TRUE (result.value.empty());
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Trusted decoding
+ *
+ ******************************************************************************/
+
+/**
+ * Skipping the checks on a well formed blob mustn't change what we read
+ */
+TEST (BlobInspector, trusted) { // NOLINT
+    for (const auto & file : { "_i_is__", "_Mi_is__", "_Le_", "_ALd_", "__i_LMis_l__" }) {
+        CordaBytes cb (filepath + file);
+
+        EXPECT_EQ (
+            BlobInspector (cb).dump(),
+            BlobInspector (cb, amqp::Validation::Trusted).dump());
+    }
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Resource limits
+ *
+ ******************************************************************************/
+
+TEST (BlobInspector, depthLimit) { // NOLINT
+    amqp::Limits limits;
+    limits.depth = 2;
+
+    CordaBytes cb (filepath + "__i_LMis_l__");
+
+    EXPECT_EQ (
+        amqp::DecodeStatus::LimitExceeded,
+        BlobInspector (cb, amqp::Validation::Strict, limits).tryDump().status);
+
+    // the verifier can be passed, the readers still have to stop
+    EXPECT_THROW (
+        BlobInspector (cb, amqp::Validation::Trusted, limits).dump(),
+        amqp::LimitExceeded);
+}
+
+/******************************************************************************/
+
+TEST (BlobInspector, nodeLimit) { // NOLINT
+    amqp::Limits limits;
+    limits.nodes = 10;
+
+    CordaBytes cb (filepath + "_Mi_is__");
+    auto result = BlobInspector (cb, amqp::Validation::Strict, limits).tryDump();
+
+    EXPECT_EQ (amqp::DecodeStatus::LimitExceeded, result.status);
+    EXPECT_TRUE (result.value.empty());
+}
+
+/******************************************************************************/
+
+TEST (BlobInspector, byteLimit) { // NOLINT
+    EXPECT_THROW (CordaBytes (filepath + "_i_", 16), amqp::LimitExceeded);
+
+    CordaBytes cb (filepath + "_i_");
+
+    amqp::Limits limits;
+    limits.bytes = cb.size() + 1;
+
+    // the blob itself fits but rendering it doesn't
+    EXPECT_THROW (
+        BlobInspector (cb, amqp::Validation::Strict, limits).dump(),
+        amqp::LimitExceeded);
+
+    limits.bytes = cb.size() - 1;
+
+    EXPECT_THROW (
+        BlobInspector (cb, amqp::Validation::Strict, limits),
+        amqp::LimitExceeded);
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Reader caching
+ *
+ ******************************************************************************/
+
+/**
+ * Readers taken from the cache must read exactly what freshly built ones
+ * do, and a schema seen before mustn't be built again
+ */
+TEST (BlobInspector, cached) { // NOLINT
+    amqp::internal::ReaderCache cache;
+
+    for (int i { 0 } ; i < 2 ; ++i) {
+        for (const auto & file : { "_i_is__", "_Mi_is__", "_Le_", "_poly_", "__i_LMis_l__" }) {
+            CordaBytes cb (filepath + file);
+
+            EXPECT_EQ (BlobInspector (cb).dump(), BlobInspector (cb, cache).dump());
+        }
+    }
+
+    EXPECT_EQ (5U, cache.size());
+}
+
+/******************************************************************************/
+
+/**
+ * A schema section seen before byte for byte isn't decoded again, the
+ * value alone is, and reads and verifies just as the whole blob would
+ */
+TEST (BlobInspector, schemaSections) { // NOLINT
+    amqp::internal::ReaderCache cache;
+
+    for (int i { 0 } ; i < 2 ; ++i) {
+        for (const auto & file : { "_i_is__", "_Mi_is__", "_Le_", "_poly_", "__i_LMis_l__" }) {
+            CordaBytes cb (filepath + file);
+            std::string_view blob (cb.bytes(), cb.size());
+
+            auto raw = amqp::internal::RawEnvelope::locate (blob);
+            ASSERT_TRUE (raw);
+            EXPECT_LT (raw->value.size() + raw->schema.size(), blob.size());
+
+            // anything after the envelope is for the full decode to reject
+            EXPECT_FALSE (amqp::internal::RawEnvelope::locate (std::string (blob) + '\0'));
+            EXPECT_FALSE (amqp::internal::RawEnvelope::locate (blob.substr (0, blob.size() - 1)));
+
+            auto expected = BlobInspector (cb).dump();
+
+            EXPECT_EQ (expected, BlobInspector (cb, cache).dump());
+
+            auto rtn = BlobInspector (cb, cache).tryDump();
+            EXPECT_TRUE (rtn.ok()) << rtn.what;
+            EXPECT_EQ (expected, rtn.value);
+        }
+    }
+
+    EXPECT_EQ (5U, cache.sections());
+    EXPECT_EQ (5U, cache.size());
+}
+
+/******************************************************************************/
+
+/**
+ * Descriptors described by descriptors, far deeper than we could recurse,
+ * are stepped over without recursing and the envelope rejected
+ */
+TEST (BlobInspector, deeplyDescribed) { // NOLINT
+    CordaBytes cb (filepath + "_i_is__");
+
+    const std::size_t depth { 100000 };
+
+    // the envelope's descriptor, then a list of three values the first
+    // of which never ends
+    std::string blob (cb.bytes(), 10);
+    blob += '\xd0';
+    for (auto size : { static_cast<uint32_t>(depth + 4), 3U }) {
+        for (int shift { 24 } ; shift >= 0 ; shift -= 8) {
+            blob += static_cast<char>((size >> shift) & 0xffU);
+        }
+    }
+    blob.append (depth, '\0');
+
+    EXPECT_FALSE (amqp::internal::RawEnvelope::locate (blob));
+}
+
+/******************************************************************************/
+
+/**
+ * A schema section we haven't seen is checked against the limits of the
+ * blob it came in
+ */
+TEST (BlobInspector, sectionLimits) { // NOLINT
+    CordaBytes cb (filepath + "__i_LMis_l__");
+
+    auto raw = amqp::internal::RawEnvelope::locate (
+        std::string_view (cb.bytes(), cb.size()));
+    ASSERT_TRUE (raw);
+
+    amqp::Limits limits;
+    limits.nodes = 4;
+
+    amqp::internal::ReaderCache cache;
+
+    EXPECT_THROW (
+        cache.section (raw->schema, raw->transforms, limits),
+        amqp::LimitExceeded);
+    EXPECT_EQ (0U, cache.sections());
+
+    cache.section (raw->schema, raw->transforms);
+    EXPECT_EQ (1U, cache.sections());
+
+    // however far through the section we run out, it's never cached
+    // with only the types read until then
+    for (limits.nodes = 1 ; limits.nodes < 200 ; ++limits.nodes) {
+        amqp::internal::ReaderCache limited;
+
+        try {
+            limited.section (raw->schema, raw->transforms, limits);
+        } catch (const amqp::LimitExceeded &) {
+            EXPECT_EQ (0U, limited.sections());
+            continue;
+        }
+
+        auto rtn = BlobInspector (cb, limited).tryDump();
+        EXPECT_TRUE (rtn.ok()) << limits.nodes << " " << rtn.what;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Indexing a schema builds none of its types, each is built when first
+ * asked for and then as it would have been had we built them all
+ */
+TEST (BlobInspector, indexedSchema) { // NOLINT
+    CordaBytes cb (filepath + "__i_LMis_l__");
+
+    auto data = pn_data (cb.size());
+    pn_data_decode (data, cb.bytes(), cb.size());
+
+    {
+        proton::auto_enter ae (data);
+
+        auto envelope = dynamic_cast<const amqp::internal::schema::descriptors::EnvelopeDescriptor &> (
+                amqp::internal::registeredDescriptor (pn_data_get_ulong (data))).index (data);
+
+        const auto & schema = dynamic_cast<const amqp::internal::schema::IndexedSchema &> (
+                envelope->schema());
+
+        EXPECT_EQ (0U, schema.built());
+
+        auto full = schema.materialise();
+        ASSERT_EQ (full->types().size(), schema.descriptors().size());
+
+        auto point = pn_data_point (data);
+
+        for (const auto & type : *full) {
+            auto indexed = schema.findDescriptor (type.descriptor());
+
+            ASSERT_NE (nullptr, indexed);
+            EXPECT_EQ (type.name(), indexed->name());
+            EXPECT_EQ (indexed, schema.findType (type.name()));
+        }
+
+        // building put the cursor back where it found it
+        EXPECT_EQ (point, pn_data_point (data));
+
+        EXPECT_EQ (full->types().size(), schema.built());
+        EXPECT_EQ (nullptr, schema.findType ("no.such.Type"));
+    }
+
+    pn_data_free (data);
+}
+
+/******************************************************************************/
+
+/**
+ * Real schemas come back out of being flattened exactly as they went in
+ */
+TEST (BlobInspector, flatSchema) { // NOLINT
+    for (const auto & file : { "_i_is__", "_Le_", "_ALd_", "_Ai_", "_poly_", "__i_LMis_l__" }) {
+        CordaBytes cb (filepath + file);
+
+        auto data = pn_data (cb.size());
+        pn_data_decode (data, cb.bytes(), cb.size());
+
+        {
+            proton::auto_enter ae (data);
+
+            auto envelope = dynamic_cast<const amqp::internal::schema::descriptors::EnvelopeDescriptor &> (
+                    amqp::internal::registeredDescriptor (pn_data_get_ulong (data))).index (data);
+
+            auto full = dynamic_cast<const amqp::internal::schema::IndexedSchema &> (
+                    envelope->schema()).materialise();
+
+            amqp::internal::schema::FlatSchema flat (*full);
+
+            EXPECT_EQ (full->types().size(), flat.size()) << file;
+            EXPECT_EQ (
+                amqp::internal::PlanFile::encode (*full),
+                amqp::internal::PlanFile::encode (*flat.materialise())) << file;
+        }
+
+        pn_data_free (data);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Plans saved by one cache give another the same readers without either
+ * the schemas or the blobs they came from
+ */
+TEST (BlobInspector, plans) { // NOLINT
+    const auto files = {
+        "_i_is__", "_Mi_is__", "_Le_", "_ALd_", "_Ai_", "_poly_", "__i_LMis_l__"
+    };
+
+    const auto path = ::testing::TempDir() + "blob-inspector-plans";
+
+    {
+        amqp::internal::ReaderCache cache;
+
+        for (const auto & file : files) {
+            CordaBytes cb (filepath + file);
+            BlobInspector (cb, cache).dump();
+        }
+
+        cache.save (path);
+    }
+
+    amqp::internal::PlanFile plans (path);
+    EXPECT_EQ (files.size(), plans.size());
+
+    amqp::internal::ReaderCache cache;
+    EXPECT_EQ (files.size(), cache.preload (plans));
+    EXPECT_EQ (0U, cache.preload (plans));
+
+    for (const auto & file : files) {
+        CordaBytes cb (filepath + file);
+        EXPECT_EQ (BlobInspector (cb).dump(), BlobInspector (cb, cache).dump());
+    }
+
+    // nothing new was needed
+    EXPECT_EQ (files.size(), cache.size());
+
+    std::remove (path.c_str());
+}
+
+/******************************************************************************/
+
+/**
+ * A file from another version of the format, or that's been damaged, is
+ * just ignored
+ */
+TEST (BlobInspector, stalePlans) { // NOLINT
+    const auto path = ::testing::TempDir() + "blob-inspector-stale-plans";
+
+    {
+        amqp::internal::ReaderCache cache;
+        CordaBytes cb (filepath + "_Le_");
+        BlobInspector (cb, cache).dump();
+        cache.save (path);
+    }
+
+    std::string bytes;
+    {
+        std::ifstream in (path, std::ios::binary);
+        bytes.assign (std::istreambuf_iterator<char> (in), { });
+    }
+
+    auto rewrite = [&path](const std::string & bytes_) {
+        std::ofstream (path, std::ios::binary | std::ios::trunc) << bytes_;
+    };
+
+    ASSERT_EQ (1U, amqp::internal::PlanFile (path).size());
+
+    // the format version follows the magic
+    auto version = bytes;
+    ++version[8];
+    rewrite (version);
+    EXPECT_EQ (0U, amqp::internal::PlanFile (path).size());
+
+    rewrite (bytes.substr (0, bytes.size() - 1));
+    EXPECT_EQ (0U, amqp::internal::PlanFile (path).size());
+
+    // the plans are hashed, damage that would still decode is caught
+    auto plan = bytes;
+    plan.back() ^= 0x7f;
+    rewrite (plan);
+    EXPECT_EQ (0U, amqp::internal::PlanFile (path).size());
+
+    EXPECT_EQ (0U, amqp::internal::PlanFile ("no-such-plans").size());
+
+    std::remove (path.c_str());
+}
+
+/******************************************************************************/
+
+/**
+ * Blobs read as a later version of their CorDapp would, _i_ has since
+ * gained a field ahead of [a] and constant A of _e_'s enum been renamed
+ */
+TEST (BlobInspector, evolution) { // NOLINT
+    using namespace amqp::internal::schema;
+
+    std::vector<uPtr<Field>> fields;
+    fields.emplace_back (test::field ("b", "int"));
+    fields.emplace_back (test::field ("a", "int", true));
+
+    std::vector<TypeNotation> types;
+    types.emplace_back (TypeNotation (test::composite (
+        "net.corda.blobwriter._i_", std::move (fields), "_i_-2")));
+    types.emplace_back (test::restricted (
+        "net.corda.blobwriter.E", "list", { "ALPHA", "B" }, "E-2"));
+
+    std::map<std::string, Transforms::Type, std::less<>> transforms;
+    transforms["net.corda.blobwriter.E"].emplace_back (
+        "Rename", std::vector<std::string> { "A", "ALPHA" });
+
+    amqp::internal::Evolution evolution (
+        std::make_unique<const Schema> (std::move (types)),
+        std::make_unique<const Transforms> (std::move (transforms)));
+
+    amqp::internal::ReaderCache cache (
+        amqp::Validation::Strict, 32, &evolution);
+
+    for (const auto & [ file, expected ] : {
+        std::make_pair ("_i_", "{ Parsed : { b : null, a : 69 } }"),
+        std::make_pair ("_e_", "{ Parsed : { e : ALPHA } }") })
+    {
+        CordaBytes cb (filepath + file);
+
+        EXPECT_EQ (expected, BlobInspector (cb, evolution).dump()) << file;
+
+        for (int i { 0 } ; i < 2 ; ++i) {
+            EXPECT_EQ (expected, BlobInspector (cb, cache).dump()) << file;
+        }
+    }
+
+    EXPECT_EQ (2U, evolution.size());
+
+    // the blobs carry no transforms of their own
+    CordaBytes cb (filepath + "_e_");
+    auto raw = amqp::internal::RawEnvelope::locate (
+        std::string_view (cb.bytes(), cb.size()));
+
+    ASSERT_TRUE (raw);
+    EXPECT_TRUE (amqp::internal::schema::descriptors::decodeDescribed<Transforms> (
+        raw->transforms)->empty());
+}
+
+/******************************************************************************/
+
+namespace {
+
+    using test::body;
+
+    /**
+     * A blob of a single composite whose fields, a, b and so on, are
+     * each one of [binaries_]
+     */
+    std::string
+    carrier (const std::vector<std::string> & binaries_) {
+        using namespace amqp::internal::encoding;
+
+        std::vector<std::pair<std::string, FieldSpec>> fields;
+        for (std::size_t i { 0 } ; i < binaries_.size() ; ++i) {
+            fields.emplace_back (
+                std::string (1, static_cast<char>('a' + i)),
+                FieldSpec { "binary", "", "", true, "" });
+        }
+
+        auto descriptor = fingerprint ("carrier" + std::to_string (binaries_.size()));
+
+        SchemaWriter schema;
+        schema.composite ("net.corda.Carrier", descriptor, std::move (fields));
+
+        test::BlobBuilder builder;
+        builder.described (descriptor);
+        for (const auto & binary : binaries_) {
+            pn_data_put_binary (builder.data(), pn_bytes (binary.size(), binary.data()));
+        }
+        builder.exit();
+
+        return builder.blob (schema);
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Blobs carried as binary by other blobs are shown as what they decode
+ * to, however deep, binary that isn't a blob, or is but is damaged, is
+ * still shown as bytes
+ */
+TEST (BlobInspector, nested) { // NOLINT
+    auto inner = carrier ({ std::string ("\x01\x02", 2) });
+    auto damaged = inner.substr (0, amqp::AMQP_HEADER.size() + 2);
+
+    auto outer = carrier ({ inner, "\xab", inner, damaged });
+    auto outermost = carrier ({ outer });
+
+    const std::string innerJSON = R"({ Parsed : { a : "0102" } })";
+    const std::string outerJSON = "{ Parsed : { a : " + innerJSON
+        + R"(, b : "AB", c : )" + innerJSON
+        + R"(, d : "636F72646101000000")"
+        + " } }";
+
+    EXPECT_TRUE (amqp::internal::Nested::isBlob (inner));
+    EXPECT_FALSE (amqp::internal::Nested::isBlob ("\xab"));
+
+    amqp::internal::ReaderCache cache;
+
+    EXPECT_EQ (innerJSON, BlobInspector (body (inner), cache).dump());
+    EXPECT_EQ (outerJSON, BlobInspector (body (outer), cache).dump());
+    EXPECT_EQ (
+        "{ Parsed : { a : " + outerJSON + " } }",
+        BlobInspector (body (outermost), cache).dump());
+
+    // and without a cache to share, the nested blobs share one of their own
+    const auto path = ::testing::TempDir() + "blob-inspector-nested";
+    std::ofstream (path, std::ios::binary | std::ios::trunc) << outer;
+
+    CordaBytes cb (path);
+    EXPECT_EQ (outerJSON, BlobInspector (cb).dump());
+
+    std::remove (path.c_str());
+}
+
+/******************************************************************************/
+
+/**
+ * Each blob nested in another costs a level of the outermost's depth, so
+ * a chain of them deeper than that leaves the innermost as bytes rather
+ * than decoding without end
+ */
+TEST (BlobInspector, nestedDepth) { // NOLINT
+    std::vector<std::string> blobs { carrier ({ std::string ("\x01", 1) }) };
+    for (int i { 0 } ; i < 8 ; ++i) {
+        blobs.push_back (carrier ({ blobs.back() }));
+    }
+
+    amqp::internal::ReaderCache cache;
+
+    auto all = BlobInspector (body (blobs.back()), cache).dump();
+    EXPECT_EQ (std::string::npos, all.find ("636F726461"));
+    EXPECT_NE (std::string::npos, all.find (R"({ a : "01" })"));
+
+    amqp::Limits limits;
+    limits.depth = 4;
+
+    // one level for each blob, the fifth is left as bytes
+    auto some = BlobInspector (body (blobs.back()), cache, limits).dump();
+    EXPECT_EQ (0U, some.find (
+        R"({ Parsed : { a : { Parsed : { a : { Parsed : { a : { Parsed : { a : "636F726461)"));
+    EXPECT_EQ (std::string::npos, some.find (R"({ a : "01" })"));
+}
+
+/******************************************************************************/
+
+/**
+ * Blobs nested side by side share what the outermost left of its limits,
+ * so however many there are they can't between them do more than it
+ * could, those there's nothing left for are left as bytes
+ */
+TEST (BlobInspector, nestedSiblings) { // NOLINT
+    auto inner = carrier (std::vector<std::string> (20, std::string ("\x01", 1)));
+    auto outer = carrier (std::vector<std::string> (16, inner));
+
+    amqp::Limits limits;
+    limits.nodes = 100;
+
+    amqp::internal::ReaderCache cache;
+
+    // each would fit on its own
+    EXPECT_EQ (0U, BlobInspector (body (inner), cache, limits).dump().find ("{ Parsed"));
+
+    auto count = [](const std::string & json_) {
+        std::size_t rtn { 0 };
+        for (auto i = json_.find ("{ Parsed") ; i != std::string::npos ; i = json_.find ("{ Parsed", i + 1)) {
+            ++rtn;
+        }
+        return rtn;
+    };
+
+    EXPECT_EQ (17U, count (BlobInspector (body (outer), cache).dump()));
+
+    auto some = BlobInspector (body (outer), cache, limits).dump();
+    EXPECT_EQ (0U, some.find ("{ Parsed"));
+    EXPECT_LT (count (some), 6U);
+    EXPECT_NE (std::string::npos, some.find ("636F726461"));
+}
+
+/******************************************************************************/
+
+/**
+ * Binary in base64 and cut short past the threshold, a blob nested in
+ * one rendered the same way
+ */
+TEST (BlobInspector, rendering) { // NOLINT
+    const std::string large (100, '\xff');
+
+    auto inner = carrier ({ large });
+    auto outer = carrier ({ std::string ("foo"), inner });
+
+    amqp::Rendering rendering;
+    rendering.binary = amqp::Rendering::Binary::Base64;
+    rendering.truncate = 6;
+
+    amqp::internal::ReaderCache cache;
+
+    EXPECT_EQ (
+        R"({ Parsed : { a : "Zm9v", b : { Parsed : { a : "////////...[100 bytes]" } } } })",
+        BlobInspector (body (outer), cache, amqp::Limits(), rendering).dump());
+
+    EXPECT_EQ (
+        R"({ Parsed : { a : "666F6F", b : { Parsed : { a : ")" + std::string (200, 'F') + R"(" } } } })",
+        BlobInspector (body (outer), cache).dump());
+}
+
+/******************************************************************************/
+
+/**
+ * Arrays of numbers are read in bulk, a boxed one falling back to the
+ * element reader for its nulls and carrying on after them
+ */
+TEST (BlobInspector, numbers) { // NOLINT
+    using namespace amqp::internal::encoding;
+
+    const std::string doubles { fingerprint ("double[p]") };
+    const std::string boxed { fingerprint ("int[]") };
+    const std::string longs { fingerprint ("long[p]") };
+    const std::string prices { fingerprint ("prices") };
+
+    SchemaWriter schema;
+    schema.composite ("net.corda.Prices", prices, {
+        { "a", FieldSpec { "double[p]", "", "", true, "" } },
+        { "b", FieldSpec { "int[]", "", "", true, "" } },
+        { "c", FieldSpec { "long[p]", "", "", true, "" } } });
+    schema.list ("double[p]", doubles);
+    schema.list ("int[]", boxed);
+    schema.list ("long[p]", longs);
+
+    test::BlobBuilder builder;
+    auto data = builder.data();
+
+    builder.described (prices);
+    builder.described (doubles);
+    pn_data_put_double (data, 1.5);
+    pn_data_put_double (data, -2.25);
+    builder.exit();
+    builder.described (boxed);
+    pn_data_put_int (data, 1);
+    pn_data_put_null (data);
+    pn_data_put_int (data, 3);
+    builder.exit();
+    builder.described (longs).exit();
+    builder.exit();
+
+    auto blob = builder.blob (schema);
+
+    const std::string expected {
+        "{ Parsed : { a : [ 1.500000, -2.250000 ], b : [ 1, null, 3 ], c : [  ] } }" };
+
+    amqp::internal::ReaderCache strict;
+    amqp::internal::ReaderCache trusted (amqp::Validation::Trusted);
+
+    EXPECT_EQ (expected, BlobInspector (body (blob), strict).dump());
+    EXPECT_EQ (expected, BlobInspector (body (blob), trusted).dump());
+}
+
+/******************************************************************************/
@@ -0,0 +1,293 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <proton/codec.h>
+
+#include "CordaBytes.h"
+#include "BlobInspector.h"
+
+#include "proton/proton_wrapper.h"
+#include "amqp/Encoding.h"
+#include "amqp/ReaderCache.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/LazyCompositeFactory.h"
+#include "amqp/schema/described-types/Envelope.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+
+#include "TestUtils.h"
+
+/******************************************************************************
+ *
+ * Stress tests for decoding on more than one thread, only really meaningful
+ * when built with -DSANITIZE_THREAD=ON and run under ThreadSanitizer, but
+ * they'll still catch the grosser races without it.
+ *
+ ******************************************************************************/
+
+namespace {
+
+    const std::string filepath ("../../test-files/"); // NOLINT
+
+    const std::vector<std::string> blobs { // NOLINT
+        "_i_", "_i_is__", "_Li_", "_L_i__", "_Le_", "_e_", "_Mis_",
+        "_Mi_is__", "_MiLs_", "_ALd_", "_Ai_", "_Ci_", "__i_LMis_l__", "_poly_"
+    };
+
+    constexpr int THREADS { 8 };
+    constexpr int ITERATIONS { 25 };
+
+    /**
+     * Run [f_] on [THREADS] threads at once, each being told which it is
+     */
+    template<typename F>
+    void
+    parallel (F f_) {
+        std::atomic<bool> go { false };
+        std::vector<std::thread> threads;
+
+        for (int t { 0 } ; t < THREADS ; ++t) {
+            threads.emplace_back ([&go, &f_, t]() {
+                while (!go) {
+                    std::this_thread::yield();
+                }
+
+                f_ (t);
+            });
+        }
+
+        go = true;
+
+        for (auto & thread : threads) {
+            thread.join();
+        }
+    }
+
+    /**
+     * Just enough of BlobInspector to let us share one factory between
+     * many decodes of the same blob
+     */
+    class Decoded {
+        private :
+            pn_data_t * m_data;
+
+        public :
+            uPtr<amqp::internal::schema::Envelope> envelope;
+
+            explicit Decoded (const CordaBytes & cb_)
+                : m_data (pn_data (cb_.size()))
+            {
+                pn_data_decode (m_data, cb_.bytes(), cb_.size());
+
+                proton::auto_enter ae (m_data);
+
+                envelope.reset (
+                    dynamic_cast<amqp::internal::schema::Envelope *> (
+                        amqp::internal::registeredDescriptor (
+                            pn_data_get_ulong (m_data)).build (m_data).release()));
+            }
+
+            Decoded (const Decoded &) = delete;
+
+            ~Decoded() {
+                pn_data_free (m_data);
+            }
+
+            std::string dump (const amqp::internal::CompositeFactory & cf_) {
+                auto reader = cf_.byDescriptor (envelope->descriptor());
+
+                pn_data_rewind (m_data);
+                pn_data_next (m_data);
+
+                proton::auto_enter ae (m_data);
+                pn_data_next (m_data);
+                proton::auto_enter ae2 (m_data);
+
+                return reader->dump ("{ Parsed", m_data, envelope->schema())->dump() + " }";
+            }
+    };
+
+}
+
+/******************************************************************************/
+
+/**
+ * Independent decodes share nothing but the registries
+ */
+TEST (Concurrency, inspectors) { // NOLINT
+    std::vector<std::string> expected;
+
+    for (const auto & blob : blobs) {
+        CordaBytes cb (filepath + blob);
+        expected.emplace_back (BlobInspector (cb).dump());
+    }
+
+    std::atomic<int> mismatches { 0 };
+
+    parallel ([&](int t_) {
+        for (int i { 0 } ; i < ITERATIONS ; ++i) {
+            auto n = (t_ + i) % blobs.size();
+            CordaBytes cb (filepath + blobs[n]);
+
+            auto validation = (i % 2) ? amqp::Validation::Trusted : amqp::Validation::Strict;
+
+            if (BlobInspector (cb, validation).dump() != expected[n]) {
+                ++mismatches;
+            }
+        }
+    });
+
+    EXPECT_EQ (0, mismatches);
+}
+
+/******************************************************************************/
+
+/**
+ * One factory, built once, whose readers, polymorphic caches included, are
+ * then used by every thread at once
+ */
+TEST (Concurrency, sharedFactory) { // NOLINT
+    for (const auto & blob : blobs) {
+        CordaBytes cb (filepath + blob);
+
+        Decoded schema (cb);
+        amqp::internal::CompositeFactory cf;
+        cf.process (schema.envelope->schema());
+
+        std::string expected { BlobInspector (cb).dump() };
+        std::atomic<int> mismatches { 0 };
+
+        parallel ([&](int) {
+            Decoded decoded (cb);
+
+            for (int i { 0 } ; i < ITERATIONS ; ++i) {
+                if (decoded.dump (cf) != expected) {
+                    ++mismatches;
+                }
+            }
+        });
+
+        EXPECT_EQ (0, mismatches) << blob;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * One lazy factory, so the first threads through build the readers the
+ * others are already asking it for
+ */
+TEST (Concurrency, lazyFactory) { // NOLINT
+    for (const auto & blob : blobs) {
+        CordaBytes cb (filepath + blob);
+
+        Decoded schema (cb);
+        amqp::internal::LazyCompositeFactory cf;
+        cf.process (schema.envelope->schema());
+
+        std::string expected { BlobInspector (cb).dump() };
+        std::atomic<int> mismatches { 0 };
+
+        parallel ([&](int) {
+            Decoded decoded (cb);
+
+            for (int i { 0 } ; i < ITERATIONS ; ++i) {
+                if (decoded.dump (cf) != expected) {
+                    ++mismatches;
+                }
+            }
+        });
+
+        EXPECT_EQ (0, mismatches) << blob;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Every thread racing to find, and for the first blob of each type build,
+ * its readers in one cache. It starts with room for one schema so it has
+ * to grow several times whilst being read.
+ */
+TEST (Concurrency, readerCache) { // NOLINT
+    std::vector<std::string> expected;
+
+    for (const auto & blob : blobs) {
+        CordaBytes cb (filepath + blob);
+        expected.emplace_back (BlobInspector (cb).dump());
+    }
+
+    amqp::internal::ReaderCache cache (amqp::Validation::Strict, 1);
+    std::atomic<int> mismatches { 0 };
+
+    parallel ([&](int t_) {
+        for (int i { 0 } ; i < ITERATIONS ; ++i) {
+            auto n = (t_ + i) % blobs.size();
+            CordaBytes cb (filepath + blobs[n]);
+
+            if (BlobInspector (cb, cache).dump() != expected[n]) {
+                ++mismatches;
+            }
+        }
+    });
+
+    EXPECT_EQ (0, mismatches);
+    EXPECT_EQ (blobs.size(), cache.size());
+}
+
+/******************************************************************************/
+
+/**
+ * Every thread dumping blobs that carry many others at once, each asking
+ * the one pool of threads to help with its nested blobs and going on
+ * without whichever helpers it never got
+ */
+TEST (Concurrency, nested) { // NOLINT
+    using namespace amqp::internal::encoding;
+
+    auto carrier = [](const std::vector<std::string> & binaries_) {
+        std::vector<std::pair<std::string, FieldSpec>> fields;
+        for (std::size_t i { 0 } ; i < binaries_.size() ; ++i) {
+            fields.emplace_back (
+                "f" + std::to_string (i),
+                FieldSpec { "binary", "", "", true, "" });
+        }
+
+        auto descriptor = fingerprint ("carrier" + std::to_string (binaries_.size()));
+
+        SchemaWriter schema;
+        schema.composite ("net.corda.Carrier", descriptor, std::move (fields));
+
+        test::BlobBuilder builder;
+        builder.described (descriptor);
+        for (const auto & binary : binaries_) {
+            pn_data_put_binary (builder.data(), pn_bytes (binary.size(), binary.data()));
+        }
+        builder.exit();
+
+        return builder.blob (schema);
+    };
+
+    auto inner = carrier ({ std::string ("\x01\x02", 2) });
+    auto outer = carrier (std::vector<std::string> (16, inner));
+
+    amqp::internal::ReaderCache cache;
+    const auto expected = BlobInspector (test::body (outer), cache).dump();
+    ASSERT_EQ (std::string::npos, expected.find ("636F726461"));
+
+    std::atomic<int> mismatches { 0 };
+
+    parallel ([&](int) {
+        for (int i { 0 } ; i < ITERATIONS ; ++i) {
+            if (BlobInspector (test::body (outer), cache).dump() != expected) {
+                ++mismatches;
+            }
+        }
+    });
+
+    EXPECT_EQ (0, mismatches);
+}
+
+/******************************************************************************/
@@ -0,0 +1,58 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+
+/******************************************************************************/
+
+namespace amqp {
+
+    enum class DecodeStatus {
+        Ok,
+        UnexpectedType,     // a node wasn't the AMQP type its position requires
+        MissingElement,     // a list was shorter than its described type needs
+        UnknownDescriptor,  // a described value the schema doesn't mention
+        Unsupported,        // valid, but something we can't decode yet
+        LimitExceeded,      // decoding would take more than we allow a blob
+        Failed              // the decoder itself gave up
+    };
+
+    inline const char *
+    toString (DecodeStatus status_) {
+        switch (status_) {
+            case DecodeStatus::Ok                : return "ok";
+            case DecodeStatus::UnexpectedType    : return "unexpected type";
+            case DecodeStatus::MissingElement    : return "missing element";
+            case DecodeStatus::UnknownDescriptor : return "unknown descriptor";
+            case DecodeStatus::Unsupported       : return "unsupported";
+            case DecodeStatus::LimitExceeded     : return "limit exceeded";
+            case DecodeStatus::Failed            : return "failed";
+        }
+
+        return "unknown";
+    }
+
+    /**
+     * The outcome of decoding a blob without throwing.
+     *
+     * On failure [node] is the offending node's pre-order index within
+     * the proton tree and [path] how we got to it, e.g.
+     *
+     *     schema.types[3].fields[1]
+     *     value.a.b[2]
+     */
+    struct DecodeResult {
+        DecodeStatus status { DecodeStatus::Ok };
+        std::size_t  node { 0 };
+        std::string  path;
+        std::string  what;
+        std::string  value;
+
+        bool ok() const { return status == DecodeStatus::Ok; }
+    };
+
+}
+
+/******************************************************************************/
@@ -11,6 +11,15 @@
 
 namespace amqp {
 
+    /**
+     * Builds the readers for the types a schema describes.
+     *
+     * Thread safety: [process] modifies the factory and must not overlap
+     * with anything else done to it. Once it has returned, the lookups
+     * and the readers they return never modify anything shared, so any
+     * number of threads may use them at once, each decoding its own
+     * pn_data_t.
+     */
     template <class SchemaIterator>
     class ICompositeFactory {
         public :
@@ -23,8 +32,11 @@ namespace amqp {
 
             virtual void process (const SchemaType &) = 0;
 
-            virtual const std::shared_ptr<ReaderType> byType (const std::string &) = 0;
-            virtual const std::shared_ptr<ReaderType> byDescriptor (const std::string &) = 0;
+            /**
+             * Readers remain owned by the factory and live as long as it does
+             */
+            virtual const ReaderType * byType (const std::string &) const = 0;
+            virtual const ReaderType * byDescriptor (const std::string &) const = 0;
     };
 
 }
@@ -0,0 +1,40 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <cstddef>
+#include <stdexcept>
+
+/******************************************************************************/
+
+namespace amqp {
+
+    /**
+     * How much of anything a single blob may make us do.
+     *
+     * The defaults are far beyond anything Corda writes, they're there so
+     * a malformed or malicious blob fails rather than taking the process
+     * with it. A zero [time] means there's no deadline.
+     */
+    struct Limits {
+        std::size_t depth { 256 };             // nested described values
+        std::size_t nodes { 1UL << 24 };       // values read
+        std::size_t bytes { 1UL << 30 };       // blob plus decoded text
+        std::chrono::milliseconds time { 0 };  // wall time per blob
+    };
+
+    /**
+     * Thrown when decoding a blob would take it past one of its [Limits]
+     */
+    class LimitExceeded : public std::runtime_error {
+        public :
+            explicit LimitExceeded (const std::string & what_)
+                : std::runtime_error (what_)
+            { }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,28 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstddef>
+
+/******************************************************************************/
+
+namespace amqp {
+
+    /**
+     * How a blob's values are written out.
+     *
+     * Binary is shown as upper case hex, as Corda prints it, or as
+     * base64 which is a third shorter. Anything longer than [truncate]
+     * bytes, an attachment chunk say, has only that many shown followed
+     * by its full length. A zero [truncate] shows everything.
+     */
+    struct Rendering {
+        enum class Binary { Hex, Base64 };
+
+        Binary      binary { Binary::Hex };
+        std::size_t truncate { 0 };
+    };
+
+}
+
+/******************************************************************************/
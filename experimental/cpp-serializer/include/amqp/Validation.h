@@ -0,0 +1,23 @@
+#pragma once
+
+/******************************************************************************/
+
+namespace amqp {
+
+    /**
+     * How much checking the readers do as they decode a payload.
+     *
+     * Strict checks every node is what we expect before reading it, what
+     * you want for a blob from anywhere else. Trusted still validates the
+     * envelope and schema but then reads the payload without checking it,
+     * for blobs we wrote ourselves and know to be well formed. Feed it
+     * anything else and the results are undefined.
+     */
+    enum class Validation {
+        Strict,
+        Trusted
+    };
+
+}
+
+/******************************************************************************/
@@ -9,6 +9,8 @@ namespace amqp::schema {
     template <class Iterator>
     class ISchema {
         public :
+            virtual ~ISchema() = default;
+
             virtual Iterator fromType (const std::string &) const = 0;
             virtual Iterator fromDescriptor (const std::string &) const = 0;
     };
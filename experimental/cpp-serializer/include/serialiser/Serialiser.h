@@ -2,14 +2,75 @@
 
 /******************************************************************************/
 
+#include <memory>
+#include <string>
+
+#include <proton/codec.h>
+
+#include "amqp/Binding.h"
+
+/******************************************************************************/
+
 namespace serialiser {
 
+    /**
+     * Writes structs bound with AMQP_BINDING as Corda blobs.
+     *
+     * Only the value is encoded per message, the schema and transforms
+     * sections that follow it are the same for every value of a type so
+     * are encoded the first time that type is written and copied in from
+     * then on. Keeps the tree it encodes through between messages, so
+     * have one per thread.
+     */
     class Serialiser {
+        private :
+            std::unique_ptr<pn_data_t, decltype (&pn_data_free)> m_data;
+            std::string m_value;
 
+        public :
+            Serialiser() : m_data (pn_data (0), &pn_data_free) { }
+
+            /**
+             * Append a blob holding [value_] to [out_]
+             */
+            template<class T>
+            void serialise (const T & value_, std::string & out_);
+
+            template<class T>
+            std::string serialise (const T & value_);
     };
 
 }
 
 /******************************************************************************/
 
+template<class T>
+void
+serialiser::
+Serialiser::serialise (const T & value_, std::string & out_) {
+    using namespace amqp::internal;
+
+    const auto & sections = binding::sections<T>();
+
+    pn_data_clear (m_data.get());
+    m_value.clear();
+
+    binding::put (m_data.get(), value_);
+    encoding::encode (m_data.get(), m_value);
+
+    encoding::envelope (out_, m_value, sections);
+}
+
+/******************************************************************************/
+
+template<class T>
+std::string
+serialiser::
+Serialiser::serialise (const T & value_) {
+    std::string rtn;
+    serialise (value_, rtn);
+
+    return rtn;
+}
 
+/******************************************************************************/
@@ -29,3 +29,14 @@ using spStrMap_t = std::map<std::string, sPtr<T>>;
 
 /******************************************************************************/
 
+
+/**
+ * Build a single visitor out of a set of lambdas for use with std::visit
+ */
+template<class... Ts>
+struct overloaded : Ts... { using Ts::operator()...; };
+
+template<class... Ts>
+overloaded (Ts...) -> overloaded<Ts...>;
+
+/******************************************************************************/
@@ -0,0 +1,342 @@
+#include "Binary.h"
+
+#include <cstdint>
+
+#ifdef AMQP_X86
+#include <immintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    using amqp::internal::binary::Engine;
+
+    constexpr char HEX[] = "0123456789ABCDEF";
+
+    constexpr char ALPHABET[] = // NOLINT
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    thread_local const amqp::Rendering * s_rendering { nullptr };
+
+    /*
+     * Each engine encodes as much of its input as fills whole vectors,
+     * returning how much that was, and leaves the rest to the scalar
+     * encoders
+     */
+
+    void
+    hexScalar (const uint8_t * in_, std::size_t size_, char * out_) {
+        for (std::size_t i { 0 } ; i < size_ ; ++i) {
+            out_[2 * i]     = HEX[in_[i] >> 4U];
+            out_[2 * i + 1] = HEX[in_[i] & 0xfU];
+        }
+    }
+
+    /**
+     * Every three bytes to four characters, the last group padded
+     */
+    void
+    base64Scalar (const uint8_t * in_, std::size_t size_, char * out_) {
+        for (std::size_t i { 0 } ; i < size_ ; i += 3, out_ += 4) {
+            uint32_t n = in_[i] << 16U;
+            if (i + 1 < size_) n |= in_[i + 1] << 8U;
+            if (i + 2 < size_) n |= in_[i + 2];
+
+            out_[0] = ALPHABET[(n >> 18U) & 0x3fU];
+            out_[1] = ALPHABET[(n >> 12U) & 0x3fU];
+            out_[2] = i + 1 < size_ ? ALPHABET[(n >> 6U) & 0x3fU] : '=';
+            out_[3] = i + 2 < size_ ? ALPHABET[n & 0x3fU] : '=';
+        }
+    }
+
+#ifdef AMQP_X86
+
+    /**
+     * Each byte's nibbles looked up in a register of digits and
+     * interleaved back together
+     */
+    __attribute__ ((target ("ssse3")))
+    std::size_t
+    hexSSSE3 (const uint8_t * in_, std::size_t size_, char * out_) {
+        const auto digits = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(HEX));
+        const auto nibble = _mm_set1_epi8 (0x0f);
+
+        std::size_t i { 0 };
+        for ( ; i + 16 <= size_ ; i += 16) {
+            auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(in_ + i));
+
+            auto hi = _mm_shuffle_epi8 (digits, _mm_and_si128 (_mm_srli_epi16 (v, 4), nibble));
+            auto lo = _mm_shuffle_epi8 (digits, _mm_and_si128 (v, nibble));
+
+            auto out = reinterpret_cast<__m128i *>(out_ + 2 * i);
+            _mm_storeu_si128 (out,     _mm_unpacklo_epi8 (hi, lo));
+            _mm_storeu_si128 (out + 1, _mm_unpackhi_epi8 (hi, lo));
+        }
+
+        return i;
+    }
+
+    __attribute__ ((target ("avx2")))
+    std::size_t
+    hexAVX2 (const uint8_t * in_, std::size_t size_, char * out_) {
+        const auto digits = _mm256_broadcastsi128_si256 (
+            _mm_loadu_si128 (reinterpret_cast<const __m128i *>(HEX)));
+        const auto nibble = _mm256_set1_epi8 (0x0f);
+
+        std::size_t i { 0 };
+        for ( ; i + 32 <= size_ ; i += 32) {
+            auto v = _mm256_loadu_si256 (reinterpret_cast<const __m256i *>(in_ + i));
+
+            auto hi = _mm256_shuffle_epi8 (digits, _mm256_and_si256 (_mm256_srli_epi16 (v, 4), nibble));
+            auto lo = _mm256_shuffle_epi8 (digits, _mm256_and_si256 (v, nibble));
+
+            // the unpacks work within each half so the halves need
+            // putting back in order
+            auto a = _mm256_unpacklo_epi8 (hi, lo);
+            auto b = _mm256_unpackhi_epi8 (hi, lo);
+
+            auto out = reinterpret_cast<__m256i *>(out_ + 2 * i);
+            _mm256_storeu_si256 (out,     _mm256_permute2x128_si256 (a, b, 0x20));
+            _mm256_storeu_si256 (out + 1, _mm256_permute2x128_si256 (a, b, 0x31));
+        }
+
+        return i + hexSSSE3 (in_ + i, size_ - i, out_ + 2 * i);
+    }
+
+    /*
+     * Base64 after Muła and Lemire. Every three bytes are shuffled into
+     * a 32 bit lane, the four six bit indices in it moved to a byte each
+     * with a pair of multiplies, and each index mapped to its character
+     * by adding the offset for whichever of the alphabet's five ranges
+     * it falls in.
+     */
+
+    __attribute__ ((target ("ssse3")))
+    __m128i
+    indices (__m128i v_) {
+        v_ = _mm_shuffle_epi8 (v_, _mm_set_epi8 (
+            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+        auto ac = _mm_mulhi_epu16 (
+            _mm_and_si128 (v_, _mm_set1_epi32 (0x0fc0fc00)),
+            _mm_set1_epi32 (0x04000040));
+
+        auto bd = _mm_mullo_epi16 (
+            _mm_and_si128 (v_, _mm_set1_epi32 (0x003f03f0)),
+            _mm_set1_epi32 (0x01000010));
+
+        return _mm_or_si128 (ac, bd);
+    }
+
+    __attribute__ ((target ("ssse3")))
+    __m128i
+    characters (__m128i indices_) {
+        const auto offsets = _mm_setr_epi8 (
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+            '/' - 63, 'A', 0, 0);
+
+        // 0 for a-z, 1 to 12 for the digits, + and /, 13 for A-Z
+        auto range = _mm_or_si128 (
+            _mm_subs_epu8 (indices_, _mm_set1_epi8 (51)),
+            _mm_and_si128 (_mm_cmpgt_epi8 (_mm_set1_epi8 (26), indices_), _mm_set1_epi8 (13)));
+
+        return _mm_add_epi8 (_mm_shuffle_epi8 (offsets, range), indices_);
+    }
+
+    /**
+     * Twelve bytes at a time, though each load reads sixteen
+     */
+    __attribute__ ((target ("ssse3")))
+    std::size_t
+    base64SSSE3 (const uint8_t * in_, std::size_t size_, char * out_) {
+        std::size_t i { 0 };
+        for ( ; i + 16 <= size_ ; i += 12, out_ += 16) {
+            auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(in_ + i));
+
+            _mm_storeu_si128 (reinterpret_cast<__m128i *>(out_), characters (indices (v)));
+        }
+
+        return i;
+    }
+
+    __attribute__ ((target ("avx2")))
+    __m256i
+    indices (__m256i v_) {
+        v_ = _mm256_shuffle_epi8 (v_, _mm256_set_epi8 (
+            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+        auto ac = _mm256_mulhi_epu16 (
+            _mm256_and_si256 (v_, _mm256_set1_epi32 (0x0fc0fc00)),
+            _mm256_set1_epi32 (0x04000040));
+
+        auto bd = _mm256_mullo_epi16 (
+            _mm256_and_si256 (v_, _mm256_set1_epi32 (0x003f03f0)),
+            _mm256_set1_epi32 (0x01000010));
+
+        return _mm256_or_si256 (ac, bd);
+    }
+
+    __attribute__ ((target ("avx2")))
+    __m256i
+    characters (__m256i indices_) {
+        const auto offsets = _mm256_setr_epi8 (
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+            '/' - 63, 'A', 0, 0,
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+            '/' - 63, 'A', 0, 0);
+
+        auto range = _mm256_or_si256 (
+            _mm256_subs_epu8 (indices_, _mm256_set1_epi8 (51)),
+            _mm256_and_si256 (
+                _mm256_cmpgt_epi8 (_mm256_set1_epi8 (26), indices_),
+                _mm256_set1_epi8 (13)));
+
+        return _mm256_add_epi8 (_mm256_shuffle_epi8 (offsets, range), indices_);
+    }
+
+    /**
+     * Twenty four bytes at a time, twelve in each half of the register
+     */
+    __attribute__ ((target ("avx2")))
+    std::size_t
+    base64AVX2 (const uint8_t * in_, std::size_t size_, char * out_) {
+        std::size_t i { 0 };
+        for ( ; i + 28 <= size_ ; i += 24, out_ += 32) {
+            auto v = _mm256_inserti128_si256 (
+                _mm256_castsi128_si256 (
+                    _mm_loadu_si128 (reinterpret_cast<const __m128i *>(in_ + i))),
+                _mm_loadu_si128 (reinterpret_cast<const __m128i *>(in_ + i + 12)),
+                1);
+
+            _mm256_storeu_si256 (reinterpret_cast<__m256i *>(out_), characters (indices (v)));
+        }
+
+        return i + base64SSSE3 (in_ + i, size_ - i, out_);
+    }
+
+#endif
+
+    Engine
+    resolve (Engine engine_) {
+        static const Engine fastest = amqp::internal::cpu::best (
+            amqp::internal::binary::KERNELS);
+
+        return engine_ == Engine::Best
+            ? fastest
+            : amqp::internal::cpu::resolve (
+                engine_, amqp::internal::binary::KERNELS, "Binary");
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::binary
+ *
+ ******************************************************************************/
+
+void
+amqp::internal::binary::
+hex (std::string_view bytes_, std::string & out_, Engine engine_) {
+    engine_ = resolve (engine_);
+
+    auto in = reinterpret_cast<const uint8_t *>(bytes_.data());
+    auto offset = out_.size();
+
+    out_.resize (offset + 2 * bytes_.size());
+    auto out = out_.data() + offset;
+
+    std::size_t done { 0 };
+
+    switch (engine_) {
+#ifdef AMQP_X86
+        case Engine::SSSE3 : done = hexSSSE3 (in, bytes_.size(), out); break;
+        case Engine::AVX2  : done = hexAVX2 (in, bytes_.size(), out); break;
+#endif
+        default : break;
+    }
+
+    hexScalar (in + done, bytes_.size() - done, out + 2 * done);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::binary::
+base64 (std::string_view bytes_, std::string & out_, Engine engine_) {
+    engine_ = resolve (engine_);
+
+    auto in = reinterpret_cast<const uint8_t *>(bytes_.data());
+    auto offset = out_.size();
+
+    out_.resize (offset + 4 * ((bytes_.size() + 2) / 3));
+    auto out = out_.data() + offset;
+
+    std::size_t done { 0 };
+
+    switch (engine_) {
+#ifdef AMQP_X86
+        case Engine::SSSE3 : done = base64SSSE3 (in, bytes_.size(), out); break;
+        case Engine::AVX2  : done = base64AVX2 (in, bytes_.size(), out); break;
+#endif
+        default : break;
+    }
+
+    // the engines only ever take whole groups of three
+    base64Scalar (in + done, bytes_.size() - done, out + 4 * (done / 3));
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::binary::
+render (std::string_view bytes_) {
+    auto shown = bytes_;
+
+    if (s_rendering && s_rendering->truncate && bytes_.size() > s_rendering->truncate) {
+        shown = bytes_.substr (0, s_rendering->truncate);
+    }
+
+    std::string rtn { "\"" };
+
+    if (s_rendering && s_rendering->binary == Rendering::Binary::Base64) {
+        base64 (shown, rtn);
+    } else {
+        hex (shown, rtn);
+    }
+
+    if (shown.size() < bytes_.size()) {
+        rtn += "...[" + std::to_string (bytes_.size()) + " bytes]";
+    }
+
+    rtn += '"';
+
+    return rtn;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::binary::Scope
+ *
+ ******************************************************************************/
+
+amqp::internal::binary::
+Scope::Scope (const Rendering & rendering_)
+    : m_previous (s_rendering)
+{
+    s_rendering = &rendering_;
+}
+
+/******************************************************************************/
+
+amqp::internal::binary::
+Scope::~Scope() {
+    s_rendering = m_previous;
+}
+
+/******************************************************************************/
@@ -0,0 +1,56 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <string_view>
+
+#include "amqp/Cpu.h"
+#include "amqp/Rendering.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::binary {
+
+    using cpu::Engine;
+
+    /**
+     * What can do the encoding, both needing SSSE3's byte shuffle
+     */
+    constexpr cpu::Kernels KERNELS { Engine::AVX2, Engine::SSSE3 };
+
+    /**
+     * Append [bytes_] to [out_] as upper case hex
+     */
+    void hex (std::string_view bytes_, std::string & out_, Engine = Engine::Best);
+
+    /**
+     * Append [bytes_] to [out_] as padded base64 from the standard
+     * alphabet
+     */
+    void base64 (std::string_view bytes_, std::string & out_, Engine = Engine::Best);
+
+    /**
+     * Makes [rendering_] how this thread renders binary until we're
+     * destroyed, putting back whatever was there before
+     */
+    class Scope {
+        private :
+            const Rendering * m_previous;
+
+        public :
+            explicit Scope (const Rendering & rendering_);
+            Scope (const Scope &) = delete;
+            ~Scope();
+    };
+
+    /**
+     * A binary value as the [Rendering] in scope says, as it always was,
+     * in full and in hex, if there isn't one. It's quoted, along with
+     * any note that it's been cut short, so it's always a JSON string.
+     */
+    std::string render (std::string_view bytes_);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,158 @@
+#include "Binding.h"
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <stdexcept>
+
+#include "debug.h"
+
+#include "amqp/schema/field-types/Field.h"
+#include "amqp/schema/described-types/Composite.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using Plan = amqp::internal::binding::Binder::Plan;
+
+    /**
+     * A plan this thread looked up, and which binder and type it was
+     * looked up for
+     */
+    struct Recent {
+        std::uint64_t binder { 0 };
+        std::type_index type { typeid (void) };
+        std::string descriptor;
+        const Plan * plan { nullptr };
+    };
+
+    /**
+     * Direct mapped, each slot holding whichever lookup last hashed to
+     * it. Far more than the handful of structs anything binds.
+     */
+    constexpr std::size_t RECENT { 64 };
+
+    thread_local std::array<Recent, RECENT> t_recent;
+
+    std::atomic<std::uint64_t> s_binders { 0 };
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::binding::Binder
+ *
+ ******************************************************************************/
+
+amqp::internal::binding::
+Binder::Binder()
+    : m_id (++s_binders)
+{
+}
+
+/******************************************************************************/
+
+const amqp::internal::binding::Binder::Plan &
+amqp::internal::binding::
+Binder::plan (
+    std::type_index type_,
+    const std::vector<Member> & members_,
+    std::string_view descriptor_,
+    const Context & context_
+) const {
+    auto & recent = t_recent[
+        (std::hash<std::string_view>{}(descriptor_) ^ type_.hash_code()) % RECENT];
+
+    if (recent.binder == m_id && recent.type == type_ && recent.descriptor == descriptor_) {
+        return *recent.plan;
+    }
+
+    const auto & rtn = lookup (type_, members_, descriptor_, context_);
+
+    recent.binder = m_id;
+    recent.type = type_;
+    recent.descriptor.assign (descriptor_);
+    recent.plan = &rtn;
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+const amqp::internal::binding::Binder::Plan &
+amqp::internal::binding::
+Binder::lookup (
+    std::type_index type_,
+    const std::vector<Member> & members_,
+    std::string_view descriptor_,
+    const Context & context_
+) const {
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+
+        auto & plans = m_plans[type_];
+
+        auto it = plans.find (descriptor_);
+        if (it != plans.end()) {
+            return *it->second;
+        }
+    }
+
+    std::string descriptor (descriptor_);
+
+    // the factory's lookup is what tells us the blob's schema really
+    // does describe it, the schema is what names its fields
+    if (!context_.factory().byDescriptor (descriptor)) {
+        throw std::runtime_error ("No reader for " + descriptor);
+    }
+
+    auto type = context_.schema().findDescriptor (descriptor);
+
+    const auto * composite = type
+        ? type->visit (overloaded {
+            [](const schema::Composite & c_) { return &c_; },
+            [](const auto &) -> const schema::Composite * { return nullptr; }
+          })
+        : nullptr;
+
+    if (!composite) {
+        throw std::runtime_error (descriptor + " isn't a composite we can bind");
+    }
+
+    DBG ("Binder::plan - " << composite->name() << std::endl); // NOLINT
+
+    auto plan = std::make_unique<Plan> (composite->fields().size(), nullptr);
+
+    for (std::size_t i { 0 } ; i < plan->size() ; ++i) {
+        const auto & name = composite->fields()[i]->name();
+
+        for (const auto & member : members_) {
+            if (name == member.name) {
+                (*plan)[i] = member.set;
+                break;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return *m_plans[type_].emplace (std::move (descriptor), std::move (plan)).first->second;
+}
+
+/******************************************************************************/
+
+std::size_t
+amqp::internal::binding::
+Binder::size() const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    std::size_t rtn { 0 };
+    for (const auto & plans : m_plans) {
+        rtn += plans.second.size();
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
@@ -0,0 +1,785 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <typeindex>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include <proton/codec.h>
+
+#include "types.h"
+
+#include "amqp/Budget.h"
+#include "amqp/Limits.h"
+#include "amqp/Encoding.h"
+#include "amqp/Verifier.h"
+#include "amqp/RawEnvelope.h"
+#include "amqp/ReaderCache.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/schema/TypeLookup.h"
+
+/******************************************************************************
+ *
+ * Declaring a binding
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::binding {
+
+    class Context;
+
+    /**
+     * Reads the value at the cursor into a member of the object at [obj_]
+     * and moves past it
+     */
+    using Setter = void (*)(const Context &, pn_data_t *, void * obj_);
+
+    /**
+     * Writes a member of the object at [obj_] at the cursor
+     */
+    using Putter = void (*)(pn_data_t *, const void * obj_);
+
+    /**
+     * How a member's field is described, adding any types it needs to
+     * the schema being written if there is one
+     */
+    using Describer = encoding::FieldSpec (*)(encoding::SchemaWriter *);
+
+    struct Member {
+        const char * name;
+        Setter       set;
+        Putter       put;
+        Describer    describe;
+    };
+
+    /**
+     * Specialised, by [AMQP_BINDING], for each struct blobs can be
+     * decoded into or encoded from, naming the Java class it stands for
+     * and listing its members by the name of the field each is read from
+     * and written as
+     */
+    template<class T>
+    struct Binding;
+
+    template<class T, class = void>
+    struct isBound : std::false_type { };
+
+    template<class T>
+    struct isBound<T, std::void_t<decltype (Binding<T>::members())>>
+        : std::true_type { };
+
+    template<class T, class M, M T::* member_>
+    void set (const Context &, pn_data_t *, void *);
+
+    template<class T, class M, M T::* member_>
+    void putMember (pn_data_t *, const void *);
+
+    template<class M>
+    encoding::FieldSpec describe (encoding::SchemaWriter *);
+
+}
+
+/**
+ * Bind a struct to the fields of the Java class it stands for, members
+ * are matched to fields by name
+ *
+ *   AMQP_BINDING (Cash, "net.corda.finance.contracts.asset.Cash",
+ *       AMQP_MEMBER (Cash, amount),
+ *       AMQP_MEMBER (Cash, currency),
+ *       AMQP_MEMBER (Cash, owner))
+ *
+ * Used at global scope. A member can be any arithmetic type, a string,
+ * binary as a binding::Bytes, another bound struct, or a std::optional or
+ * std::vector of those.
+ */
+#define AMQP_BINDING(TYPE, CLASS, ...)                                        \
+    template<>                                                                \
+    struct amqp::internal::binding::Binding<TYPE> {                           \
+        static const char * name() { return CLASS; }                          \
+                                                                              \
+        static const std::vector<amqp::internal::binding::Member> &           \
+        members() {                                                           \
+            static const std::vector<amqp::internal::binding::Member> m {     \
+                __VA_ARGS__                                                   \
+            };                                                                \
+            return m;                                                         \
+        }                                                                     \
+    };
+
+#define AMQP_MEMBER(TYPE, NAME)                                               \
+    amqp::internal::binding::Member {                                         \
+        #NAME,                                                                \
+        &amqp::internal::binding::set<                                        \
+            TYPE, decltype (TYPE::NAME), &TYPE::NAME>,                        \
+        &amqp::internal::binding::putMember<                                  \
+            TYPE, decltype (TYPE::NAME), &TYPE::NAME>,                        \
+        &amqp::internal::binding::describe<decltype (TYPE::NAME)>             \
+    }
+
+/******************************************************************************
+ *
+ * class Binder
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::binding {
+
+    /**
+     * Decodes blobs straight into bound structs, with no [IValue] tree
+     * or strings in between.
+     *
+     * Which wire field feeds which member is worked out by name the
+     * first time a struct is read from a descriptor and kept, as a plan
+     * holding the setter for each field in wire order, nullptr for
+     * those the struct doesn't have. Descriptors are fingerprints of
+     * the type's shape so a plan holds for any schema carrying it and
+     * the rest of every decode is just running plans. Members the wire
+     * doesn't have are left as they were default constructed, as are
+     * any it holds a null for unless they're optional.
+     *
+     * Plans are only ever added, under a lock, so one binder is meant to
+     * be shared by every thread in the process. Each thread remembers the
+     * plans it looked up most recently, from any binder, so once it has
+     * seen a plan it runs it without taking the lock again.
+     */
+    class Binder {
+        public :
+            using Plan = std::vector<Setter>;
+
+        private :
+            /**
+             * Never reused, so what a thread remembers of a binder
+             * that's gone can't be mistaken for one of ours
+             */
+            const std::uint64_t m_id;
+
+            mutable std::mutex m_mutex;
+
+            mutable std::map<
+                std::type_index,
+                std::map<std::string, uPtr<const Plan>, std::less<>>> m_plans;
+
+            /**
+             * [plan] for those this thread doesn't remember
+             */
+            const Plan & lookup (
+                std::type_index type_,
+                const std::vector<Member> & members_,
+                std::string_view descriptor_,
+                const Context & context_) const;
+
+        public :
+            Binder();
+            Binder (const Binder &) = delete;
+
+            /**
+             * The plan for reading a [type_] from [descriptor_], the
+             * schema only being needed if it's the first time we've
+             * seen the pair
+             *
+             * @throws std::runtime_error if [context_] has no composite
+             * under [descriptor_]
+             */
+            const Plan & plan (
+                std::type_index type_,
+                const std::vector<Member> & members_,
+                std::string_view descriptor_,
+                const Context & context_) const;
+
+            /**
+             * Decode the composite at the cursor of [data_]
+             */
+            template<class T>
+            T decode (
+                pn_data_t * data_,
+                const CompositeFactory & factory_,
+                const schema::TypeLookup & schema_) const;
+
+            /**
+             * Decode the whole of [blob_], a Corda blob without its
+             * header, taking readers and schemas from [cache_]. It's
+             * verified first, as the inspector would, and decoding it
+             * may take no more than [limits_].
+             *
+             * @throws LimitExceeded if it would
+             */
+            template<class T>
+            T decode (
+                std::string_view blob_,
+                ReaderCache & cache_,
+                const Limits & limits_ = Limits()) const;
+
+            /**
+             * How many plans we've built
+             */
+            std::size_t size() const;
+    };
+
+    /**
+     * What a decode needs to hand down to the members it's filling in
+     */
+    class Context {
+        private :
+            const Binder &             m_binder;
+            const CompositeFactory &   m_factory;
+            const schema::TypeLookup & m_schema;
+
+        public :
+            Context (
+                const Binder & binder_,
+                const CompositeFactory & factory_,
+                const schema::TypeLookup & schema_
+            ) : m_binder (binder_)
+              , m_factory (factory_)
+              , m_schema (schema_)
+            { }
+
+            const CompositeFactory & factory() const { return m_factory; }
+            const schema::TypeLookup & schema() const { return m_schema; }
+
+            template<class M>
+            void read (pn_data_t *, M &) const;
+    };
+
+}
+
+/******************************************************************************
+ *
+ * Reading values
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::binding {
+
+    template<class T> struct isOptional : std::false_type { };
+    template<class T> struct isOptional<std::optional<T>> : std::true_type { };
+
+    template<class T> struct isVector : std::false_type { };
+    template<class T> struct isVector<std::vector<T>> : std::true_type { };
+
+    /**
+     * Bytes are binary, as the readers give it us, not a list of ubyte
+     */
+    using Bytes = std::vector<uint8_t>;
+    template<> struct isVector<Bytes> : std::false_type { };
+
+    template<class M>
+    constexpr pn_type_t pnType() {
+        if constexpr (std::is_same_v<M, bool>) return PN_BOOL;
+        else if constexpr (std::is_same_v<M, int8_t>) return PN_BYTE;
+        else if constexpr (std::is_same_v<M, uint8_t>) return PN_UBYTE;
+        else if constexpr (std::is_same_v<M, int16_t>) return PN_SHORT;
+        else if constexpr (std::is_same_v<M, uint16_t>) return PN_USHORT;
+        else if constexpr (std::is_same_v<M, int32_t>) return PN_INT;
+        else if constexpr (std::is_same_v<M, uint32_t>) return PN_UINT;
+        else if constexpr (std::is_same_v<M, int64_t>) return PN_LONG;
+        else if constexpr (std::is_same_v<M, uint64_t>) return PN_ULONG;
+        else if constexpr (std::is_same_v<M, float>) return PN_FLOAT;
+        else if constexpr (std::is_same_v<M, double>) return PN_DOUBLE;
+        else if constexpr (std::is_same_v<M, Bytes>) return PN_BINARY;
+        else return PN_STRING;
+    }
+
+    template<class M>
+    M get (pn_data_t * data_) {
+        if constexpr (std::is_same_v<M, bool>) return pn_data_get_bool (data_);
+        else if constexpr (std::is_same_v<M, int8_t>) return pn_data_get_byte (data_);
+        else if constexpr (std::is_same_v<M, uint8_t>) return pn_data_get_ubyte (data_);
+        else if constexpr (std::is_same_v<M, int16_t>) return pn_data_get_short (data_);
+        else if constexpr (std::is_same_v<M, uint16_t>) return pn_data_get_ushort (data_);
+        else if constexpr (std::is_same_v<M, int32_t>) return pn_data_get_int (data_);
+        else if constexpr (std::is_same_v<M, uint32_t>) return pn_data_get_uint (data_);
+        else if constexpr (std::is_same_v<M, int64_t>) return pn_data_get_long (data_);
+        else if constexpr (std::is_same_v<M, uint64_t>) return pn_data_get_ulong (data_);
+        else if constexpr (std::is_same_v<M, float>) return pn_data_get_float (data_);
+        else if constexpr (std::is_same_v<M, double>) return pn_data_get_double (data_);
+        else if constexpr (std::is_same_v<M, Bytes>) {
+            auto bytes = pn_data_get_binary (data_);
+            return Bytes (bytes.start, bytes.start + bytes.size);
+        } else {
+            auto bytes = pn_data_get_string (data_);
+            return std::string (bytes.start, bytes.size);
+        }
+    }
+
+    /**
+     * Moves onto the node after whatever's at the cursor however we leave
+     * reading it
+     */
+    class AutoNext {
+        private :
+            pn_data_t * m_data;
+
+        public :
+            explicit AutoNext (pn_data_t * data_) : m_data (data_) { }
+            ~AutoNext() { pn_data_next (m_data); }
+    };
+
+    /**
+     * Enter the list or array at the cursor, described if a restricted
+     * type, and read each element into [into_]
+     */
+    template<class M>
+    void
+    readAll (const Context & context_, pn_data_t * data_, std::vector<M> & into_) {
+        if (pn_data_type (data_) == PN_DESCRIBED) {
+            pn_data_enter (data_);
+            pn_data_next (data_);
+            pn_data_next (data_);
+            readAll (context_, data_, into_);
+            pn_data_exit (data_);
+            return;
+        }
+
+        std::size_t elements;
+        switch (pn_data_type (data_)) {
+            case PN_LIST  : elements = pn_data_get_list (data_); break;
+            case PN_ARRAY : elements = pn_data_get_array (data_); break;
+            default : throw std::runtime_error ("Expected a list");
+        }
+
+        Budget::Frame frame;
+        Budget::elements (elements);
+
+        into_.clear();
+        into_.reserve (elements);
+
+        pn_data_enter (data_);
+        pn_data_next (data_);
+
+        for (std::size_t i { 0 } ; i < elements ; ++i) {
+            into_.emplace_back();
+            context_.read (data_, into_.back());
+        }
+
+        pn_data_exit (data_);
+    }
+
+    /**
+     * Run the plan for the composite at the cursor against [into_]
+     */
+    template<class M>
+    void
+    readBound (
+        const Context & context_,
+        const Binder & binder_,
+        pn_data_t * data_,
+        M & into_
+    ) {
+        if (pn_data_type (data_) != PN_DESCRIBED) {
+            throw std::runtime_error ("Expected a composite");
+        }
+
+        Budget::Frame frame;
+
+        pn_data_enter (data_);
+        pn_data_next (data_);
+
+        if (pn_data_type (data_) != PN_SYMBOL) {
+            throw std::runtime_error ("Expected a descriptor");
+        }
+
+        auto symbol = pn_data_get_symbol (data_);
+
+        const auto & plan = binder_.plan (
+            std::type_index (typeid (M)),
+            Binding<M>::members(),
+            std::string_view (symbol.start, symbol.size),
+            context_);
+
+        pn_data_next (data_);
+
+        if (pn_data_type (data_) != PN_LIST) {
+            throw std::runtime_error ("Expected a composite's fields");
+        }
+
+        auto fields = std::min (pn_data_get_list (data_), plan.size());
+
+        pn_data_enter (data_);
+        pn_data_next (data_);
+
+        for (std::size_t i { 0 } ; i < fields ; ++i) {
+            if (plan[i]) {
+                plan[i] (context_, data_, &into_);
+            } else {
+                pn_data_next (data_);
+            }
+        }
+
+        pn_data_exit (data_);
+        pn_data_exit (data_);
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Every read leaves the cursor on the node after the one it read
+ */
+template<class M>
+void
+amqp::internal::binding::
+Context::read (pn_data_t * data_, M & into_) const {
+    if constexpr (isOptional<M>::value) {
+        if (pn_data_type (data_) == PN_NULL) {
+            into_.reset();
+            pn_data_next (data_);
+        } else {
+            read (data_, into_.emplace());
+        }
+    } else {
+        AutoNext an (data_);
+
+        if (pn_data_type (data_) == PN_NULL) {
+            Budget::node();
+            return;
+        }
+
+        if constexpr (isVector<M>::value) {
+            readAll (*this, data_, into_);
+        } else if constexpr (isBound<M>::value) {
+            readBound (*this, m_binder, data_, into_);
+        } else {
+            static_assert (
+                std::is_arithmetic_v<M>
+                    || std::is_same_v<M, std::string>
+                    || std::is_same_v<M, Bytes>,
+                "Members must be arithmetic, strings, bytes, bound or optionals "
+                "or vectors of those");
+
+            if (pn_data_type (data_) != pnType<M>()) {
+                throw std::runtime_error ("Member type doesn't match the blob");
+            }
+
+            Budget::node();
+
+            into_ = get<M> (data_);
+
+            if constexpr (!std::is_arithmetic_v<M>) {
+                Budget::bytes (into_.size());
+            }
+        }
+    }
+}
+
+/******************************************************************************/
+
+template<class T, class M, M T::* member_>
+void
+amqp::internal::binding::
+set (const Context & context_, pn_data_t * data_, void * obj_) {
+    context_.read (data_, static_cast<T *>(obj_)->*member_);
+}
+
+/******************************************************************************/
+
+template<class T>
+T
+amqp::internal::binding::
+Binder::decode (
+    pn_data_t * data_,
+    const CompositeFactory & factory_,
+    const schema::TypeLookup & schema_
+) const {
+    static_assert (isBound<T>::value, "Decoding needs an AMQP_BINDING");
+
+    T rtn { };
+
+    Context (*this, factory_, schema_).read (data_, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * As with the inspector the blob's size comes off the top of its budget
+ * and what the verifier passes the readers can trust
+ */
+template<class T>
+T
+amqp::internal::binding::
+Binder::decode (
+    std::string_view blob_,
+    ReaderCache & cache_,
+    const Limits & limits_
+) const {
+    if (blob_.size() > limits_.bytes) {
+        throw LimitExceeded ("blob exceeds its byte limit");
+    }
+
+    auto raw = RawEnvelope::locate (blob_);
+
+    if (!raw) {
+        throw std::runtime_error ("Not a blob we can decode");
+    }
+
+    const auto & section = cache_.section (raw->schema, raw->transforms, limits_);
+
+    std::unique_ptr<pn_data_t, decltype (&pn_data_free)> data (
+        pn_data (0), &pn_data_free);
+
+    auto rtn = pn_data_decode (data.get(), raw->value.data(), raw->value.size());
+
+    if (rtn < 0 || static_cast<std::size_t>(rtn) != raw->value.size()) {
+        throw std::runtime_error ("Failed to decode blob");
+    }
+
+    auto verified = Verifier::verify (data.get(), *section.verifier, limits_);
+
+    if (verified.status == DecodeStatus::LimitExceeded) {
+        throw LimitExceeded (verified.what);
+    } else if (!verified.ok()) {
+        throw std::runtime_error (
+            std::string ("Blob failed verification, ") + toString (verified.status)
+                + " at " + verified.path + ": " + verified.what);
+    }
+
+    Budget budget (limits_);
+    Budget::Scope scope (budget);
+    Budget::bytes (blob_.size());
+
+    pn_data_rewind (data.get());
+    pn_data_next (data.get());
+
+    return decode<T> (data.get(), section.factory, *section.schema);
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Writing values
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::binding {
+
+    template<class M>
+    constexpr const char * primitiveType() {
+        if constexpr (std::is_same_v<M, bool>) return "boolean";
+        else if constexpr (std::is_same_v<M, int8_t>) return "byte";
+        else if constexpr (std::is_same_v<M, uint8_t>) return "ubyte";
+        else if constexpr (std::is_same_v<M, int16_t>) return "short";
+        else if constexpr (std::is_same_v<M, uint16_t>) return "ushort";
+        else if constexpr (std::is_same_v<M, int32_t>) return "int";
+        else if constexpr (std::is_same_v<M, uint32_t>) return "uint";
+        else if constexpr (std::is_same_v<M, int64_t>) return "long";
+        else if constexpr (std::is_same_v<M, uint64_t>) return "ulong";
+        else if constexpr (std::is_same_v<M, float>) return "float";
+        else if constexpr (std::is_same_v<M, double>) return "double";
+        else if constexpr (std::is_same_v<M, Bytes>) return "binary";
+        else return "string";
+    }
+
+    template<class M>
+    const std::string & javaType();
+
+    /**
+     * The name of [M] as a type parameter, where Java only has the boxed
+     * primitives. The unsigned types have no Java class of their own so
+     * keep their AMQP names.
+     */
+    template<class M>
+    std::string
+    boxedType() {
+        if constexpr (isOptional<M>::value) return boxedType<typename M::value_type>();
+        else if constexpr (std::is_same_v<M, bool>) return "java.lang.Boolean";
+        else if constexpr (std::is_same_v<M, int8_t>) return "java.lang.Byte";
+        else if constexpr (std::is_same_v<M, int16_t>) return "java.lang.Short";
+        else if constexpr (std::is_same_v<M, int32_t>) return "java.lang.Integer";
+        else if constexpr (std::is_same_v<M, int64_t>) return "java.lang.Long";
+        else if constexpr (std::is_same_v<M, float>) return "java.lang.Float";
+        else if constexpr (std::is_same_v<M, double>) return "java.lang.Double";
+        else if constexpr (std::is_same_v<M, std::string>) return "java.lang.String";
+        else return javaType<M>();
+    }
+
+    /**
+     * The name the schema gives [M]
+     */
+    template<class M>
+    const std::string &
+    javaType() {
+        if constexpr (isOptional<M>::value) {
+            return javaType<typename M::value_type>();
+        } else if constexpr (isVector<M>::value) {
+            static const std::string type {
+                "java.util.List<" + boxedType<typename M::value_type>() + ">" };
+            return type;
+        } else if constexpr (isBound<M>::value) {
+            static const std::string type { Binding<M>::name() };
+            return type;
+        } else {
+            static const std::string type { primitiveType<M>() };
+            return type;
+        }
+    }
+
+    /**
+     * The descriptor of a bound struct, or a list, worked out from its
+     * shape the first time it's asked for
+     */
+    template<class M>
+    const std::string &
+    descriptorOf() {
+        static const std::string descriptor = [] {
+            std::string shape { javaType<M>() };
+
+            if constexpr (isVector<M>::value) {
+                shape += '\n' + describe<typename M::value_type> (nullptr).descriptor;
+            } else {
+                for (const auto & member : Binding<M>::members()) {
+                    auto field = member.describe (nullptr);
+
+                    shape += '\n';
+                    shape += member.name;
+                    for (const auto * part : {
+                        &field.type, &field.requires, &field.descriptor })
+                    {
+                        shape += ':' + *part;
+                    }
+                    shape += field.mandatory ? ":1" : ":0";
+                }
+            }
+
+            return encoding::fingerprint (shape);
+        }();
+
+        return descriptor;
+    }
+
+    /**
+     * Composites are the class name, lists are "*" requiring the list
+     * type and primitives have the default Java gives them
+     */
+    template<class M>
+    encoding::FieldSpec
+    describe (encoding::SchemaWriter * schema_) {
+        if constexpr (isOptional<M>::value) {
+            auto rtn = describe<typename M::value_type> (schema_);
+            rtn.defaultValue.clear();
+            rtn.mandatory = false;
+            return rtn;
+        } else if constexpr (isVector<M>::value) {
+            if (schema_ && !schema_->has (javaType<M>(), descriptorOf<M>())) {
+                describe<typename M::value_type> (schema_);
+                schema_->list (javaType<M>(), descriptorOf<M>());
+            }
+
+            return { "*", javaType<M>(), "", true, descriptorOf<M>() };
+        } else if constexpr (isBound<M>::value) {
+            if (schema_ && !schema_->has (javaType<M>(), descriptorOf<M>())) {
+                std::vector<std::pair<std::string, encoding::FieldSpec>> fields;
+                for (const auto & member : Binding<M>::members()) {
+                    fields.emplace_back (member.name, member.describe (schema_));
+                }
+
+                schema_->composite (javaType<M>(), descriptorOf<M>(), std::move (fields));
+            }
+
+            return { javaType<M>(), "", "", true, descriptorOf<M>() };
+        } else {
+            if constexpr (std::is_same_v<M, bool>) {
+                return { javaType<M>(), "", "false", true, "" };
+            } else if constexpr (std::is_arithmetic_v<M>) {
+                return { javaType<M>(), "", "0", true, "" };
+            } else {
+                return { javaType<M>(), "", "", true, "" };
+            }
+        }
+    }
+
+    /**
+     * Write [value_] at the cursor
+     */
+    template<class M>
+    void
+    put (pn_data_t * data_, const M & value_) {
+        if constexpr (isOptional<M>::value) {
+            if (value_) {
+                put (data_, *value_);
+            } else {
+                pn_data_put_null (data_);
+            }
+        } else if constexpr (isVector<M>::value || isBound<M>::value) {
+            const auto & descriptor = descriptorOf<M>();
+
+            pn_data_put_described (data_);
+            pn_data_enter (data_);
+            pn_data_put_symbol (data_, pn_bytes (descriptor.size(), descriptor.data()));
+            pn_data_put_list (data_);
+            pn_data_enter (data_);
+
+            if constexpr (isVector<M>::value) {
+                for (const auto & element : value_) {
+                    put (data_, element);
+                }
+            } else {
+                for (const auto & member : Binding<M>::members()) {
+                    member.put (data_, &value_);
+                }
+            }
+
+            pn_data_exit (data_);
+            pn_data_exit (data_);
+        }
+        else if constexpr (std::is_same_v<M, bool>) pn_data_put_bool (data_, value_);
+        else if constexpr (std::is_same_v<M, int8_t>) pn_data_put_byte (data_, value_);
+        else if constexpr (std::is_same_v<M, uint8_t>) pn_data_put_ubyte (data_, value_);
+        else if constexpr (std::is_same_v<M, int16_t>) pn_data_put_short (data_, value_);
+        else if constexpr (std::is_same_v<M, uint16_t>) pn_data_put_ushort (data_, value_);
+        else if constexpr (std::is_same_v<M, int32_t>) pn_data_put_int (data_, value_);
+        else if constexpr (std::is_same_v<M, uint32_t>) pn_data_put_uint (data_, value_);
+        else if constexpr (std::is_same_v<M, int64_t>) pn_data_put_long (data_, value_);
+        else if constexpr (std::is_same_v<M, uint64_t>) pn_data_put_ulong (data_, value_);
+        else if constexpr (std::is_same_v<M, float>) pn_data_put_float (data_, value_);
+        else if constexpr (std::is_same_v<M, double>) pn_data_put_double (data_, value_);
+        else if constexpr (std::is_same_v<M, Bytes>) {
+            pn_data_put_binary (data_, pn_bytes (
+                value_.size(), reinterpret_cast<const char *>(value_.data())));
+        }
+        else pn_data_put_string (data_, pn_bytes (value_.size(), value_.data()));
+    }
+
+    /**
+     * The schema and transforms sections of a blob holding a [T], the
+     * same for every one so built once per process and kept
+     */
+    template<class T>
+    const std::string &
+    sections() {
+        static_assert (isBound<T>::value, "Encoding needs an AMQP_BINDING");
+
+        static const std::string rtn = [] {
+            encoding::SchemaWriter schema;
+            describe<T> (&schema);
+
+            return schema.encode();
+        }();
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+template<class T, class M, M T::* member_>
+void
+amqp::internal::binding::
+putMember (pn_data_t * data_, const void * obj_) {
+    put (data_, static_cast<const T *>(obj_)->*member_);
+}
+
+/******************************************************************************/
@@ -0,0 +1,283 @@
+#include "Budget.h"
+
+#include <sstream>
+#include <algorithm>
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Reading the clock on every node would cost more than most of the
+     * nodes do, every this many is close enough
+     */
+    constexpr std::size_t CLOCK_INTERVAL { 1024 };
+
+    amqp::Limits
+    withDepth (amqp::Limits limits_, std::size_t depth_) {
+        limits_.depth = depth_;
+        return limits_;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::Budget
+ *
+ ******************************************************************************/
+
+thread_local amqp::internal::Budget *
+amqp::internal::Budget::s_current { nullptr };
+
+/******************************************************************************/
+
+amqp::internal::
+Budget::Budget (const Limits & limits_)
+    : m_limits (limits_)
+    , m_deadline (std::chrono::steady_clock::now() + limits_.time)
+{
+}
+
+/******************************************************************************/
+
+amqp::internal::
+Budget::Budget (const Share & share_)
+    : m_limits (withDepth (share_.m_pool->limits, share_.m_depth))
+    , m_deadline (share_.m_pool->deadline)
+    , m_pool (share_.m_pool)
+{
+}
+
+/******************************************************************************/
+
+/**
+ * A nested blob's own blobs go on sharing the outermost's pool, we only
+ * start one when it's the outermost's
+ */
+amqp::internal::Budget::Share
+amqp::internal::
+Budget::nested() const {
+    auto depth = m_limits.depth - std::min (m_limits.depth, m_depth + 1);
+
+    if (m_pool) {
+        return Share (m_pool, depth);
+    }
+
+    auto left = m_limits;
+    left.nodes -= std::min (m_limits.nodes, m_nodes);
+    left.bytes -= std::min (m_limits.bytes, m_bytes);
+
+    return Share (std::make_shared<Pool> (left, m_deadline), depth);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+Budget::exceeded (const char * what_) const {
+    std::stringstream ss;
+    ss << "blob exceeds its " << what_ << " limit";
+
+    throw LimitExceeded (ss.str());
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+Budget::checkTime() const {
+    if (m_limits.time.count() && std::chrono::steady_clock::now() > m_deadline) {
+        exceeded ("time");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+Budget::node() {
+    if (!s_current) {
+        return;
+    }
+
+    auto & budget = *s_current;
+
+    ++budget.m_nodes;
+
+    if (budget.m_pool
+        ? budget.m_pool->nodes.fetch_add (1, std::memory_order_relaxed)
+            >= budget.m_pool->limits.nodes
+        : budget.m_nodes > budget.m_limits.nodes
+    ) {
+        budget.exceeded ("node");
+    }
+
+    if (budget.m_nodes % CLOCK_INTERVAL == 0) {
+        budget.checkTime();
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+Budget::bytes (std::size_t bytes_) {
+    if (!s_current) {
+        return;
+    }
+
+    auto & budget = *s_current;
+
+    budget.m_bytes += bytes_;
+
+    if (budget.m_pool
+        ? budget.m_pool->bytes.fetch_add (bytes_, std::memory_order_relaxed)
+            + bytes_ > budget.m_pool->limits.bytes
+        : budget.m_bytes > budget.m_limits.bytes
+    ) {
+        budget.exceeded ("byte");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+Budget::elements (std::size_t elements_) {
+    if (!s_current) {
+        return;
+    }
+
+    auto & budget = *s_current;
+
+    auto used = budget.m_pool
+        ? budget.m_pool->nodes.load (std::memory_order_relaxed)
+        : budget.m_nodes;
+
+    if (elements_ > budget.m_limits.nodes - std::min (budget.m_limits.nodes, used)) {
+        budget.exceeded ("node");
+    }
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::Budget::Pool
+ *
+ ******************************************************************************/
+
+amqp::internal::
+Budget::Pool::Pool (
+    const Limits & limits_,
+    std::chrono::steady_clock::time_point deadline_
+) : limits (limits_)
+  , deadline (deadline_)
+{
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::Budget::Share
+ *
+ ******************************************************************************/
+
+amqp::internal::
+Budget::Share::Share (std::shared_ptr<Pool> pool_, std::size_t depth_)
+    : m_pool (std::move (pool_))
+    , m_depth (depth_)
+{
+}
+
+/******************************************************************************/
+
+std::size_t
+amqp::internal::
+Budget::Share::depth() const {
+    return m_depth;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::
+Budget::Share::expired() const {
+    return m_pool->limits.time.count()
+        && std::chrono::steady_clock::now() > m_pool->deadline;
+}
+
+/******************************************************************************/
+
+amqp::Limits
+amqp::internal::
+Budget::Share::limits() const {
+    auto rtn = withDepth (m_pool->limits, m_depth);
+
+    rtn.nodes -= std::min (rtn.nodes, m_pool->nodes.load (std::memory_order_relaxed));
+    rtn.bytes -= std::min (rtn.bytes, m_pool->bytes.load (std::memory_order_relaxed));
+
+    // no time left isn't the same as no deadline
+    if (rtn.time.count()) {
+        rtn.time = std::max (
+            std::chrono::milliseconds (1),
+            std::chrono::duration_cast<std::chrono::milliseconds> (
+                m_pool->deadline - std::chrono::steady_clock::now()));
+    }
+
+    return rtn;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::Budget::Scope
+ *
+ ******************************************************************************/
+
+amqp::internal::
+Budget::Scope::Scope (Budget & budget_)
+    : m_previous (s_current)
+{
+    s_current = &budget_;
+}
+
+/******************************************************************************/
+
+amqp::internal::
+Budget::Scope::~Scope() {
+    s_current = m_previous;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::Budget::Frame
+ *
+ ******************************************************************************/
+
+amqp::internal::
+Budget::Frame::Frame()
+    : m_budget (s_current)
+{
+    if (!m_budget) {
+        return;
+    }
+
+    // if either throws we're never constructed and so never destroyed,
+    // hence not taking the level until nothing else can go wrong
+    node();
+
+    if (m_budget->m_depth == m_budget->m_limits.depth) {
+        m_budget->exceeded ("depth");
+    }
+
+    ++m_budget->m_depth;
+}
+
+/******************************************************************************/
+
+amqp::internal::
+Budget::Frame::~Frame() {
+    if (m_budget) {
+        --m_budget->m_depth;
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,148 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstddef>
+
+#include "amqp/Limits.h"
+
+/******************************************************************************
+ *
+ * class Budget
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * What's left of a blob's [Limits] as we decode it.
+     *
+     * Rather than thread a budget through every reader's dump, and with
+     * it the public reader interface, whoever starts a decode installs one
+     * for the current thread with a [Scope] and the readers charge it as
+     * they go. With nothing installed the charges are free, so readers
+     * used on their own, as the tests do, behave as they always have.
+     *
+     * Running out throws [amqp::LimitExceeded].
+     */
+    class Budget {
+        private :
+            /**
+             * The nodes and bytes the blobs nested in one have between
+             * them, and when they must all be done by
+             */
+            struct Pool {
+                const Limits limits;
+                const std::chrono::steady_clock::time_point deadline;
+
+                std::atomic<std::size_t> nodes { 0 };
+                std::atomic<std::size_t> bytes { 0 };
+
+                Pool (const Limits &, std::chrono::steady_clock::time_point);
+            };
+
+            const Limits m_limits;
+
+            std::size_t m_depth { 0 };
+            std::size_t m_nodes { 0 };
+            std::size_t m_bytes { 0 };
+
+            std::chrono::steady_clock::time_point m_deadline;
+
+            /**
+             * Set if ours is a nested blob, our nodes and bytes are then
+             * charged to it rather than counted against our own limits
+             */
+            const std::shared_ptr<Pool> m_pool;
+
+            static thread_local Budget * s_current;
+
+            void exceeded (const char *) const;
+            void checkTime() const;
+
+        public :
+            /**
+             * What's left of a budget for the blobs nested in its blob.
+             * Those share it however many there are, and whichever
+             * threads decode them, rather than each having all of it,
+             * and each costs a level of depth, so however deep or wide
+             * blobs nest the whole still fits the outermost's limits.
+             */
+            class Share {
+                private :
+                    std::shared_ptr<Pool> m_pool;
+                    std::size_t m_depth;
+
+                    Share (std::shared_ptr<Pool>, std::size_t);
+
+                    friend class Budget;
+
+                public :
+                    std::size_t depth() const;
+
+                    /**
+                     * Whether the deadline has passed, once it has there's
+                     * no point starting on another blob
+                     */
+                    bool expired() const;
+
+                    /**
+                     * What's left right now, for anything checked before a
+                     * blob's [Budget] is charging us
+                     */
+                    Limits limits() const;
+            };
+
+            explicit Budget (const Limits &);
+
+            /**
+             * For a blob nested in another, charging [share_]
+             */
+            explicit Budget (const Share & share_);
+
+            Share nested() const;
+
+            /**
+             * Makes [budget_] the one charged by this thread until we're
+             * destroyed, putting back whichever was there before
+             */
+            class Scope {
+                private :
+                    Budget * m_previous;
+
+                public :
+                    explicit Scope (Budget & budget_);
+                    Scope (const Scope &) = delete;
+                    ~Scope();
+            };
+
+            /**
+             * One level of nesting, itself a node, for as long as it lives
+             */
+            class Frame {
+                private :
+                    Budget * m_budget;
+
+                public :
+                    Frame();
+                    Frame (const Frame &) = delete;
+                    ~Frame();
+            };
+
+            static void node();
+            static void bytes (std::size_t);
+
+            /**
+             * Check a container's element count, as read off the wire,
+             * against what's left before we iterate it or size anything
+             * by it
+             */
+            static void elements (std::size_t);
+    };
+
+}
+
+/******************************************************************************/
@@ -15,61 +15,61 @@
 
 #include "reader/Reader.h"
 #include "reader/CompositeReader.h"
+#include "reader/EvolvedCompositeReader.h"
 #include "reader/RestrictedReader.h"
 #include "reader/restricted-readers/MapReader.h"
 #include "reader/restricted-readers/ListReader.h"
 #include "reader/restricted-readers/ArrayReader.h"
 #include "reader/restricted-readers/EnumReader.h"
+#include "reader/well-known-readers/WellKnownReader.h"
 
 #include "schema/restricted-types/Map.h"
 #include "schema/restricted-types/List.h"
 #include "schema/restricted-types/Enum.h"
 #include "schema/restricted-types/Array.h"
 
-/******************************************************************************/
-
-namespace {
+/******************************************************************************
+ *
+ *  CompositeFactory
+ *
+ ******************************************************************************/
 
 /**
- *
+ * Return the reader for the type [k_], building it with [f_] and adding it
+ * to the table if it isn't already there.
  */
-    template<typename T>
-    std::shared_ptr<T> &
-    computeIfAbsent(
-            spStrMap_t<T> &map_,
-            const std::string &k_,
-            std::function<std::shared_ptr<T>(void)> f_
-    ) {
-        auto it = map_.find(k_);
-
-        if (it == map_.end()) {
-            DBG ("ComputeIfAbsent \"" << k_ << "\" - missing" << std::endl); // NOLINT
-            map_[k_] = std::move (f_());
-            DBG ("                \"" << k_ << "\" - RTN: " << map_[k_]->name() << " : " << map_[k_]->type()
-                                      << std::endl); // NOLINT
-            assert (map_[k_]);
-            assert (map_[k_] != nullptr);
-            DBG (k_ << " =?= " << map_[k_]->type() << std::endl);
-            assert (k_ == map_[k_]->type());
-
-            return map_[k_];
-        } else {
-            DBG ("ComputeIfAbsent \"" << k_ << "\" - found it" << std::endl); // NOLINT
-            DBG ("                \"" << k_ << "\" - RTN: " << map_[k_]->name() << std::endl); // NOLINT
-
-            assert (it->second != nullptr);
-
-            return it->second;
-        }
-    }
+const amqp::internal::reader::Reader *
+amqp::internal::
+CompositeFactory::computeIfAbsent (
+        const std::string & k_,
+        const std::function<uPtr<reader::Reader>(void)> & f_
+) {
+    auto it = m_readersByType.find (k_);
+
+    if (it == m_readersByType.end()) {
+        DBG ("ComputeIfAbsent \"" << k_ << "\" - missing" << std::endl); // NOLINT
 
+        auto reader = f_();
+
+        assert (reader);
+        DBG ("                \"" << k_ << "\" - RTN: " << reader->name() << " : " << reader->type()
+                                  << std::endl); // NOLINT
+        assert (k_ == reader->type());
+
+        m_readers.emplace_back (std::move (reader));
+        m_readersByType.emplace (k_, m_readers.size() - 1);
+
+        return m_readers.back().get();
+    } else {
+        DBG ("ComputeIfAbsent \"" << k_ << "\" - found it" << std::endl); // NOLINT
+
+        assert (m_readers[it->second]);
+
+        return m_readers[it->second].get();
+    }
 }
 
-/******************************************************************************
- *
- *  CompositeFactory
- *
- ******************************************************************************/
+/******************************************************************************/
 
 /**
  *
@@ -86,128 +86,262 @@ amqp::internal::
 CompositeFactory::process (const SchemaType & schema_) {
     DBG ("process schema" << std::endl);
 
-    for (const auto & i : dynamic_cast<const schema::Schema &>(schema_)) {
-        for (const auto & j : i) {
-            process (*j);
-            m_readersByDescriptor[j->descriptor()] = m_readersByType[j->name()];
-        }
+    for (const auto & type : dynamic_cast<const schema::Schema &>(schema_)) {
+        build (type);
     }
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::Reader>
+const amqp::internal::reader::Reader *
+amqp::internal::
+CompositeFactory::build (const schema::TypeNotation & type_) {
+    auto reader = process (type_);
+    m_readersByDescriptor[type_.descriptor()] = m_readersByType.at (type_.name());
+
+    return reader;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::
+CompositeFactory::describes (const std::string & type_) const {
+    return m_readersByType.find (type_) != m_readersByType.end();
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::
+CompositeFactory::missing (const std::string &) {
+    throw std::runtime_error ("Missing type in map");
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
 amqp::internal::
 CompositeFactory::process (
-    const amqp::internal::schema::AMQPTypeNotation & schema_)
+    const amqp::internal::schema::TypeNotation & schema_)
 {
     DBG ("process::" << schema_.name() << std::endl);
 
-    return computeIfAbsent<reader::Reader> (
-        m_readersByType,
+    return computeIfAbsent (
         schema_.name(),
-        [& schema_, this] () -> std::shared_ptr<reader::Reader> {
-            switch (schema_.type()) {
-                case schema::AMQPTypeNotation::composite_t : {
-                    return processComposite (schema_);
-                }
-                case schema::AMQPTypeNotation::restricted_t : {
-                    return processRestricted (schema_);
-                }
+        [& schema_, this] () -> uPtr<reader::Reader> {
+            if (auto reader = reader::WellKnownReader::make (schema_.name())) {
+                return reader;
             }
+
+            return schema_.visit (overloaded {
+                [this](const schema::Composite & type_) {
+                    return processComposite (type_);
+                },
+                [this](const schema::List & type_) {
+                    return processList (type_);
+                },
+                [this](const schema::Map & type_) {
+                    return processMap (type_);
+                },
+                [this](const schema::Array & type_) {
+                    return processArray (type_);
+                },
+                [this](const schema::Enum & type_) {
+                    return processEnum (type_);
+                }
+            });
         });
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::Reader>
+uPtr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::processComposite (
-        const amqp::internal::schema::AMQPTypeNotation & type_
+        const amqp::internal::schema::Composite & type_
 ) {
     DBG ("processComposite - " << type_.name() << std::endl);
-    std::vector<std::weak_ptr<reader::Reader>> readers;
+    std::vector<const reader::Reader *> readers;
+    std::vector<std::string> fieldNames;
 
-    const auto & fields = dynamic_cast<const schema::Composite &> (
-            type_).fields();
+    const auto & fields = type_.fields();
 
     readers.reserve (fields.size());
+    fieldNames.reserve (fields.size());
 
     for (const auto & field : fields) {
         DBG ("  Field: " << field->name() << ": \"" << field->type()
             << "\" {" << field->resolvedType() << "} "
             << field->fieldType() << std::endl); // NOLINT
 
-       decltype (m_readersByType)::mapped_type reader;
+        const reader::Reader * reader;
 
         if (field->primitive()) {
-            reader = computeIfAbsent<reader::Reader> (
-                    m_readersByType,
+            reader = computeIfAbsent (
                     field->resolvedType(),
-                    [&field]() -> std::shared_ptr<reader::PropertyReader> {
-                        return reader::PropertyReader::make (field);
+                    [this, &field]() -> uPtr<reader::Reader> {
+                        return reader::PropertyReader::make (field, m_validation);
                     });
         }
+        else if (field->type() == "*"
+            && !describes (field->resolvedType())
+            && !reader::WellKnownReader::isWellKnown (field->resolvedType()))
+        {
+            // An interface or abstract type the schema doesn't describe,
+            // we'll only know what we're reading when we see it
+            reader = processPolymorphic (*field);
+        }
         else {
             // Insertion sorting ensures any type we depend on will have
-            // already been created and thus exist in the map
-            reader = m_readersByType[field->resolvedType()];
+            // already been created and thus exist in the table, or if
+            // we're building lazily [missing] will build it now
+            reader = fetchReader (field->resolvedType());
         }
 
-
         assert (reader);
         readers.emplace_back (reader);
-        assert (readers.back().lock());
+        fieldNames.emplace_back (field->name());
     }
 
-    return std::make_shared<reader::CompositeReader> (type_.name(), readers);
+    if (m_evolution) {
+        if (auto layout = m_evolution->layout (type_)) {
+            return make<reader::EvolvedCompositeReader> (
+                    type_.name(),
+                    type_.descriptor(),
+                    std::move (fieldNames),
+                    std::move (readers),
+                    *layout);
+        }
+    }
+
+    return make<reader::CompositeReader> (
+            type_.name(),
+            type_.descriptor(),
+            std::move (fieldNames),
+            std::move (readers));
+}
+
+/******************************************************************************/
+
+/**
+ * Every "*" field gets its own reader so each site has its own cache of
+ * the types seen there. They aren't indexed by type as there is nothing
+ * to share.
+ *
+ * A boxed primitive can turn up in any such field so make sure there's
+ * a reader for each of those, that way the table never needs to change
+ * once we start decoding.
+ */
+const amqp::internal::reader::Reader *
+amqp::internal::
+CompositeFactory::processPolymorphic (const schema::Field & field_) {
+    DBG ("processPolymorphic - " << field_.name() << ": "
+        << field_.resolvedType() << std::endl); // NOLINT
+
+    for (const auto & type : reader::PropertyReader::primitives()) {
+        computeIfAbsent (
+            type,
+            [this, & type]() -> uPtr<reader::Reader> {
+                return reader::PropertyReader::make (type, m_validation);
+            });
+    }
+
+    m_readers.emplace_back (
+        std::make_unique<reader::PolymorphicReader> (
+            static_cast<const reader::PolymorphicReader::Resolver &>(*this)));
+
+    return m_readers.back().get();
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::
+CompositeFactory::resolveDescriptor (std::string_view descriptor_) const {
+    auto it = m_readersByDescriptor.find (descriptor_);
+
+    return (it == m_readersByDescriptor.end()) ? nullptr : m_readers[it->second].get();
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::
+CompositeFactory::resolveType (const std::string & type_) const {
+    auto it = m_readersByType.find (type_);
+
+    return (it == m_readersByType.end()) ? nullptr : m_readers[it->second].get();
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::Reader>
+uPtr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::processEnum (
     const amqp::internal::schema::Enum & enum_
 ) {
     DBG ("Processing Enum - " << enum_.name() << std::endl); // NOLINT
 
-    return std::make_shared<reader::EnumReader> (
+    if (m_evolution) {
+        static const schema::Transforms none;
+
+        auto constants = m_evolution->constants (
+            enum_, m_transforms ? *m_transforms : none);
+
+        if (constants) {
+            return make<reader::EnumReader> (
+                enum_.name(),
+                enum_.descriptor(),
+                enum_.makeChoices(),
+                *constants);
+        }
+    }
+
+    return make<reader::EnumReader> (
         enum_.name(),
+        enum_.descriptor(),
         enum_.makeChoices());
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::Reader>
+const amqp::internal::reader::Reader *
 amqp::internal::
-CompositeFactory::fetchReaderForRestricted (const std::string & type_) {
-    decltype(m_readersByType)::mapped_type rtn;
-
-    DBG ("fetchReaderForRestricted - " << type_ << std::endl);
+CompositeFactory::fetchReader (const std::string & type_) {
+    DBG ("fetchReader - " << type_ << std::endl);
 
     if (schema::Field::typeIsPrimitive(type_)) {
         DBG ("It's primitive" << std::endl);
-        rtn = computeIfAbsent<reader::Reader>(
-                m_readersByType,
+        return computeIfAbsent (
                 type_,
-                [& type_]() -> std::shared_ptr<reader::PropertyReader> {
-                    return reader::PropertyReader::make (type_);
+                [this, & type_]() -> uPtr<reader::Reader> {
+                    return reader::PropertyReader::make (type_, m_validation);
                 });
-    } else {
-        rtn = m_readersByType[type_];
     }
 
-    if (!rtn) {
-        throw std::runtime_error ("Missing type in map");
+    // Not necessarily in the schema, see RestrictedDescriptor::build
+    if (reader::WellKnownReader::isWellKnown (type_)) {
+        DBG ("It's well known" << std::endl);
+        return computeIfAbsent (
+                type_,
+                [& type_]() -> uPtr<reader::Reader> {
+                    return reader::WellKnownReader::make (type_);
+                });
+    }
+
+    auto it = m_readersByType.find (type_);
+
+    if (it == m_readersByType.end()) {
+        return missing (type_);
     }
 
-    return rtn;
+    return m_readers[it->second].get();
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::Reader>
+uPtr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::processMap (
     const amqp::internal::schema::Map & map_
@@ -218,93 +352,61 @@ CompositeFactory::processMap (
 
     const auto types = map_.mapOf();
 
-    return std::make_shared<reader::MapReader> (
+    return make<reader::MapReader> (
             map_.name(),
-            fetchReaderForRestricted (types.first),
-            fetchReaderForRestricted (types.second));
+            map_.descriptor(),
+            fetchReader (types.first),
+            fetchReader (types.second));
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::Reader>
+uPtr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::processList (
     const amqp::internal::schema::List & list_
 ) {
     DBG ("Processing List - " << list_.listOf() << std::endl); // NOLINT
 
-    return std::make_shared<reader::ListReader> (
+    return make<reader::ListReader> (
             list_.name(),
-            fetchReaderForRestricted (list_.listOf()));
+            list_.descriptor(),
+            fetchReader (list_.listOf()));
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::Reader>
+uPtr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::processArray (
         const amqp::internal::schema::Array & array_
 ) {
     DBG ("Processing Array - " << array_.name() << " " << array_.arrayOf() << std::endl); // NOLINT
 
-    return std::make_shared<reader::ArrayReader> (
+    return make<reader::ArrayReader> (
             array_.name(),
-            fetchReaderForRestricted (array_.arrayOf()));
-}
-
-/******************************************************************************/
-
-std::shared_ptr<amqp::internal::reader::Reader>
-amqp::internal::
-CompositeFactory::processRestricted (
-        const amqp::internal::schema::AMQPTypeNotation & type_)
-{
-    DBG ("processRestricted - " << type_.name() << std::endl); // NOLINT
-    const auto & restricted = dynamic_cast<const schema::Restricted &> (
-            type_);
-
-    switch (restricted.restrictedType()) {
-        case schema::Restricted::RestrictedTypes::list_t : {
-            return processList (
-                dynamic_cast<const schema::List &> (restricted));
-        }
-        case schema::Restricted::RestrictedTypes::enum_t : {
-            return processEnum (
-                dynamic_cast<const schema::Enum &> (restricted));
-        }
-        case schema::Restricted::RestrictedTypes::map_t : {
-            return processMap (
-                dynamic_cast<const schema::Map &> (restricted));
-        }
-        case schema::Restricted::RestrictedTypes::array_t : {
-            DBG ("  array_t" << std::endl);
-            return processArray (
-                dynamic_cast<const schema::Array &> (restricted));
-        }
-    }
-
-    DBG ("  ProcessRestricted: Returning nullptr"); // NOLINT
-    return nullptr;
+            array_.descriptor(),
+            fetchReader (array_.arrayOf()));
 }
 
 /******************************************************************************/
 
-const std::shared_ptr<amqp::internal::reader::IReader>
+const amqp::internal::reader::IReader *
 amqp::internal::
-CompositeFactory::byType (const std::string & type_) {
+CompositeFactory::byType (const std::string & type_) const {
     auto it = m_readersByType.find (type_);
 
-    return (it == m_readersByType.end()) ? nullptr : it->second;
+    return (it == m_readersByType.end()) ? nullptr : m_readers[it->second].get();
 }
 
 /******************************************************************************/
 
-const std::shared_ptr<amqp::internal::reader::IReader>
+const amqp::internal::reader::IReader *
 amqp::internal::
-CompositeFactory::byDescriptor (const std::string & descriptor_) {
+CompositeFactory::byDescriptor (const std::string & descriptor_) const {
     auto it = m_readersByDescriptor.find (descriptor_);
 
-    return (it == m_readersByDescriptor.end()) ? nullptr : it->second;
+    return (it == m_readersByDescriptor.end()) ? nullptr : m_readers[it->second].get();
 }
 
 /******************************************************************************/
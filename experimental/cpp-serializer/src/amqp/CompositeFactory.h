@@ -4,15 +4,22 @@
 
 #include <map>
 #include <set>
+#include <vector>
 #include <memory>
+#include <functional>
 
 #include "types.h"
 
+#include "amqp/Evolution.h"
+#include "amqp/Validation.h"
 #include "amqp/ICompositeFactory.h"
+#include "amqp/schema/TypeNotation.h"
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/schema/described-types/Envelope.h"
 #include "amqp/schema/described-types/Composite.h"
+#include "amqp/reader/Policy.h"
 #include "amqp/reader/CompositeReader.h"
+#include "amqp/reader/PolymorphicReader.h"
 #include "amqp/schema/restricted-types/Map.h"
 #include "amqp/schema/restricted-types/Array.h"
 #include "amqp/schema/restricted-types/List.h"
@@ -22,51 +29,137 @@
 
 namespace amqp::internal {
 
+    /**
+     * See [ICompositeFactory] for what may be done from which threads. The
+     * polymorphic readers we hand out resolve types through us at decode
+     * time, hence those lookups being const as well.
+     */
     class CompositeFactory
         : public ICompositeFactory<schema::SchemaMap::const_iterator>
+        , private reader::PolymorphicReader::Resolver
     {
         private :
             using CompositePtr = uPtr<schema::Composite>;
             using EnvelopePtr  = uPtr<schema::Envelope>;
 
-            spStrMap_t<reader::Reader> m_readersByType;
-            spStrMap_t<reader::Reader> m_readersByDescriptor;
+            /**
+             * Every reader the factory has built, indexed by type id. Owns
+             * the readers, which refer to one another by raw pointer, so
+             * entries must never be removed or replaced.
+             */
+            std::vector<uPtr<reader::Reader>> m_readers;
+
+            std::map<std::string, std::size_t> m_readersByType;
+            std::map<std::string, std::size_t, std::less<>> m_readersByDescriptor;
+
+            const Validation m_validation;
+
+            /**
+             * The types we expect blobs to be read as, nullptr to read
+             * them as written, and the transforms of the blob whose
+             * schema we're processing. Neither is owned, the transforms
+             * are only looked at as readers are built.
+             */
+            const Evolution * m_evolution;
+            const schema::Transforms * m_transforms;
 
         public :
-            CompositeFactory() = default;
+            explicit CompositeFactory (
+                Validation validation_ = Validation::Strict,
+                const Evolution * evolution_ = nullptr,
+                const schema::Transforms * transforms_ = nullptr
+            ) : m_validation (validation_)
+              , m_evolution (evolution_)
+              , m_transforms (transforms_)
+            { }
+
+            /**
+             * Polymorphic readers hold on to the factory that built them
+             */
+            CompositeFactory (const CompositeFactory &) = delete;
+            CompositeFactory (CompositeFactory &&) = delete;
 
             void process (const SchemaType &) override;
 
-            const std::shared_ptr<ReaderType> byType (
-                    const std::string &) override;
+            const ReaderType * byType (const std::string &) const override;
 
-            const std::shared_ptr<ReaderType> byDescriptor (
-                    const std::string &) override;
+            const ReaderType * byDescriptor (const std::string &) const override;
 
-        private :
-            std::shared_ptr<reader::Reader> process (
-                    const schema::AMQPTypeNotation &);
+            /**
+             * How many readers we've built
+             */
+            std::size_t size() const { return m_readers.size(); }
 
-            std::shared_ptr<reader::Reader> processComposite (
-                    const schema::AMQPTypeNotation &);
+        protected :
+            /**
+             * Build the reader for [type_], along with any it depends on
+             * that [missing] can find, and index it by descriptor
+             */
+            const reader::Reader * build (const schema::TypeNotation & type_);
 
-            std::shared_ptr<reader::Reader> processRestricted (
-                    const schema::AMQPTypeNotation &);
+            /**
+             * Whether [type_] is one the schema describes. Ours are all
+             * built up front so that means whether we have a reader.
+             */
+            virtual bool describes (const std::string & type_) const;
 
-            std::shared_ptr<reader::Reader> processList (
+            /**
+             * Called for a type we've been asked to build a reader
+             * against but don't yet have. Schemas are processed in
+             * dependency order so for us that's a malformed schema.
+             */
+            virtual const reader::Reader * missing (const std::string & type_);
+
+            const reader::Reader * resolveDescriptor (
+                    std::string_view) const override;
+
+            const reader::Reader * resolveType (
+                    const std::string &) const override;
+
+        private :
+            /**
+             * Build a reader of the given kind instantiated for our
+             * validation policy, the only place the policy is looked at
+             * rather than compiled in
+             */
+            template<template<class> class R, typename... Args>
+            uPtr<reader::Reader> make (Args &&... args_) const {
+                if (m_validation == Validation::Trusted) {
+                    return std::make_unique<R<reader::Trusted>> (
+                            std::forward<Args> (args_)...);
+                }
+
+                return std::make_unique<R<reader::Strict>> (
+                        std::forward<Args> (args_)...);
+            }
+
+            const reader::Reader * computeIfAbsent (
+                    const std::string &,
+                    const std::function<uPtr<reader::Reader>(void)> &);
+
+            const reader::Reader * process (
+                    const schema::TypeNotation &);
+
+            uPtr<reader::Reader> processComposite (
+                    const schema::Composite &);
+
+            const reader::Reader * processPolymorphic (
+                    const schema::Field &);
+
+            uPtr<reader::Reader> processList (
                     const schema::List &);
 
-            std::shared_ptr<reader::Reader> processEnum (
+            uPtr<reader::Reader> processEnum (
                     const schema::Enum &);
 
-            std::shared_ptr<reader::Reader> processMap (
+            uPtr<reader::Reader> processMap (
                     const schema::Map &);
 
-            std::shared_ptr<reader::Reader> processArray (
+            uPtr<reader::Reader> processArray (
                     const schema::Array &);
 
-            decltype(m_readersByType)::mapped_type
-            fetchReaderForRestricted (const std::string &);
+            const reader::Reader * fetchReader (
+                    const std::string &);
     };
 
 }
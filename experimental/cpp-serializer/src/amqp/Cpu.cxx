@@ -0,0 +1,131 @@
+#include "Cpu.h"
+
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef AMQP_X86
+#include <cpuid.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+#ifdef AMQP_X86
+
+    /**
+     * Not every compiler we build with knows to ask for the SHA extensions
+     * by name so they're read straight off CPUID, they're only of any use
+     * alongside SSE4.1
+     */
+    bool
+    hasSHANI() {
+        unsigned a, b, c, d;
+
+        if (!__get_cpuid (1, &a, &b, &c, &d) || !(c & bit_SSE4_1)) {
+            return false;
+        }
+
+        return __get_cpuid_count (7, 0, &a, &b, &c, &d) && (b & bit_SHA);
+    }
+
+#endif
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::cpu
+ *
+ ******************************************************************************/
+
+const char *
+amqp::internal::cpu::
+toString (Engine engine_) {
+    switch (engine_) {
+        case Engine::Best   : return "best";
+        case Engine::Scalar : return "scalar";
+        case Engine::SSE2   : return "sse2";
+        case Engine::SSSE3  : return "ssse3";
+        case Engine::SHANI  : return "shani";
+        case Engine::AVX2   : return "avx2";
+    }
+
+    return "unknown";
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::cpu::
+supported (Engine engine_) {
+#ifdef AMQP_X86
+    static const bool sse2 = __builtin_cpu_supports ("sse2");
+    static const bool ssse3 = __builtin_cpu_supports ("ssse3");
+    static const bool shani = hasSHANI();
+    static const bool avx2 = __builtin_cpu_supports ("avx2");
+
+    switch (engine_) {
+        case Engine::SSE2  : return sse2;
+        case Engine::SSSE3 : return ssse3;
+        case Engine::SHANI : return shani;
+        case Engine::AVX2  : return avx2;
+        default : return true;
+    }
+#else
+    return engine_ == Engine::Best || engine_ == Engine::Scalar;
+#endif
+}
+
+/******************************************************************************/
+
+amqp::internal::cpu::Engine
+amqp::internal::cpu::
+best (Kernels kernels_) {
+    for (auto kernel : kernels_) {
+        if (supported (kernel)) {
+            return kernel;
+        }
+    }
+
+    return Engine::Scalar;
+}
+
+/******************************************************************************/
+
+amqp::internal::cpu::Engine
+amqp::internal::cpu::
+resolve (Engine engine_, Kernels kernels_, const char * what_) {
+    if (engine_ == Engine::Best) {
+        return best (kernels_);
+    }
+
+    if (engine_ != Engine::Scalar
+        && (std::find (kernels_.begin(), kernels_.end(), engine_) == kernels_.end()
+            || !supported (engine_))
+    ) {
+        throw std::runtime_error (
+            std::string (what_) + " engine " + toString (engine_) + " not supported here");
+    }
+
+    return engine_;
+}
+
+/******************************************************************************/
+
+std::vector<amqp::internal::cpu::Engine>
+amqp::internal::cpu::
+available (Kernels kernels_) {
+    std::vector<Engine> rtn { Engine::Best, Engine::Scalar };
+
+    for (auto kernel : kernels_) {
+        if (supported (kernel)) {
+            rtn.push_back (kernel);
+        }
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
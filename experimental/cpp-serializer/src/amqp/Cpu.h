@@ -0,0 +1,71 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+#include <initializer_list>
+
+/******************************************************************************/
+
+/*
+ * Where we can build the vector kernels at all. Each is compiled for its
+ * own target so the rest of the build needn't assume any of them, and is
+ * only ever run on a CPU that has it.
+ */
+#if (defined (__x86_64__) || defined (__i386__)) && defined (__GNUC__)
+#define AMQP_X86
+#endif
+
+/******************************************************************************
+ *
+ * CPU feature detection
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::cpu {
+
+    /**
+     * What does the work in those modules with vector kernels, hashing,
+     * JSON escaping and binary encoding. [Best] picks, once, the fastest
+     * a module has for this CPU, the rest are there so each can be checked
+     * and timed against the others. No module has a kernel for every one.
+     */
+    enum class Engine { Best, Scalar, SSE2, SSSE3, SHANI, AVX2 };
+
+    /**
+     * A module's vector kernels, fastest first, the scalar one it always
+     * has being left out
+     */
+    using Kernels = std::initializer_list<Engine>;
+
+    const char * toString (Engine);
+
+    /**
+     * Whether this CPU has the instructions [engine_] needs, each only
+     * asked for once
+     */
+    bool supported (Engine engine_);
+
+    /**
+     * The first of [kernels_] this CPU has, Scalar if none
+     */
+    Engine best (Kernels kernels_);
+
+    /**
+     * What [engine_] means for a module with [kernels_], [what_] naming
+     * it should it be one the module hasn't a kernel for or the CPU can't
+     * run
+     *
+     * @throws std::runtime_error if it is
+     */
+    Engine resolve (Engine engine_, Kernels kernels_, const char * what_);
+
+    /**
+     * Best, Scalar and each of [kernels_] this CPU has, everything worth
+     * testing or timing a module with
+     */
+    std::vector<Engine> available (Kernels kernels_);
+
+}
+
+/******************************************************************************/
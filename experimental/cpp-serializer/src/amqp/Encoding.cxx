@@ -0,0 +1,286 @@
+#include "Encoding.h"
+
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
+
+#include <proton/codec.h>
+
+#include "amqp/Hash.h"
+#include "amqp/Binary.h"
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/schema/Descriptors.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using Data = std::unique_ptr<pn_data_t, decltype (&pn_data_free)>;
+
+    uint64_t
+    id (int descriptor_) {
+        return static_cast<uint64_t>(descriptor_)
+            | amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS;
+    }
+
+    pn_bytes_t
+    bytes (const std::string & string_) {
+        return pn_bytes (string_.size(), string_.data());
+    }
+
+    /**
+     * Puts a described list and leaves us inside the list
+     */
+    void
+    described (pn_data_t * data_, int descriptor_) {
+        pn_data_put_described (data_);
+        pn_data_enter (data_);
+        pn_data_put_ulong (data_, id (descriptor_));
+        pn_data_put_list (data_);
+        pn_data_enter (data_);
+    }
+
+    void
+    exitDescribed (pn_data_t * data_) {
+        pn_data_exit (data_);
+        pn_data_exit (data_);
+    }
+
+    void
+    descriptor (pn_data_t * data_, const std::string & symbol_) {
+        described (data_, amqp::schema::descriptors::OBJECT);
+        pn_data_put_symbol (data_, bytes (symbol_));
+        pn_data_put_null (data_);
+        exitDescribed (data_);
+    }
+
+    void
+    field (
+        pn_data_t * data_,
+        const std::string & name_,
+        const amqp::internal::encoding::FieldSpec & field_
+    ) {
+        described (data_, amqp::schema::descriptors::FIELD);
+
+        pn_data_put_string (data_, bytes (name_));
+        pn_data_put_string (data_, bytes (field_.type));
+
+        pn_data_put_list (data_);
+        if (!field_.requires.empty()) {
+            pn_data_enter (data_);
+            pn_data_put_string (data_, bytes (field_.requires));
+            pn_data_exit (data_);
+        }
+
+        if (field_.defaultValue.empty()) {
+            pn_data_put_null (data_);
+        } else {
+            pn_data_put_string (data_, bytes (field_.defaultValue));
+        }
+
+        pn_data_put_null (data_);
+        pn_data_put_bool (data_, field_.mandatory);
+        pn_data_put_bool (data_, false);
+
+        exitDescribed (data_);
+    }
+
+    /******************************************************************************/
+
+    template<class T>
+    void
+    bigEndian (std::string & out_, T value_) {
+        for (int i = sizeof (T) - 1 ; i >= 0 ; --i) {
+            out_ += static_cast<char>((value_ >> (8U * i)) & 0xffU);
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::encoding::SchemaWriter
+ *
+ ******************************************************************************/
+
+bool
+amqp::internal::encoding::
+SchemaWriter::has (
+    const std::string & name_,
+    const std::string & descriptor_
+) const {
+    auto it = m_descriptors.find (name_);
+
+    if (it == m_descriptors.end()) {
+        return false;
+    }
+
+    if (it->second != descriptor_) {
+        throw std::runtime_error (
+            "Type " + name_ + " is bound to more than one shape");
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoding::
+SchemaWriter::composite (
+    std::string name_,
+    std::string descriptor_,
+    std::vector<std::pair<std::string, FieldSpec>> fields_
+) {
+    if (!has (name_, descriptor_)) {
+        m_descriptors.emplace (name_, descriptor_);
+        m_types.push_back (Type {
+            std::move (name_), std::move (descriptor_), true, std::move (fields_) });
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoding::
+SchemaWriter::list (std::string name_, std::string descriptor_) {
+    if (!has (name_, descriptor_)) {
+        m_descriptors.emplace (name_, descriptor_);
+        m_types.push_back (Type {
+            std::move (name_), std::move (descriptor_), false, { } });
+    }
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::encoding::
+SchemaWriter::encode() const {
+    using namespace amqp::schema::descriptors;
+
+    std::string rtn;
+    Data data (pn_data (0), &pn_data_free);
+
+    described (data.get(), SCHEMA);
+    pn_data_put_list (data.get());
+    pn_data_enter (data.get());
+
+    for (const auto & type : m_types) {
+        if (type.composite) {
+            described (data.get(), COMPOSITE_TYPE);
+
+            pn_data_put_string (data.get(), bytes (type.name));
+            pn_data_put_null (data.get());
+            pn_data_put_list (data.get());
+            descriptor (data.get(), type.descriptor);
+
+            pn_data_put_list (data.get());
+            pn_data_enter (data.get());
+            for (const auto & [ name, spec ] : type.fields) {
+                field (data.get(), name, spec);
+            }
+            pn_data_exit (data.get());
+        } else {
+            described (data.get(), RESTRICTED_TYPE);
+
+            pn_data_put_string (data.get(), bytes (type.name));
+            pn_data_put_null (data.get());
+            pn_data_put_list (data.get());
+            pn_data_put_string (data.get(), bytes (std::string ("list")));
+            descriptor (data.get(), type.descriptor);
+            pn_data_put_list (data.get());
+        }
+
+        exitDescribed (data.get());
+    }
+
+    pn_data_exit (data.get());
+    exitDescribed (data.get());
+
+    encoding::encode (data.get(), rtn);
+
+    // no transforms, just the empty map of them
+    pn_data_clear (data.get());
+    pn_data_put_described (data.get());
+    pn_data_enter (data.get());
+    pn_data_put_ulong (data.get(), id (TRANSFORM_SCHEMA));
+    pn_data_put_map (data.get());
+    pn_data_exit (data.get());
+
+    encoding::encode (data.get(), rtn);
+
+    return rtn;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::encoding
+ *
+ ******************************************************************************/
+
+std::string
+amqp::internal::encoding::
+fingerprint (std::string_view shape_) {
+    std::string hash;
+    bigEndian (hash, xxh64 (shape_, 0));
+    bigEndian (hash, xxh64 (shape_, 1));
+
+    std::string rtn { "net.corda:" };
+    binary::base64 (hash, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoding::
+encode (pn_data_t * data_, std::string & out_) {
+    auto size = pn_data_encoded_size (data_);
+
+    if (size < 0) {
+        throw std::runtime_error ("Can't encode value");
+    }
+
+    auto offset = out_.size();
+    out_.resize (offset + size);
+
+    if (pn_data_encode (data_, out_.data() + offset, size) != size) {
+        throw std::runtime_error ("Can't encode value");
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * The envelope is a described list of three, the value, the schema and
+ * the transforms, whose size we know up front so we always write it with
+ * the four byte size and count
+ */
+void
+amqp::internal::encoding::
+envelope (
+    std::string & out_,
+    std::string_view value_,
+    std::string_view sections_
+) {
+    out_.reserve (out_.size() + amqp::AMQP_HEADER.size() + 20
+        + value_.size() + sections_.size());
+
+    out_.append (amqp::AMQP_HEADER.data(), amqp::AMQP_HEADER.size());
+    out_ += static_cast<char>(amqp::DATA_AND_STOP);
+
+    out_ += '\x00';
+    out_ += '\x80';
+    bigEndian (out_, id (amqp::schema::descriptors::ENVELOPE));
+
+    out_ += '\xd0';
+    bigEndian (out_, static_cast<uint32_t>(4 + value_.size() + sections_.size()));
+    bigEndian (out_, uint32_t { 3 });
+
+    out_.append (value_);
+    out_.append (sections_);
+}
+
+/******************************************************************************/
@@ -0,0 +1,114 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+#include <string_view>
+
+/******************************************************************************/
+
+struct pn_data_t;
+
+/******************************************************************************
+ *
+ * Writing Corda blobs
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::encoding {
+
+    /**
+     * How a field is described in the schema
+     */
+    struct FieldSpec {
+        std::string type;
+
+        /**
+         * Only set for the "*" typed fields that hold restricted types
+         */
+        std::string requires;
+
+        std::string defaultValue;
+        bool        mandatory;
+
+        /**
+         * Of the field's type, if it's one that has one
+         */
+        std::string descriptor;
+    };
+
+    /**
+     * Collects the types a blob's schema section is to describe and
+     * encodes them, along with an empty transforms section
+     */
+    class SchemaWriter {
+        private :
+            struct Type {
+                std::string name;
+                std::string descriptor;
+                bool        composite;
+
+                std::vector<std::pair<std::string, FieldSpec>> fields;
+            };
+
+            std::vector<Type> m_types;
+
+            /**
+             * The descriptor, and so the shape, of each type by name
+             */
+            std::map<std::string, std::string> m_descriptors;
+
+        public :
+            /**
+             * Whether we're already describing a type of that name
+             *
+             * @throws std::runtime_error if we are but with a different
+             * [descriptor_], two shapes bound to the one Java class
+             */
+            bool has (
+                const std::string & name_,
+                const std::string & descriptor_) const;
+
+            void composite (
+                std::string name_,
+                std::string descriptor_,
+                std::vector<std::pair<std::string, FieldSpec>> fields_);
+
+            void list (std::string name_, std::string descriptor_);
+
+            /**
+             * The schema and transforms sections, as they follow a value
+             * in the envelope
+             */
+            std::string encode() const;
+    };
+
+    /**
+     * "net.corda:" and the base64 of 128 bits hashed from [shape_].
+     *
+     * Not Corda's own fingerprinting, which hashes the JVM's view of a
+     * type, but as deterministic, so the same shape always has the same
+     * descriptor and a changed one a different descriptor.
+     */
+    std::string fingerprint (std::string_view shape_);
+
+    /**
+     * Append whatever's been put into [data_] to [out_]
+     */
+    void encode (pn_data_t * data_, std::string & out_);
+
+    /**
+     * Append to [out_] a whole blob, header and all, made of an encoded
+     * [value_] followed by [sections_], the schema and transforms
+     */
+    void envelope (
+        std::string & out_,
+        std::string_view value_,
+        std::string_view sections_);
+
+}
+
+/******************************************************************************/
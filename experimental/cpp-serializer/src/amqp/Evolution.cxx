@@ -0,0 +1,280 @@
+#include "Evolution.h"
+
+#include <set>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+
+#include "debug.h"
+
+#include "amqp/RawEnvelope.h"
+#include "amqp/schema/field-types/Field.h"
+#include "amqp/schema/descriptors/AMQPDescriptors.h"
+
+/******************************************************************************/
+
+namespace {
+
+    template<class T>
+    const T *
+    as (const amqp::internal::schema::TypeNotation & type_) {
+        return type_.visit (overloaded {
+            [](const T & t_) { return &t_; },
+            [](const auto &) -> const T * { return nullptr; }
+        });
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::Evolution
+ *
+ ******************************************************************************/
+
+amqp::internal::
+Evolution::Evolution (
+    uPtr<const schema::Schema> expected_,
+    uPtr<const schema::Transforms> transforms_
+) : m_expected (std::move (expected_))
+  , m_transforms (transforms_
+        ? std::move (transforms_)
+        : std::make_unique<const schema::Transforms>())
+{ }
+
+/******************************************************************************/
+
+uPtr<amqp::internal::Evolution>
+amqp::internal::
+Evolution::fromBlob (std::string_view blob_) {
+    auto raw = RawEnvelope::locate (blob_);
+
+    if (!raw) {
+        throw std::runtime_error ("Not a blob we can take a schema from");
+    }
+
+    uPtr<const schema::Transforms> transforms;
+    if (!raw->transforms.empty()) {
+        transforms = schema::descriptors::decodeDescribed<schema::Transforms> (
+            raw->transforms);
+    }
+
+    return std::make_unique<Evolution> (
+        schema::descriptors::decodeDescribed<schema::Schema> (raw->schema),
+        std::move (transforms));
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::TypeNotation *
+amqp::internal::
+Evolution::expected (const schema::AMQPTypeNotation & type_) const {
+    auto local = m_expected->findType (type_.name());
+
+    if (!local || local->descriptor() == type_.descriptor()) {
+        return nullptr;
+    }
+
+    return local;
+}
+
+/******************************************************************************/
+
+const amqp::internal::Evolution::Layout *
+amqp::internal::
+Evolution::layout (const schema::Composite & remote_) const {
+    auto expected = this->expected (remote_);
+
+    if (!expected) {
+        return nullptr;
+    }
+
+    auto local = as<schema::Composite> (*expected);
+
+    if (!local) {
+        throw std::runtime_error (
+            "Can't evolve " + remote_.name() + ", we don't expect a composite");
+    }
+
+    Key key { remote_.descriptor(), local->descriptor() };
+
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+
+        auto it = m_layouts.find (key);
+        if (it != m_layouts.end()) {
+            return it->second.get();
+        }
+    }
+
+    auto built = layout (remote_, *local);
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_layouts.emplace (std::move (key), std::move (built)).first->second.get();
+}
+
+/******************************************************************************/
+
+uPtr<const amqp::internal::Evolution::Layout>
+amqp::internal::
+Evolution::layout (
+    const schema::Composite & remote_,
+    const schema::Composite & local_
+) const {
+    DBG ("Evolution::layout - " << remote_.name() << std::endl); // NOLINT
+
+    std::map<std::string_view, int> remote;
+    for (std::size_t i { 0 } ; i < remote_.fields().size() ; ++i) {
+        remote.emplace (remote_.fields()[i]->name(), static_cast<int>(i));
+    }
+
+    auto rtn = std::make_unique<Layout>();
+
+    for (const auto & field : local_.fields()) {
+        auto it = remote.find (field->name());
+
+        rtn->names.emplace_back (field->name());
+
+        if (it != remote.end()) {
+            rtn->source.emplace_back (it->second);
+            rtn->defaults.emplace_back();
+            continue;
+        }
+
+        if (field->mandatory() && field->defaultValue().empty()) {
+            throw std::runtime_error (
+                "Can't evolve " + remote_.name() + ", it's missing mandatory field "
+                    + field->name());
+        }
+
+        rtn->source.emplace_back (-1);
+        rtn->defaults.emplace_back (
+            field->defaultValue().empty() ? "null" : field->defaultValue());
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+const amqp::internal::Evolution::Constants *
+amqp::internal::
+Evolution::constants (
+    const schema::Enum & remote_,
+    const schema::Transforms & transforms_
+) const {
+    auto expected = this->expected (remote_);
+
+    if (!expected) {
+        return nullptr;
+    }
+
+    auto local = as<schema::Enum> (*expected);
+
+    if (!local) {
+        throw std::runtime_error (
+            "Can't evolve " + remote_.name() + ", we don't expect an enum");
+    }
+
+    Key key { remote_.descriptor(), local->descriptor() };
+
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+
+        auto it = m_constants.find (key);
+        if (it != m_constants.end()) {
+            return it->second.get();
+        }
+    }
+
+    auto built = constants (remote_, *local, transforms_);
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_constants.emplace (std::move (key), std::move (built)).first->second.get();
+}
+
+/******************************************************************************/
+
+/**
+ * The blob may be older than us, in which case it's our transforms that
+ * say what its constants became, or newer, in which case its own say
+ * what the constants we've never heard of should be read as. Either way
+ * we follow renames, in both directions, and enum defaults from each
+ * constant until we reach one of ours, taking the nearest. A constant we
+ * can't reach one of ours from is read as written.
+ */
+uPtr<const amqp::internal::Evolution::Constants>
+amqp::internal::
+Evolution::constants (
+    const schema::Enum & remote_,
+    const schema::Enum & local_,
+    const schema::Transforms & transforms_
+) const {
+    DBG ("Evolution::constants - " << remote_.name() << std::endl); // NOLINT
+
+    auto ours = local_.makeChoices();
+    std::set<std::string_view> known (ours.begin(), ours.end());
+
+    std::vector<const schema::Transform *> transforms;
+    for (const auto * set : {
+        transforms_.find (remote_.name()),
+        m_transforms->find (local_.name()) })
+    {
+        if (set) {
+            for (const auto & transform : *set) {
+                transforms.emplace_back (&transform);
+            }
+        }
+    }
+
+    auto rtn = std::make_unique<Constants>();
+
+    for (const auto & constant : remote_.makeChoices()) {
+        std::deque<std::string_view> next { constant };
+        std::set<std::string_view> seen { constant };
+        std::string_view found;
+
+        while (!next.empty()) {
+            auto current = next.front();
+            next.pop_front();
+
+            if (known.count (current)) {
+                found = current;
+                break;
+            }
+
+            auto visit = [&next, &seen](std::string_view to_) {
+                if (seen.insert (to_).second) {
+                    next.push_back (to_);
+                }
+            };
+
+            for (const auto * transform : transforms) {
+                if (transform->kind() == schema::Transform::Rename) {
+                    if (transform->from() == current) visit (transform->to());
+                    if (transform->to() == current) visit (transform->from());
+                } else if (transform->kind() == schema::Transform::EnumDefault) {
+                    if (transform->from() == current) visit (transform->to());
+                }
+            }
+        }
+
+        rtn->emplace_back (found.empty() ? constant : std::string (found));
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::size_t
+amqp::internal::
+Evolution::size() const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_layouts.size() + m_constants.size();
+}
+
+/******************************************************************************/
@@ -0,0 +1,153 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <utility>
+#include <string_view>
+
+#include "types.h"
+
+#include "amqp/schema/described-types/Schema.h"
+#include "amqp/schema/described-types/Composite.h"
+#include "amqp/schema/described-types/Transforms.h"
+#include "amqp/schema/restricted-types/Enum.h"
+
+/******************************************************************************
+ *
+ * class Evolution
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * The types we expect, so that blobs written by other versions of
+     * a CorDapp read as if they'd been written by ours.
+     *
+     * A blob's schema describes the types as they were when it was
+     * written. Where one of those has a different fingerprint, and so a
+     * different descriptor, to the type of the same name we expect, its
+     * readers are built to present it as ours:
+     *
+     *   - a composite's fields come out in our order, under our names.
+     *     Fields we don't have are skipped over unread, fields the blob
+     *     doesn't have are given their default, or null.
+     *   - an enum's constants are mapped onto ours through the renames
+     *     and enum defaults recorded in the transforms, the blob's and
+     *     our own.
+     *
+     * Working that out means matching names, which we don't want to do
+     * per object, so each mapping is worked out once for each pair of
+     * fingerprints and kept. What a reader does per object is then just
+     * the precomputed permutation.
+     *
+     * Immutable once constructed bar the mappings, which are only ever
+     * added to under a lock and never move, so safe to share between
+     * every factory and thread in the process.
+     */
+    class Evolution {
+        public :
+            /**
+             * How to present a composite as ours
+             */
+            struct Layout {
+                /**
+                 * For each of our fields, the blob's field it's read
+                 * from or -1 if the blob doesn't have one
+                 */
+                std::vector<int> source;
+
+                /**
+                 * Our field names, in our order
+                 */
+                std::vector<std::string> names;
+
+                /**
+                 * What each field the blob doesn't have reads as
+                 */
+                std::vector<std::string> defaults;
+            };
+
+            /**
+             * For each of the blob's constants, by ordinal, which of ours
+             * it reads as
+             */
+            using Constants = std::vector<std::string>;
+
+        private :
+            using Key = std::pair<std::string, std::string>;
+
+            uPtr<const schema::Schema>     m_expected;
+            uPtr<const schema::Transforms> m_transforms;
+
+            mutable std::mutex m_mutex;
+
+            mutable std::map<Key, uPtr<const Layout>>    m_layouts;
+            mutable std::map<Key, uPtr<const Constants>> m_constants;
+
+            /**
+             * Our type of the same name as [type_] if it differs from it,
+             * nullptr if it's one we don't have or don't need to evolve
+             */
+            const schema::TypeNotation * expected (
+                const schema::AMQPTypeNotation & type_) const;
+
+            uPtr<const Layout> layout (
+                const schema::Composite & remote_,
+                const schema::Composite & local_) const;
+
+            uPtr<const Constants> constants (
+                const schema::Enum & remote_,
+                const schema::Enum & local_,
+                const schema::Transforms & transforms_) const;
+
+        public :
+            /**
+             * @param transforms_ those recorded against the types we
+             * expect, if any
+             */
+            explicit Evolution (
+                uPtr<const schema::Schema> expected_,
+                uPtr<const schema::Transforms> transforms_ = nullptr);
+
+            Evolution (const Evolution &) = delete;
+
+            /**
+             * Expect the types, and transforms, of a blob written by the
+             * version of the CorDapp we want to read everything as
+             *
+             * @throws std::runtime_error if [blob_] isn't a blob
+             */
+            static uPtr<Evolution> fromBlob (std::string_view blob_);
+
+            /**
+             * How to read [remote_] as ours, nullptr if it already is
+             *
+             * @throws std::runtime_error if it can't be, a field we need
+             * is missing or our type of that name isn't a composite
+             */
+            const Layout * layout (const schema::Composite & remote_) const;
+
+            /**
+             * How to read the constants of [remote_] as ours, nullptr if
+             * they already are
+             *
+             * @param transforms_ the blob's transforms
+             */
+            const Constants * constants (
+                const schema::Enum & remote_,
+                const schema::Transforms & transforms_) const;
+
+            /**
+             * How many mappings we've worked out
+             */
+            std::size_t size() const;
+    };
+
+}
+
+/******************************************************************************/
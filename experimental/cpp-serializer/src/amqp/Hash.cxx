@@ -0,0 +1,115 @@
+#include "Hash.h"
+
+#include <cstring>
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr uint64_t P1 { 0x9E3779B185EBCA87ULL };
+    constexpr uint64_t P2 { 0xC2B2AE3D27D4EB4FULL };
+    constexpr uint64_t P3 { 0x165667B19E3779F9ULL };
+    constexpr uint64_t P4 { 0x85EBCA77C2B2AE63ULL };
+    constexpr uint64_t P5 { 0x27D4EB2F165667C5ULL };
+
+    inline uint64_t
+    rotl (uint64_t x_, int r_) {
+        return (x_ << r_) | (x_ >> (64 - r_));
+    }
+
+    /**
+     * The hash is defined over little endian words whatever the host
+     */
+    inline uint64_t
+    read64 (const unsigned char * p_) {
+        uint64_t rtn { 0 };
+        for (int i { 7 } ; i >= 0 ; --i) {
+            rtn = (rtn << 8) | p_[i];
+        }
+
+        return rtn;
+    }
+
+    inline uint32_t
+    read32 (const unsigned char * p_) {
+        return static_cast<uint32_t>(p_[0])
+            | static_cast<uint32_t>(p_[1]) << 8
+            | static_cast<uint32_t>(p_[2]) << 16
+            | static_cast<uint32_t>(p_[3]) << 24;
+    }
+
+    inline uint64_t
+    round (uint64_t acc_, uint64_t input_) {
+        acc_ += input_ * P2;
+        acc_ = rotl (acc_, 31);
+        return acc_ * P1;
+    }
+
+    inline uint64_t
+    merge (uint64_t acc_, uint64_t val_) {
+        acc_ ^= round (0, val_);
+        return acc_ * P1 + P4;
+    }
+
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::
+xxh64 (std::string_view bytes_, uint64_t seed_) {
+    auto p = reinterpret_cast<const unsigned char *>(bytes_.data());
+    const auto end = p + bytes_.size();
+
+    uint64_t h;
+
+    if (bytes_.size() >= 32) {
+        uint64_t v1 { seed_ + P1 + P2 };
+        uint64_t v2 { seed_ + P2 };
+        uint64_t v3 { seed_ };
+        uint64_t v4 { seed_ - P1 };
+
+        for ( ; p + 32 <= end ; p += 32) {
+            v1 = round (v1, read64 (p));
+            v2 = round (v2, read64 (p + 8));
+            v3 = round (v3, read64 (p + 16));
+            v4 = round (v4, read64 (p + 24));
+        }
+
+        h = rotl (v1, 1) + rotl (v2, 7) + rotl (v3, 12) + rotl (v4, 18);
+        h = merge (h, v1);
+        h = merge (h, v2);
+        h = merge (h, v3);
+        h = merge (h, v4);
+    } else {
+        h = seed_ + P5;
+    }
+
+    h += bytes_.size();
+
+    for ( ; p + 8 <= end ; p += 8) {
+        h ^= round (0, read64 (p));
+        h = rotl (h, 27) * P1 + P4;
+    }
+
+    if (p + 4 <= end) {
+        h ^= read32 (p) * P1;
+        h = rotl (h, 23) * P2 + P3;
+        p += 4;
+    }
+
+    for ( ; p < end ; ++p) {
+        h ^= *p * P5;
+        h = rotl (h, 11) * P1;
+    }
+
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+
+    return h;
+}
+
+/******************************************************************************/
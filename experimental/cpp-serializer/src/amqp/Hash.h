@@ -0,0 +1,21 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * XXH64, a fast non cryptographic hash. Good for telling apart byte
+     * strings we're about to compare anyway, no good against anyone
+     * choosing them to collide.
+     */
+    uint64_t xxh64 (std::string_view bytes_, uint64_t seed_ = 0);
+
+}
+
+/******************************************************************************/
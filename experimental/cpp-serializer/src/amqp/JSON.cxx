@@ -0,0 +1,223 @@
+#include "JSON.h"
+
+#include <cstdint>
+
+#ifdef AMQP_X86
+#include <immintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    using amqp::internal::json::Engine;
+
+    constexpr char HEX[] = "0123456789abcdef";
+
+    /**
+     * Printable ASCII other than a quote or a backslash goes out as it
+     * came in
+     */
+    inline bool
+    plain (uint8_t c_) {
+        return c_ >= 0x20 && c_ < 0x80 && c_ != '"' && c_ != '\\';
+    }
+
+    /**
+     * How much of the [size_] bytes at [p_] is plain, a byte at a time
+     */
+    std::size_t
+    runScalar (const char * p_, std::size_t size_) {
+        std::size_t i { 0 };
+        while (i < size_ && plain (static_cast<uint8_t>(p_[i]))) ++i;
+        return i;
+    }
+
+#ifdef AMQP_X86
+
+    /*
+     * Bytes from 0x80 up are negative as signed chars, so the one signed
+     * compare against 0x20 catches them along with the control characters
+     */
+
+    __attribute__ ((target ("sse2")))
+    std::size_t
+    runSSE2 (const char * p_, std::size_t size_) {
+        const auto space = _mm_set1_epi8 (0x20);
+        const auto quote = _mm_set1_epi8 ('"');
+        const auto slash = _mm_set1_epi8 ('\\');
+
+        std::size_t i { 0 };
+        for ( ; i + 16 <= size_ ; i += 16) {
+            auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(p_ + i));
+
+            auto hits = _mm_or_si128 (
+                _mm_cmplt_epi8 (v, space),
+                _mm_or_si128 (_mm_cmpeq_epi8 (v, quote), _mm_cmpeq_epi8 (v, slash)));
+
+            if (auto mask = static_cast<unsigned>(_mm_movemask_epi8 (hits))) {
+                return i + __builtin_ctz (mask);
+            }
+        }
+
+        return i + runScalar (p_ + i, size_ - i);
+    }
+
+    __attribute__ ((target ("avx2")))
+    std::size_t
+    runAVX2 (const char * p_, std::size_t size_) {
+        const auto space = _mm256_set1_epi8 (0x20);
+        const auto quote = _mm256_set1_epi8 ('"');
+        const auto slash = _mm256_set1_epi8 ('\\');
+
+        std::size_t i { 0 };
+        for ( ; i + 32 <= size_ ; i += 32) {
+            auto v = _mm256_loadu_si256 (reinterpret_cast<const __m256i *>(p_ + i));
+
+            auto hits = _mm256_or_si256 (
+                _mm256_cmpgt_epi8 (space, v),
+                _mm256_or_si256 (_mm256_cmpeq_epi8 (v, quote), _mm256_cmpeq_epi8 (v, slash)));
+
+            if (auto mask = static_cast<unsigned>(_mm256_movemask_epi8 (hits))) {
+                return i + __builtin_ctz (mask);
+            }
+        }
+
+        return i + runSSE2 (p_ + i, size_ - i);
+    }
+
+#endif
+
+    /**
+     * The length of the well formed UTF-8 sequence starting [p_], zero
+     * if it isn't one. Overlong forms, surrogates and anything past
+     * U+10FFFF aren't.
+     */
+    std::size_t
+    sequence (const uint8_t * p_, std::size_t size_) {
+        uint8_t lo { 0x80 }, hi { 0xbf };
+        std::size_t length;
+
+        if (p_[0] < 0xc2) {
+            return 0;
+        } else if (p_[0] < 0xe0) {
+            length = 2;
+        } else if (p_[0] < 0xf0) {
+            length = 3;
+            if (p_[0] == 0xe0) lo = 0xa0;
+            if (p_[0] == 0xed) hi = 0x9f;
+        } else if (p_[0] < 0xf5) {
+            length = 4;
+            if (p_[0] == 0xf0) lo = 0x90;
+            if (p_[0] == 0xf4) hi = 0x8f;
+        } else {
+            return 0;
+        }
+
+        if (size_ < length || p_[1] < lo || p_[1] > hi) {
+            return 0;
+        }
+
+        for (std::size_t i { 2 } ; i < length ; ++i) {
+            if ((p_[i] & 0xc0U) != 0x80) return 0;
+        }
+
+        return length;
+    }
+
+    /**
+     * Write out whatever it was at [p_] that stopped the run, returning
+     * how many bytes of input that took
+     */
+    std::size_t
+    special (const char * p_, std::size_t size_, std::string & out_) {
+        auto c = static_cast<uint8_t>(*p_);
+
+        if (c >= 0x80) {
+            if (auto length = sequence (reinterpret_cast<const uint8_t *>(p_), size_)) {
+                out_.append (p_, length);
+                return length;
+            }
+
+            out_.append ("\xef\xbf\xbd");
+            return 1;
+        }
+
+        switch (c) {
+            case '"'  : out_.append ("\\\""); break;
+            case '\\' : out_.append ("\\\\"); break;
+            case '\b' : out_.append ("\\b"); break;
+            case '\f' : out_.append ("\\f"); break;
+            case '\n' : out_.append ("\\n"); break;
+            case '\r' : out_.append ("\\r"); break;
+            case '\t' : out_.append ("\\t"); break;
+            default : {
+                char u[] = { '\\', 'u', '0', '0', HEX[c >> 4U], HEX[c & 0xfU] };
+                out_.append (u, sizeof (u));
+            }
+        }
+
+        return 1;
+    }
+
+    template<std::size_t (*run_)(const char *, std::size_t)>
+    void
+    escapeWith (std::string_view value_, std::string & out_) {
+        out_.reserve (out_.size() + value_.size());
+
+        auto p = value_.data();
+        auto end = p + value_.size();
+
+        while (p < end) {
+            auto run = run_ (p, end - p);
+            out_.append (p, run);
+            p += run;
+
+            if (p < end) {
+                p += special (p, end - p, out_);
+            }
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::json
+ *
+ ******************************************************************************/
+
+void
+amqp::internal::json::
+escape (std::string_view value_, std::string & out_, Engine engine_) {
+    static const Engine fastest = cpu::best (KERNELS);
+
+    engine_ = engine_ == Engine::Best
+        ? fastest
+        : cpu::resolve (engine_, KERNELS, "JSON");
+
+    switch (engine_) {
+#ifdef AMQP_X86
+        case Engine::SSE2 : escapeWith<runSSE2> (value_, out_); break;
+        case Engine::AVX2 : escapeWith<runAVX2> (value_, out_); break;
+#endif
+        default : escapeWith<runScalar> (value_, out_);
+    }
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::json::
+quoted (std::string_view value_, Engine engine_) {
+    std::string rtn;
+    rtn.reserve (value_.size() + 2);
+
+    rtn += '"';
+    escape (value_, rtn, engine_);
+    rtn += '"';
+
+    return rtn;
+}
+
+/******************************************************************************/
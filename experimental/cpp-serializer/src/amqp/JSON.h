@@ -0,0 +1,39 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <string_view>
+
+#include "amqp/Cpu.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::json {
+
+    using cpu::Engine;
+
+    /**
+     * What can scan for the characters that need escaping
+     */
+    constexpr cpu::Kernels KERNELS { Engine::AVX2, Engine::SSE2 };
+
+    /**
+     * Append [value_] to [out_] as the inside of a JSON string.
+     *
+     * Quotes, backslashes and control characters are escaped and any
+     * bytes that aren't valid UTF-8 replaced with U+FFFD. Runs of
+     * printable ASCII, which is nearly everything Corda writes, are
+     * found a vector at a time and copied whole, only what's left over
+     * is looked at a byte at a time.
+     */
+    void escape (std::string_view value_, std::string & out_, Engine = Engine::Best);
+
+    /**
+     * [value_] escaped and in quotes
+     */
+    std::string quoted (std::string_view value_, Engine = Engine::Best);
+
+}
+
+/******************************************************************************/
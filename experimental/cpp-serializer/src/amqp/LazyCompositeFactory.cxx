@@ -0,0 +1,131 @@
+#include "LazyCompositeFactory.h"
+
+#include <stdexcept>
+
+#include "debug.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::LazyCompositeFactory
+ *
+ ******************************************************************************/
+
+void
+amqp::internal::
+LazyCompositeFactory::process (const SchemaType & schema_) {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    m_schema = &dynamic_cast<const schema::TypeLookup &>(schema_);
+}
+
+/******************************************************************************/
+
+/**
+ * Building a type builds everything it depends on, through [missing],
+ * before it returns
+ */
+const amqp::internal::reader::Reader *
+amqp::internal::
+LazyCompositeFactory::materialise (const schema::TypeNotation & type_) {
+    // already built, if only as a well known type, so won't recurse
+    if (CompositeFactory::resolveType (type_.name())) {
+        return build (type_);
+    }
+
+    DBG ("materialise - " << type_.name() << std::endl); // NOLINT
+
+    if (!m_building.insert (type_.name()).second) {
+        throw std::runtime_error ("Type " + type_.name() + " depends on itself");
+    }
+
+    try {
+        auto reader = build (type_);
+        m_building.erase (type_.name());
+
+        return reader;
+    } catch (...) {
+        m_building.clear();
+        throw;
+    }
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::
+LazyCompositeFactory::describes (const std::string & type_) const {
+    return (m_schema && m_schema->findType (type_))
+        || CompositeFactory::describes (type_);
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::
+LazyCompositeFactory::missing (const std::string & type_) {
+    if (m_schema) {
+        if (auto type = m_schema->findType (type_)) {
+            return materialise (*type);
+        }
+    }
+
+    return CompositeFactory::missing (type_);
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::
+LazyCompositeFactory::resolveDescriptor (std::string_view descriptor_) const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    if (auto reader = CompositeFactory::resolveDescriptor (descriptor_)) {
+        return reader;
+    }
+
+    if (m_schema) {
+        if (auto type = m_schema->findDescriptor (std::string (descriptor_))) {
+            return self().materialise (*type);
+        }
+    }
+
+    return nullptr;
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::
+LazyCompositeFactory::resolveType (const std::string & type_) const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    if (auto reader = CompositeFactory::resolveType (type_)) {
+        return reader;
+    }
+
+    if (m_schema) {
+        if (auto type = m_schema->findType (type_)) {
+            return self().materialise (*type);
+        }
+    }
+
+    return nullptr;
+}
+
+/******************************************************************************/
+
+const amqp::internal::LazyCompositeFactory::ReaderType *
+amqp::internal::
+LazyCompositeFactory::byType (const std::string & type_) const {
+    return resolveType (type_);
+}
+
+/******************************************************************************/
+
+const amqp::internal::LazyCompositeFactory::ReaderType *
+amqp::internal::
+LazyCompositeFactory::byDescriptor (const std::string & descriptor_) const {
+    return resolveDescriptor (descriptor_);
+}
+
+/******************************************************************************/
@@ -0,0 +1,94 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <set>
+#include <mutex>
+#include <string>
+
+#include "amqp/CompositeFactory.h"
+#include "amqp/schema/TypeLookup.h"
+
+/******************************************************************************
+ *
+ * class LazyCompositeFactory
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * A [CompositeFactory] that only builds the readers a decode needs.
+     *
+     * [process] just remembers the schema. Asking for a reader builds it
+     * then, along with the readers for the types its fields are, and
+     * theirs, and so on, so from the envelope's descriptor we build the
+     * types reachable from the root and nothing else. Types that can only
+     * turn up in a polymorphic field are built the first time one is
+     * actually seen there. Schemas that list dozens of types of which a
+     * blob only ever uses a few skip building the rest.
+     *
+     * We follow the dependencies ourselves as we go so don't rely on the
+     * schema's ordering, and every reader is built at most once.
+     *
+     * Unlike the eager factory the lookups can modify us, they're still
+     * safe to call from any number of threads as they're serialised by a
+     * mutex, but that makes this the wrong choice for a factory shared by
+     * many threads decoding the same schemas. It's meant for one off
+     * decodes where most of the schema goes unused.
+     *
+     * The schema given to [process], which can be an [IndexedSchema] so
+     * types are only built when their readers are, must outlive us.
+     */
+    class LazyCompositeFactory : public CompositeFactory {
+        private :
+            const schema::TypeLookup * m_schema;
+
+            /**
+             * Types we're part way through building, a type that turns
+             * up again whilst we are depends on itself
+             */
+            std::set<std::string> m_building;
+
+            mutable std::mutex m_mutex;
+
+            const reader::Reader * materialise (const schema::TypeNotation &);
+
+            /**
+             * Lookups look const but may build readers, they lock and
+             * then cast that away to get at the rest of us
+             */
+            LazyCompositeFactory & self() const {
+                return const_cast<LazyCompositeFactory &>(*this);
+            }
+
+        protected :
+            bool describes (const std::string & type_) const override;
+
+            const reader::Reader * missing (const std::string & type_) override;
+
+            const reader::Reader * resolveDescriptor (
+                    std::string_view) const override;
+
+            const reader::Reader * resolveType (
+                    const std::string &) const override;
+
+        public :
+            explicit LazyCompositeFactory (
+                Validation validation_ = Validation::Strict,
+                const Evolution * evolution_ = nullptr,
+                const schema::Transforms * transforms_ = nullptr
+            ) : CompositeFactory (validation_, evolution_, transforms_)
+              , m_schema (nullptr)
+            { }
+
+            void process (const SchemaType &) override;
+
+            const ReaderType * byType (const std::string &) const override;
+
+            const ReaderType * byDescriptor (const std::string &) const override;
+    };
+
+}
+
+/******************************************************************************/
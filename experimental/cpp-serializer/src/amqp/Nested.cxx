@@ -0,0 +1,328 @@
+#include "Nested.h"
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <condition_variable>
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/reader/Reader.h"
+#include "amqp/Binary.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using Blob = amqp::internal::Nested::Blob;
+
+    /**
+     * Dumps as whatever its blob has been rendered as by the time the
+     * tree is stringified, or as its bytes, rendered however whoever is
+     * stringifying it wants binary, if it wasn't
+     */
+    class NestedValue : public amqp::internal::reader::Value {
+        private :
+            const std::optional<std::string> m_property;
+            const std::shared_ptr<const Blob> m_blob;
+
+        public :
+            NestedValue (
+                std::optional<std::string> property_,
+                std::shared_ptr<const Blob> blob_
+            ) : m_property (std::move (property_))
+              , m_blob (std::move (blob_))
+            { }
+
+            std::string dump() const override {
+                auto rendered = m_blob->rendered
+                    ? *m_blob->rendered
+                    : amqp::internal::binary::render (m_blob->bytes);
+
+                return m_property
+                    ? *m_property + " : " + rendered
+                    : rendered;
+            }
+    };
+
+    /**
+     * The threads nested blobs are inspected on alongside whichever
+     * thread found them. There's one for the process, started the first
+     * time it's needed with a thread per core less one, however many
+     * blobs are being dumped at once.
+     */
+    class Pool {
+        public :
+            /**
+             * One call to [Nested::inspect] asking for help, [work]
+             * returning once there are no blobs left to start on
+             */
+            struct Batch {
+                const std::function<void()> & work;
+                std::size_t running { 0 };
+            };
+
+            /**
+             * Queues [helpers_] of our threads to [batch_] and, however
+             * we're left, withdraws those that didn't get round to it
+             * and waits for those that did
+             */
+            class Helpers {
+                private :
+                    Pool & m_pool;
+                    Batch & m_batch;
+
+                public :
+                    Helpers (Pool & pool_, Batch & batch_, std::size_t helpers_);
+                    Helpers (const Helpers &) = delete;
+                    ~Helpers();
+            };
+
+        private :
+            std::mutex m_mutex;
+            std::condition_variable m_queued;
+            std::condition_variable m_finished;
+            std::deque<Batch *> m_queue;
+            bool m_stopping { false };
+
+            std::vector<std::thread> m_threads;
+
+            Pool();
+
+            void run();
+
+        public :
+            Pool (const Pool &) = delete;
+            ~Pool();
+
+            static Pool & instance();
+
+            std::size_t size() const;
+    };
+
+}
+
+/******************************************************************************
+ *
+ * Pool
+ *
+ ******************************************************************************/
+
+Pool::Pool() {
+    auto threads = std::max (1U, std::thread::hardware_concurrency()) - 1;
+
+    try {
+        m_threads.reserve (threads);
+
+        for (std::size_t i { 0 } ; i < threads ; ++i) {
+            m_threads.emplace_back ([this]() { run(); });
+        }
+    } catch (const std::exception &) {
+        // failing to start a thread leaves us with fewer, which is only
+        // slower, those we did start are ours to join as ever
+    }
+}
+
+/******************************************************************************/
+
+Pool::~Pool() {
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        m_stopping = true;
+    }
+
+    m_queued.notify_all();
+
+    for (auto & thread : m_threads) {
+        thread.join();
+    }
+}
+
+/******************************************************************************/
+
+Pool &
+Pool::instance() {
+    static Pool pool;
+
+    return pool;
+}
+
+/******************************************************************************/
+
+std::size_t
+Pool::size() const {
+    return m_threads.size();
+}
+
+/******************************************************************************/
+
+void
+Pool::run() {
+    for (;;) {
+        Batch * batch;
+
+        {
+            std::unique_lock<std::mutex> lock (m_mutex);
+            m_queued.wait (lock, [this]() { return m_stopping || !m_queue.empty(); });
+
+            if (m_queue.empty()) {
+                return;
+            }
+
+            batch = m_queue.front();
+            m_queue.pop_front();
+            ++batch->running;
+        }
+
+        batch->work();
+
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            --batch->running;
+        }
+
+        m_finished.notify_all();
+    }
+}
+
+/******************************************************************************/
+
+Pool::Helpers::Helpers (Pool & pool_, Batch & batch_, std::size_t helpers_)
+    : m_pool (pool_)
+    , m_batch (batch_)
+{
+    {
+        std::lock_guard<std::mutex> lock (m_pool.m_mutex);
+        m_pool.m_queue.insert (m_pool.m_queue.end(), helpers_, &m_batch);
+    }
+
+    m_pool.m_queued.notify_all();
+}
+
+/******************************************************************************/
+
+Pool::Helpers::~Helpers() {
+    std::unique_lock<std::mutex> lock (m_pool.m_mutex);
+
+    m_pool.m_queue.erase (
+        std::remove (m_pool.m_queue.begin(), m_pool.m_queue.end(), &m_batch),
+        m_pool.m_queue.end());
+
+    m_pool.m_finished.wait (lock, [this]() { return m_batch.running == 0; });
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::Nested
+ *
+ ******************************************************************************/
+
+thread_local amqp::internal::Nested *
+amqp::internal::Nested::s_current { nullptr };
+
+thread_local bool
+amqp::internal::Nested::s_worker { false };
+
+/******************************************************************************/
+
+amqp::internal::
+Nested::Scope::Scope (Nested & nested_)
+    : m_previous (s_current)
+{
+    s_current = &nested_;
+}
+
+/******************************************************************************/
+
+amqp::internal::
+Nested::Scope::~Scope() {
+    s_current = m_previous;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::
+Nested::isBlob (std::string_view bytes_) {
+    return bytes_.size() > amqp::AMQP_HEADER.size()
+        && std::equal (
+            amqp::AMQP_HEADER.begin(), amqp::AMQP_HEADER.end(), bytes_.begin())
+        && bytes_[amqp::AMQP_HEADER.size()] == amqp::DATA_AND_STOP;
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::
+Nested::value (std::string_view bytes_, const std::string * name_) {
+    if (!s_current || !isBlob (bytes_)) {
+        return nullptr;
+    }
+
+    auto blob = std::make_shared<Blob> (Blob { std::string (bytes_), std::nullopt });
+
+    s_current->m_blobs.push_back (blob);
+
+    return std::make_unique<NestedValue> (
+        name_ ? std::optional<std::string> (*name_) : std::nullopt,
+        std::move (blob));
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::
+Nested::Blob::body() const {
+    return std::string_view (bytes).substr (amqp::AMQP_HEADER.size() + 1);
+}
+
+/******************************************************************************/
+
+std::size_t
+amqp::internal::
+Nested::size() const {
+    return m_blobs.size();
+}
+
+/******************************************************************************/
+
+/**
+ * The calling thread takes blobs alongside the pool's so a single blob
+ * costs no other thread at all, and nothing nested below the first level
+ * asks the pool for help again, so a thread waiting on its helpers is
+ * never one they're waiting on
+ */
+void
+amqp::internal::
+Nested::inspect (const Inspector & inspector_) {
+    std::atomic<std::size_t> next { 0 };
+
+    const std::function<void()> work = [this, &next, &inspector_]() {
+        auto worker = s_worker;
+        s_worker = true;
+
+        for (auto i = next++ ; i < m_blobs.size() ; i = next++) {
+            if (auto rendered = inspector_ (m_blobs[i]->body())) {
+                m_blobs[i]->rendered = std::move (*rendered);
+            }
+        }
+
+        s_worker = worker;
+    };
+
+    if (s_worker || m_blobs.size() < 2) {
+        work();
+        return;
+    }
+
+    auto & pool = Pool::instance();
+
+    Pool::Batch batch { work };
+    Pool::Helpers helpers (pool, batch, std::min (m_blobs.size() - 1, pool.size()));
+
+    work();
+}
+
+/******************************************************************************/
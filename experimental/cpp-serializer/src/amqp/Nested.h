@@ -0,0 +1,112 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <string_view>
+
+#include "types.h"
+
+#include "amqp/reader/IReader.h"
+
+/******************************************************************************
+ *
+ * class Nested
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Corda blobs carried inside other Corda blobs as binary, the
+     * component groups of a WireTransaction or the SerializedBytes of a
+     * SignedTransaction for example.
+     *
+     * As with the [Budget], whoever starts a decode installs one for the
+     * current thread with a [Scope] and the readers of binary values hand
+     * it any that start with a Corda header. Each is dumped as what
+     * [inspect] decoded it to, so the tree the readers built can be
+     * stringified afterwards with the nested blobs spliced in, or as its
+     * bytes if that failed, those only being rendered then. With nothing
+     * installed binary is read as it always has been.
+     */
+    class Nested {
+        public :
+            struct Blob {
+                /**
+                 * Header and all, as it was carried
+                 */
+                const std::string bytes;
+
+                std::optional<std::string> rendered;
+
+                /**
+                 * Past the header, as CordaBytes would give it us
+                 */
+                std::string_view body() const;
+            };
+
+            using Inspector = std::function<std::optional<std::string>(std::string_view)>;
+
+        private :
+            std::vector<std::shared_ptr<Blob>> m_blobs;
+
+            static thread_local Nested * s_current;
+
+            /**
+             * Set while a thread is inspecting blobs, anything nested
+             * deeper than that is inspected on the thread that finds it
+             */
+            static thread_local bool s_worker;
+
+        public :
+            Nested() = default;
+            Nested (const Nested &) = delete;
+
+            /**
+             * Makes [nested_] the one collecting this thread's blobs until
+             * we're destroyed, putting back whichever was there before
+             */
+            class Scope {
+                private :
+                    Nested * m_previous;
+
+                public :
+                    explicit Scope (Nested & nested_);
+                    Scope (const Scope &) = delete;
+                    ~Scope();
+            };
+
+            /**
+             * Whether [bytes_] are a whole Corda blob, header and all
+             */
+            static bool isBlob (std::string_view bytes_);
+
+            /**
+             * The value to dump [bytes_] as, named [name_] if it's a
+             * property, or nullptr if they aren't a blob or nothing is
+             * collecting them
+             */
+            static uPtr<amqp::reader::IValue> value (
+                std::string_view bytes_,
+                const std::string * name_ = nullptr);
+
+            std::size_t size() const;
+
+            /**
+             * Replace each blob we collected with what [inspector_] makes
+             * of it, leaving any it returns nothing for as bytes. The blobs
+             * are independent of one another so are inspected at once on
+             * a pool of threads shared by the process, [inspector_] is
+             * called from several of them and must not throw.
+             */
+            void inspect (const Inspector & inspector_);
+    };
+
+}
+
+/******************************************************************************/
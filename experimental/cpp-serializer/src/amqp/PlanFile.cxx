@@ -0,0 +1,529 @@
+#include "PlanFile.h"
+
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "amqp/schema/described-types/Choice.h"
+#include "amqp/schema/described-types/Composite.h"
+#include "amqp/schema/described-types/Descriptor.h"
+#include "amqp/schema/restricted-types/Restricted.h"
+
+/******************************************************************************
+ *
+ * Plan encoding
+ *
+ * Everything is written in host byte order, the file header tells us if
+ * that's not the order it's being read back in
+ *
+ ******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::schema;
+
+    constexpr uint8_t COMPOSITE  { 'c' };
+    constexpr uint8_t RESTRICTED { 'r' };
+
+    /******************************************************************************/
+
+    class PlanWriter {
+        private :
+            std::string & m_out;
+
+        public :
+            explicit PlanWriter (std::string & out_) : m_out (out_) { }
+
+            template<typename T>
+            void
+            put (T value_) {
+                m_out.append (reinterpret_cast<const char *>(&value_), sizeof (T));
+            }
+
+            void
+            put (const std::string & value_) {
+                put<uint32_t> (value_.size());
+                m_out.append (value_);
+            }
+
+            template<class C>
+            void
+            putAll (const C & values_) {
+                put<uint32_t> (values_.size());
+                for (const auto & value : values_) {
+                    put (value);
+                }
+            }
+    };
+
+    /******************************************************************************/
+
+    class PlanReader {
+        private :
+            std::string_view m_in;
+
+            std::string_view
+            take (std::size_t n_) {
+                if (n_ > m_in.size()) {
+                    throw std::runtime_error ("Malformed reader plan");
+                }
+
+                auto rtn = m_in.substr (0, n_);
+                m_in.remove_prefix (n_);
+
+                return rtn;
+            }
+
+        public :
+            explicit PlanReader (std::string_view in_) : m_in (in_) { }
+
+            bool empty() const { return m_in.empty(); }
+
+            template<typename T>
+            T
+            get() {
+                T rtn;
+                std::memcpy (&rtn, take (sizeof (T)).data(), sizeof (T));
+                return rtn;
+            }
+
+            std::string
+            string() {
+                return std::string (take (get<uint32_t>()));
+            }
+
+            /**
+             * A count of things each at least [min_] bytes long, checked
+             * against what's left so a corrupt one can't have us reserve
+             * gigabytes
+             */
+            uint32_t
+            count (std::size_t min_) {
+                auto rtn = get<uint32_t>();
+
+                if (rtn > m_in.size() / min_) {
+                    throw std::runtime_error ("Malformed reader plan");
+                }
+
+                return rtn;
+            }
+
+            template<class C>
+            C
+            strings() {
+                C rtn;
+                for (auto i = count (sizeof (uint32_t)) ; i ; --i) {
+                    rtn.push_back (string());
+                }
+
+                return rtn;
+            }
+    };
+
+    /******************************************************************************/
+
+    void
+    encodeType (PlanWriter & out_, const Composite & composite_) {
+        out_.put (COMPOSITE);
+        out_.put (composite_.name());
+        out_.put (composite_.label());
+        out_.put (composite_.descriptor());
+        out_.putAll (composite_.provides());
+
+        out_.put<uint32_t> (composite_.fields().size());
+        for (const auto & field : composite_.fields()) {
+            out_.put (field->name());
+            out_.put (field->type());
+            out_.putAll (field->requires());
+            out_.put (field->defaultValue());
+            out_.put (field->label());
+            out_.put<uint8_t> (field->mandatory());
+            out_.put<uint8_t> (field->multiple());
+        }
+    }
+
+    /******************************************************************************/
+
+    void
+    encodeType (PlanWriter & out_, const Restricted & restricted_) {
+        out_.put (RESTRICTED);
+        out_.put (restricted_.name());
+        out_.put (restricted_.label());
+        out_.put (restricted_.descriptor());
+        out_.putAll (restricted_.provides());
+
+        // enums and arrays are both lists on the wire, it's the choices and
+        // the name that tell them apart
+        out_.put (std::string (
+            restricted_.source() == Restricted::map_t ? "map" : "list"));
+
+        if (restricted_.source() == Restricted::enum_t) {
+            const auto & choices = static_cast<const Enum &>(restricted_).choices();
+
+            out_.put<uint32_t> (choices.size());
+            for (const auto & choice : choices) {
+                out_.put (choice->choice());
+                out_.put (choice->value());
+            }
+        } else {
+            out_.put<uint32_t> (0);
+        }
+    }
+
+    /******************************************************************************/
+
+    TypeNotation
+    decodeComposite (PlanReader & in_) {
+        auto name = in_.string();
+        auto label = in_.string();
+        auto descriptor = std::make_unique<Descriptor> (in_.string());
+        auto provides = in_.strings<std::list<std::string>>();
+
+        // every field is at least its five strings and two flags
+        auto count = in_.count (5 * sizeof (uint32_t) + 2);
+
+        std::vector<uPtr<Field>> fields;
+        fields.reserve (count);
+
+        for (auto i = count ; i ; --i) {
+            auto fName = in_.string();
+            auto fType = in_.string();
+            auto requires = in_.strings<std::list<std::string>>();
+            auto def = in_.string();
+            auto fLabel = in_.string();
+            bool mandatory = in_.get<uint8_t>();
+            bool multiple = in_.get<uint8_t>();
+
+            fields.emplace_back (Field::make (
+                std::move (fName), std::move (fType), std::move (requires),
+                std::move (def), std::move (fLabel), mandatory, multiple));
+        }
+
+        return TypeNotation (Composite (
+            std::move (name),
+            std::move (label),
+            std::move (provides),
+            std::move (descriptor),
+            std::move (fields)));
+    }
+
+    /******************************************************************************/
+
+    TypeNotation
+    decodeRestricted (PlanReader & in_) {
+        auto name = in_.string();
+        auto label = in_.string();
+        auto descriptor = std::make_unique<Descriptor> (in_.string());
+        auto provides = in_.strings<std::vector<std::string>>();
+        auto source = in_.string();
+
+        std::vector<uPtr<Choice>> choices;
+        for (auto i = in_.count (2 * sizeof (uint32_t)) ; i ; --i) {
+            auto choice = in_.string();
+            choices.emplace_back (std::make_unique<Choice> (
+                std::move (choice), in_.string()));
+        }
+
+        auto rtn = Restricted::make (
+            std::move (descriptor),
+            std::move (name),
+            std::move (label),
+            std::move (provides),
+            std::move (source),
+            std::move (choices));
+
+        return std::move (*rtn);
+    }
+
+}
+
+/******************************************************************************
+ *
+ * File layout
+ *
+ ******************************************************************************/
+
+namespace {
+
+    constexpr char MAGIC[8] { 'C', 'O', 'R', 'D', 'A', 'P', 'L', 'N' };
+    constexpr uint32_t ENDIAN { 0x01020304 };
+
+    struct Header {
+        char     magic[8];
+        uint32_t version;
+        uint32_t endian;
+        uint64_t count;
+        uint64_t size;
+    };
+
+    struct Index {
+        uint64_t hash;
+        uint64_t keyOffset;
+        uint64_t planOffset;
+        uint64_t planHash;
+        uint32_t keyLength;
+        uint32_t planLength;
+    };
+
+    /**
+     * std::hash is free to differ between builds, this can't
+     */
+    uint64_t
+    fnv1a (std::string_view key_) {
+        uint64_t hash { 0xcbf29ce484222325ULL };
+
+        for (unsigned char c : key_) {
+            hash ^= c;
+            hash *= 0x100000001b3ULL;
+        }
+
+        return hash;
+    }
+
+    Index
+    indexAt (const char * base_, std::size_t i_) {
+        Index rtn;
+        std::memcpy (&rtn, base_ + sizeof (Header) + i_ * sizeof (Index), sizeof (Index));
+        return rtn;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::PlanFile
+ *
+ ******************************************************************************/
+
+amqp::internal::
+PlanFile::PlanFile (const std::string & path_)
+    : m_base (nullptr)
+    , m_size (0)
+    , m_count (0)
+{
+    int fd = ::open (path_.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat st { };
+    if (::fstat (fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof (Header))) {
+        ::close (fd);
+        return;
+    }
+
+    void * map = ::mmap (nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close (fd);
+
+    if (map == MAP_FAILED) {
+        return;
+    }
+
+    m_base = static_cast<const char *>(map);
+    m_size = st.st_size;
+
+    Header header { };
+    std::memcpy (&header, m_base, sizeof (Header));
+
+    bool valid = std::memcmp (header.magic, MAGIC, sizeof (MAGIC)) == 0
+        && header.version == FORMAT_VERSION
+        && header.endian == ENDIAN
+        && header.size == m_size
+        && header.count <= (m_size - sizeof (Header)) / sizeof (Index);
+
+    for (uint64_t i { 0 } ; valid && i < header.count ; ++i) {
+        auto index = indexAt (m_base, i);
+
+        valid = index.keyOffset <= m_size
+            && index.keyLength <= m_size - index.keyOffset
+            && index.planOffset <= m_size
+            && index.planLength <= m_size - index.planOffset
+            && index.hash == fnv1a (at (index.keyOffset, index.keyLength))
+            && index.planHash == fnv1a (at (index.planOffset, index.planLength))
+            && (i == 0 || indexAt (m_base, i - 1).hash <= index.hash);
+    }
+
+    if (valid) {
+        m_count = header.count;
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::
+PlanFile::~PlanFile() {
+    if (m_base) {
+        ::munmap (const_cast<char *>(m_base), m_size);
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::
+PlanFile::at (uint64_t offset_, uint64_t length_) const {
+    return std::string_view (m_base + offset_, length_);
+}
+
+/******************************************************************************/
+
+std::optional<std::string_view>
+amqp::internal::
+PlanFile::find (std::string_view key_) const {
+    auto hash = fnv1a (key_);
+
+    std::size_t lo { 0 }, hi { m_count };
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        if (indexAt (m_base, mid).hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    for ( ; lo < m_count ; ++lo) {
+        auto index = indexAt (m_base, lo);
+
+        if (index.hash != hash) {
+            break;
+        }
+
+        if (at (index.keyOffset, index.keyLength) == key_) {
+            return at (index.planOffset, index.planLength);
+        }
+    }
+
+    return std::nullopt;
+}
+
+/******************************************************************************/
+
+amqp::internal::PlanFile::Plans
+amqp::internal::
+PlanFile::plans() const {
+    Plans rtn;
+    rtn.reserve (m_count);
+
+    for (std::size_t i { 0 } ; i < m_count ; ++i) {
+        auto index = indexAt (m_base, i);
+        rtn.emplace_back (
+            at (index.keyOffset, index.keyLength),
+            at (index.planOffset, index.planLength));
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+PlanFile::write (const std::string & path_, const Plans & plans_) {
+    std::vector<std::pair<uint64_t, const Plans::value_type *>> sorted;
+    sorted.reserve (plans_.size());
+
+    for (const auto & plan : plans_) {
+        sorted.emplace_back (fnv1a (plan.first), &plan);
+    }
+
+    std::sort (sorted.begin(), sorted.end());
+
+    uint64_t offset = sizeof (Header) + sorted.size() * sizeof (Index);
+
+    std::string index;
+    std::string data;
+
+    for (const auto & [ hash, plan ] : sorted) {
+        Index entry {
+            hash,
+            offset + data.size(),
+            offset + data.size() + plan->first.size(),
+            fnv1a (plan->second),
+            static_cast<uint32_t>(plan->first.size()),
+            static_cast<uint32_t>(plan->second.size())
+        };
+
+        index.append (reinterpret_cast<const char *>(&entry), sizeof (Index));
+        data.append (plan->first);
+        data.append (plan->second);
+    }
+
+    Header header { { }, FORMAT_VERSION, ENDIAN, sorted.size(), offset + data.size() };
+    std::memcpy (header.magic, MAGIC, sizeof (MAGIC));
+
+    // anyone with the old file mapped keeps seeing the old file
+    auto tmp = path_ + ".tmp." + std::to_string (::getpid());
+
+    {
+        std::ofstream out (tmp, std::ios::binary | std::ios::trunc);
+        out.write (reinterpret_cast<const char *>(&header), sizeof (Header));
+        out.write (index.data(), index.size());
+        out.write (data.data(), data.size());
+
+        if (!out) {
+            ::unlink (tmp.c_str());
+            throw std::runtime_error ("Failed to write reader plans to " + tmp);
+        }
+    }
+
+    if (::rename (tmp.c_str(), path_.c_str()) != 0) {
+        ::unlink (tmp.c_str());
+        throw std::runtime_error ("Failed to replace reader plans at " + path_);
+    }
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::
+PlanFile::encode (const schema::Schema & schema_) {
+    std::string rtn;
+    PlanWriter out (rtn);
+
+    out.put<uint32_t> (schema_.types().size());
+
+    for (const auto & type : schema_) {
+        type.visit ([&out](const auto & notation_) {
+            encodeType (out, notation_);
+        });
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+uPtr<amqp::internal::schema::Schema>
+amqp::internal::
+PlanFile::decode (std::string_view plan_) {
+    PlanReader in (plan_);
+
+    // each type is at least its kind, four strings and a count
+    auto count = in.count (1 + 5 * sizeof (uint32_t));
+
+    std::vector<schema::TypeNotation> types;
+    types.reserve (count);
+
+    for (auto i = count ; i ; --i) {
+        switch (in.get<uint8_t>()) {
+            case COMPOSITE  : types.emplace_back (decodeComposite (in)); break;
+            case RESTRICTED : types.emplace_back (decodeRestricted (in)); break;
+            default : throw std::runtime_error ("Malformed reader plan");
+        }
+    }
+
+    if (!in.empty()) {
+        throw std::runtime_error ("Malformed reader plan");
+    }
+
+    return std::make_unique<schema::Schema> (std::move (types));
+}
+
+/******************************************************************************/
@@ -0,0 +1,101 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <string_view>
+
+#include "types.h"
+
+#include "amqp/schema/described-types/Schema.h"
+
+/******************************************************************************
+ *
+ * class PlanFile
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Reader plans saved by one process for the next to pick up.
+     *
+     * A plan is what a [CompositeFactory] needs to build the readers for a
+     * schema: its types, already in dependency order, flattened into a
+     * string of bytes. Rebuilding a schema from a plan needs neither
+     * proton nor the dependency sort, and the readers built from it are
+     * identical to those built from the schema that made it.
+     *
+     * Plans are stored keyed by the schema's fingerprint, as given by
+     * [ReaderCache], in a file that's mapped read only, so every process
+     * loading the same file shares one copy of it through the page cache.
+     *
+     * The file is
+     *
+     *     header : magic, format version, byte order, entry count and size
+     *     index  : an entry per plan ordered by the hash of its key, each
+     *              with the offset and length of its key and its plan and
+     *              a hash of the plan
+     *     data   : the keys and plans themselves
+     *
+     * A file that is truncated, damaged, from another byte order or written
+     * by any other version of the format is treated as empty, so changing the
+     * format, or a plan's encoding, means bumping [FORMAT_VERSION] and
+     * nothing more. Files are replaced by renaming a new one over them,
+     * so a mapped file never changes underneath its readers.
+     */
+    class PlanFile {
+        public :
+            static constexpr uint32_t FORMAT_VERSION { 1 };
+
+            using Plans = std::vector<std::pair<std::string_view, std::string_view>>;
+
+        private :
+            const char * m_base;
+            std::size_t  m_size;
+            std::size_t  m_count;
+
+            std::string_view at (uint64_t, uint64_t) const;
+
+        public :
+            /**
+             * A missing or unusable file leaves us empty
+             */
+            explicit PlanFile (const std::string & path_);
+            ~PlanFile();
+
+            PlanFile (const PlanFile &) = delete;
+
+            std::size_t size() const { return m_count; }
+
+            /**
+             * The plan saved under [key_], if there is one. Views into the
+             * mapped file so only good as long as we are.
+             */
+            std::optional<std::string_view> find (std::string_view key_) const;
+
+            /**
+             * Every key and plan in the file
+             */
+            Plans plans() const;
+
+            /**
+             * Replace whatever is at [path_] with [plans_]
+             */
+            static void write (const std::string & path_, const Plans & plans_);
+
+            static std::string encode (const schema::Schema &);
+
+            /**
+             * @throws std::runtime_error if [plan_] is malformed
+             */
+            static uPtr<schema::Schema> decode (std::string_view plan_);
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,155 @@
+#include "RawEnvelope.h"
+
+#include <cstdint>
+
+#include "amqp/schema/Descriptors.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * A big endian size of [width_] bytes at [p_], or nothing if it runs
+     * past the end
+     */
+    std::optional<uint64_t>
+    size (std::string_view bytes_, std::size_t p_, std::size_t width_) {
+        if (width_ > bytes_.size() || p_ > bytes_.size() - width_) {
+            return std::nullopt;
+        }
+
+        uint64_t rtn { 0 };
+        for (std::size_t i { 0 } ; i < width_ ; ++i) {
+            rtn = (rtn << 8) | static_cast<unsigned char>(bytes_[p_ + i]);
+        }
+
+        return rtn;
+    }
+
+    /**
+     * The offset just past the value starting at [p_], see section 1.2 of
+     * the AMQP 1.0 types specification for the constructor categories.
+     *
+     * A described type is its descriptor followed by its value, either
+     * of which may be described in turn, so rather than recurse we count
+     * the values still to step over. Only the bytes themselves bound how
+     * deeply they can nest.
+     */
+    std::optional<std::size_t>
+    skip (std::string_view bytes_, std::size_t p_) {
+        for (std::size_t pending { 1 } ; pending ; ) {
+            if (p_ >= bytes_.size()) {
+                return std::nullopt;
+            }
+
+            auto code = static_cast<unsigned char>(bytes_[p_++]);
+
+            if (code == 0x00) {
+                ++pending;
+                continue;
+            }
+
+            uint64_t length;
+
+            switch (code >> 4) {
+                case 0x4 : length = 0;  break;
+                case 0x5 : length = 1;  break;
+                case 0x6 : length = 2;  break;
+                case 0x7 : length = 4;  break;
+                case 0x8 : length = 8;  break;
+                case 0x9 : length = 16; break;
+                case 0xa :
+                case 0xc :
+                case 0xe : {
+                    auto s = size (bytes_, p_, 1);
+                    if (!s) return std::nullopt;
+                    length = 1 + *s;
+                    break;
+                }
+                case 0xb :
+                case 0xd :
+                case 0xf : {
+                    auto s = size (bytes_, p_, 4);
+                    if (!s) return std::nullopt;
+                    length = 4 + *s;
+                    break;
+                }
+                default :
+                    return std::nullopt;
+            }
+
+            if (length > bytes_.size() - p_) {
+                return std::nullopt;
+            }
+
+            p_ += length;
+            --pending;
+        }
+
+        return p_;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * An envelope is described by the Corda envelope descriptor and is a list
+ * of the value, the schema and, in newer blobs, the transforms
+ */
+std::optional<amqp::internal::RawEnvelope>
+amqp::internal::
+RawEnvelope::locate (std::string_view blob_) {
+    if (blob_.size() < 11
+        || blob_[0] != 0x00
+        || static_cast<unsigned char>(blob_[1]) != 0x80
+        || size (blob_, 2, 8) != (::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS
+                | static_cast<uint32_t>(::amqp::schema::descriptors::ENVELOPE)))
+    {
+        return std::nullopt;
+    }
+
+    std::size_t p { 10 };
+    std::size_t width;
+
+    switch (static_cast<unsigned char>(blob_[p])) {
+        case 0xc0 : width = 1; break;
+        case 0xd0 : width = 4; break;
+        default : return std::nullopt;
+    }
+
+    // anything trailing the envelope is left for the decoder to reject
+    auto end = skip (blob_, p);
+    auto count = size (blob_, p + 1 + width, width);
+
+    if (end != blob_.size() || !count || *count < 2) {
+        return std::nullopt;
+    }
+
+    auto value = p + 1 + 2 * width;
+    auto schema = skip (blob_, value);
+    auto schemaEnd = schema ? skip (blob_, *schema) : std::nullopt;
+
+    if (!schemaEnd || *schemaEnd > *end) {
+        return std::nullopt;
+    }
+
+    std::string_view transforms;
+    if (*count > 2) {
+        auto transformsEnd = skip (blob_, *schemaEnd);
+
+        if (!transformsEnd || *transformsEnd > *end) {
+            return std::nullopt;
+        }
+
+        transforms = blob_.substr (*schemaEnd, *transformsEnd - *schemaEnd);
+    }
+
+    return RawEnvelope {
+        blob_.substr (value, *schema - value),
+        blob_.substr (*schema, *schemaEnd - *schema),
+        transforms
+    };
+}
+
+/******************************************************************************/
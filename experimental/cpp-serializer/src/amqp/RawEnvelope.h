@@ -0,0 +1,43 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <optional>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * struct RawEnvelope
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Where a blob's value and schema are within its encoded bytes, found
+     * without decoding either of them.
+     *
+     * Every AMQP constructor says how long what follows it is, directly
+     * or through a size prefix, so stepping over a value, however deeply
+     * nested, only means looking at its first few bytes. Each section is
+     * itself a complete AMQP value that can be decoded on its own.
+     */
+    struct RawEnvelope {
+        std::string_view value;
+        std::string_view schema;
+
+        /**
+         * Empty if the blob predates them
+         */
+        std::string_view transforms;
+
+        /**
+         * @return nothing if [blob_] isn't an envelope we recognise, in
+         * which case it's left for the decoder to say what's wrong
+         */
+        static std::optional<RawEnvelope> locate (std::string_view blob_);
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,362 @@
+#include "ReaderCache.h"
+
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+
+#include "amqp/Hash.h"
+#include "amqp/Budget.h"
+#include "amqp/schema/descriptors/AMQPDescriptors.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::ReaderCache
+ *
+ ******************************************************************************/
+
+template<class E>
+amqp::internal::
+ReaderCache::Index<E>::Index (std::size_t capacity_) {
+    // we keep tables at most half full
+    std::size_t slots { 2 };
+    while (slots < capacity_ * 2) {
+        slots *= 2;
+    }
+
+    m_tables.emplace_back (std::make_unique<Table<E>> (slots));
+    m_table.store (m_tables.back().get(), std::memory_order_release);
+}
+
+/******************************************************************************/
+
+/**
+ * Linear probing, tables are never more than half full so there's always
+ * an empty slot to stop at
+ */
+template<class E>
+const E *
+amqp::internal::
+ReaderCache::Index<E>::find (
+    const Table<E> & table_,
+    std::string_view key_,
+    std::size_t hash_
+) {
+    auto mask = table_.slots.size() - 1;
+
+    for (auto i = hash_ & mask ; ; i = (i + 1) & mask) {
+        auto entry = table_.slots[i].load (std::memory_order_acquire);
+
+        if (!entry) {
+            return nullptr;
+        }
+
+        if (entry->hash == hash_ && entry->key == key_) {
+            return entry;
+        }
+    }
+}
+
+/******************************************************************************/
+
+template<class E>
+const E *
+amqp::internal::
+ReaderCache::Index<E>::find (std::string_view key_, std::size_t hash_) const {
+    return find (*m_table.load (std::memory_order_acquire), key_, hash_);
+}
+
+/******************************************************************************/
+
+template<class E>
+void
+amqp::internal::
+ReaderCache::Index<E>::place (Table<E> & table_, const E * entry_) {
+    auto mask = table_.slots.size() - 1;
+
+    for (auto i = entry_->hash & mask ; ; i = (i + 1) & mask) {
+        if (!table_.slots[i].load (std::memory_order_relaxed)) {
+            table_.slots[i].store (entry_, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+/******************************************************************************/
+
+template<class E>
+const E *
+amqp::internal::
+ReaderCache::Index<E>::insert (uPtr<const E> entry_) {
+    // we're the only writer so our own view of the table is current
+    auto table = m_tables.back().get();
+
+    if (auto entry = find (*table, entry_->key, entry_->hash)) {
+        return entry;
+    }
+
+    if ((m_entries.size() + 1) * 2 > table->slots.size()) {
+        m_tables.emplace_back (std::make_unique<Table<E>> (table->slots.size() * 2));
+        table = m_tables.back().get();
+
+        for (const auto & entry : m_entries) {
+            place (*table, entry.get());
+        }
+
+        m_table.store (table, std::memory_order_release);
+    }
+
+    m_entries.push_back (std::move (entry_));
+
+    place (*table, m_entries.back().get());
+
+    return m_entries.back().get();
+}
+
+/******************************************************************************/
+
+amqp::internal::
+ReaderCache::ReaderCache (
+    Validation validation_,
+    std::size_t capacity_,
+    const Evolution * evolution_
+) : m_validation (validation_)
+  , m_evolution (evolution_)
+  , m_factories (capacity_)
+  , m_sections (capacity_)
+{ }
+
+/******************************************************************************/
+
+/**
+ * The descriptors of every type in a schema, sorted so the order the
+ * schema happened to list them in doesn't matter
+ */
+std::string
+amqp::internal::
+ReaderCache::key (std::vector<std::string_view> descriptors_) {
+    std::sort (descriptors_.begin(), descriptors_.end());
+
+    std::size_t length { 0 };
+    for (const auto & descriptor : descriptors_) {
+        length += descriptor.size() + 1;
+    }
+
+    std::string rtn;
+    rtn.reserve (length);
+
+    for (const auto & descriptor : descriptors_) {
+        rtn += descriptor;
+        rtn += '\n';
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::
+ReaderCache::key (const schema::Schema & schema_) {
+    std::vector<std::string_view> descriptors;
+    descriptors.reserve (schema_.types().size());
+
+    for (const auto & type : schema_) {
+        descriptors.emplace_back (type.descriptor());
+    }
+
+    return key (std::move (descriptors));
+}
+
+/******************************************************************************/
+
+const amqp::internal::ReaderCache::Entry *
+amqp::internal::
+ReaderCache::insert (
+    std::string key_,
+    std::size_t hash_,
+    uPtr<const CompositeFactory> factory_,
+    std::string plan_
+) {
+    // aggregate initialised in place, its members are const so it can't
+    // be moved into make_unique
+    uPtr<const Entry> entry (
+        new Entry { std::move (key_), hash_, std::move (factory_), std::move (plan_) });
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_factories.insert (std::move (entry));
+}
+/******************************************************************************/
+
+const amqp::internal::CompositeFactory &
+amqp::internal::
+ReaderCache::factory (
+    const schema::ISchemaType & schema_,
+    const schema::Transforms * transforms_
+) {
+    auto indexed = dynamic_cast<const schema::IndexedSchema *>(&schema_);
+
+    auto k = indexed
+        ? key (indexed->descriptors())
+        : key (dynamic_cast<const schema::Schema &>(schema_));
+
+    auto hash = std::hash<std::string>{}(k);
+
+    if (auto entry = m_factories.find (k, hash)) {
+        return *entry->factory;
+    }
+
+    // only now do we need the schema's types, all of them and in order
+    uPtr<schema::Schema> materialised;
+    if (indexed) {
+        materialised = indexed->materialise();
+    }
+
+    const auto & schema = indexed
+        ? *materialised
+        : dynamic_cast<const schema::Schema &>(schema_);
+
+    // build outside the lock, it's by far the expensive part and we don't
+    // want other threads' new schemas queueing behind ours
+    auto factory = std::make_unique<CompositeFactory> (
+        m_validation, m_evolution, transforms_);
+    factory->process (schema);
+
+    auto plan = PlanFile::encode (schema);
+
+    return *insert (std::move (k), hash, std::move (factory), std::move (plan))->factory;
+}
+
+/******************************************************************************/
+
+std::size_t
+amqp::internal::
+ReaderCache::size() const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_factories.entries().size();
+}
+
+/******************************************************************************/
+
+std::size_t
+amqp::internal::
+ReaderCache::preload (const PlanFile & plans_) {
+    std::size_t rtn { 0 };
+
+    if (m_evolution) {
+        return rtn;
+    }
+
+    for (const auto & [ k, plan ] : plans_.plans()) {
+        std::string key { k };
+        auto hash = std::hash<std::string>{}(key);
+
+        if (m_factories.find (key, hash)) {
+            continue;
+        }
+
+        uPtr<schema::Schema> schema;
+        auto factory = std::make_unique<CompositeFactory> (m_validation);
+
+        try {
+            schema = PlanFile::decode (plan);
+
+            // a plan filed under the wrong key would hand out the wrong
+            // readers, not worth trusting the file that far
+            if (ReaderCache::key (*schema) != key) {
+                continue;
+            }
+
+            factory->process (*schema);
+        } catch (const std::exception &) {
+            continue;
+        }
+
+        insert (std::move (key), hash, std::move (factory), std::string (plan));
+        ++rtn;
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+ReaderCache::save (const std::string & path_) const {
+    PlanFile::Plans plans;
+
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+
+        plans.reserve (m_factories.entries().size());
+        for (const auto & entry : m_factories.entries()) {
+            plans.emplace_back (entry->key, entry->plan);
+        }
+    }
+
+    // entries are never freed so the views outlive the lock
+    PlanFile::write (path_, plans);
+}
+
+/******************************************************************************/
+
+const amqp::internal::SchemaSection &
+amqp::internal::
+ReaderCache::section (
+    std::string_view bytes_,
+    std::string_view transforms_,
+    const Limits & limits_
+) {
+    auto hash = static_cast<std::size_t>(xxh64 (bytes_));
+
+    if (auto section = m_sections.find (bytes_, hash)) {
+        return *section;
+    }
+
+    Budget budget (limits_);
+    Budget::Scope scope (budget);
+    Budget::bytes (bytes_.size() + transforms_.size());
+
+    // checks it's a schema at all, and whatever a blob's value is checked
+    // against from now on
+    auto verifier = std::make_unique<const Verifier::Schema> (bytes_, limits_);
+
+    auto schema = schema::descriptors::decodeDescribed<schema::Schema> (bytes_);
+
+    uPtr<schema::Transforms> transforms;
+    if (m_evolution && !transforms_.empty()) {
+        transforms = schema::descriptors::decodeDescribed<schema::Transforms> (
+            transforms_);
+    }
+
+    const auto & factory = this->factory (*schema, transforms.get());
+
+    // the readers are built so all we need keep of the schema is what
+    // it'd take to build it again
+    uPtr<const SchemaSection> section (
+        new SchemaSection {
+            std::string (bytes_),
+            hash,
+            std::move (verifier),
+            std::make_unique<const schema::FlatSchema> (*schema),
+            factory });
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return *m_sections.insert (std::move (section));
+}
+
+/******************************************************************************/
+
+std::size_t
+amqp::internal::
+ReaderCache::sections() const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_sections.entries().size();
+}
+
+/******************************************************************************/
@@ -0,0 +1,245 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <memory>
+#include <string_view>
+
+#include "types.h"
+
+#include "amqp/PlanFile.h"
+#include "amqp/Verifier.h"
+#include "amqp/Evolution.h"
+#include "amqp/Validation.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/schema/described-types/Schema.h"
+#include "amqp/schema/described-types/FlatSchema.h"
+#include "amqp/schema/described-types/IndexedSchema.h"
+
+/******************************************************************************
+ *
+ * class ReaderCache
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * What a schema section we've seen before decodes to. Everything a
+     * blob carrying exactly these bytes as its schema needs to be checked
+     * and dumped without its schema being decoded again, packed down as
+     * there may be thousands of these held for the life of the process.
+     */
+    struct SchemaSection {
+        const std::string                    key;
+        const std::size_t                    hash;
+        const uPtr<const Verifier::Schema>   verifier;
+        const uPtr<const schema::FlatSchema> schema;
+        const CompositeFactory &             factory;
+    };
+
+    /**
+     * Factories, and with them their readers, kept from one blob to the next
+     * so a schema we've already seen costs a lookup rather than a rebuild.
+     *
+     * A schema is identified by the descriptors of the types it holds. Corda
+     * derives those from the shape of each type, fields and all, so two
+     * schemas describing the same types produce the same readers.
+     *
+     * Ahead of that, schema sections are remembered by their raw bytes, a
+     * blob whose section we've already seen byte for byte need not decode
+     * it at all, let alone index or verify it.
+     *
+     * Meant to be shared by every thread decoding in a process, which all
+     * look up on every blob, so lookups take no locks and never wait. The
+     * tables they probe are only ever added to, an entry once published is
+     * never changed or freed, and growing a table publishes a bigger copy,
+     * leaving the old one for any thread still probing it. Inserts are
+     * serialised by a mutex that lookups never touch.
+     *
+     * The factories are fully processed before they're published so, as
+     * the [ICompositeFactory] contract requires, nothing ever modifies them
+     * once another thread can see them.
+     *
+     * Given an [Evolution] every factory reads blobs as the types it
+     * expects. A blob's transforms are only looked at when its schema is
+     * first seen, Corda derives them from the same classes it derives the
+     * fingerprints from so a schema always travels with the same ones.
+     *
+     * Must outlive every decode using it.
+     */
+    class ReaderCache {
+        private :
+            struct Entry {
+                const std::string                  key;
+                const std::size_t                  hash;
+                const uPtr<const CompositeFactory> factory;
+                const std::string                  plan;
+            };
+
+            template<class E>
+            struct Table {
+                std::vector<std::atomic<const E *>> slots;
+
+                explicit Table (std::size_t capacity_)
+                    : slots (capacity_)
+                { }
+            };
+
+            /**
+             * A table of [E]s, which need a [key] and its [hash], that
+             * grows as they're added
+             */
+            template<class E>
+            class Index {
+                private :
+                    std::atomic<const Table<E> *> m_table;
+
+                    /**
+                     * Only touched with the cache's mutex held
+                     */
+                    std::vector<uPtr<const E>> m_entries;
+
+                    /**
+                     * Every table we've ever published, readers may still
+                     * be probing the older ones. Each is twice the size of
+                     * the one before so together they're smaller than the
+                     * current one.
+                     */
+                    std::vector<uPtr<Table<E>>> m_tables;
+
+                    static const E * find (
+                        const Table<E> &,
+                        std::string_view,
+                        std::size_t);
+
+                    static void place (Table<E> &, const E *);
+
+                public :
+                    explicit Index (std::size_t capacity_);
+
+                    const E * find (std::string_view, std::size_t) const;
+
+                    /**
+                     * Must be called with the cache's mutex held
+                     *
+                     * @return whichever entry ends up under [entry_]'s key,
+                     * which is an earlier one if it beat us to it
+                     */
+                    const E * insert (uPtr<const E> entry_);
+
+                    const std::vector<uPtr<const E>> & entries() const {
+                        return m_entries;
+                    }
+            };
+
+            const Validation m_validation;
+
+            /**
+             * Not owned, nullptr if blobs are read as written
+             */
+            const Evolution * m_evolution;
+
+            /**
+             * Inserts into either index are only made with this held
+             */
+            mutable std::mutex m_mutex;
+
+            Index<Entry>         m_factories;
+            Index<SchemaSection> m_sections;
+
+            static std::string key (std::vector<std::string_view>);
+            static std::string key (const schema::Schema &);
+
+            const Entry * insert (
+                std::string,
+                std::size_t,
+                uPtr<const CompositeFactory>,
+                std::string);
+
+        public :
+            /**
+             * @param capacity_ how many schemas to make room for before
+             * we first have to grow, rounded up to a power of two
+             * @param evolution_ the types to read blobs as, must outlive us
+             */
+            explicit ReaderCache (
+                Validation validation_ = Validation::Strict,
+                std::size_t capacity_ = 32,
+                const Evolution * evolution_ = nullptr);
+
+            ReaderCache (const ReaderCache &) = delete;
+
+            /**
+             * The factory for [schema_], built and remembered the first
+             * time we see it. Two threads seeing a new schema at once may
+             * both build it, only one is kept.
+             *
+             * An [IndexedSchema] is only built if we don't already have
+             * its factory.
+             *
+             * @param transforms_ those of the blob [schema_] came from, only
+             * needed if we're evolving
+             */
+            const CompositeFactory & factory (
+                const schema::ISchemaType & schema_,
+                const schema::Transforms * transforms_ = nullptr);
+
+            /**
+             * How many schemas we're holding factories for
+             */
+            std::size_t size() const;
+
+            /**
+             * What the schema section [bytes_] decodes to, decoded, checked
+             * and remembered the first time we see those bytes. Sections
+             * that differ only in their bytes still share their factory.
+             *
+             * @param transforms_ the raw transforms section that came with
+             * it, if any
+             *
+             * Decoding a section we haven't seen is charged to [limits_],
+             * those of the blob it came in
+             *
+             * @throws std::runtime_error if [bytes_] isn't a schema we can
+             * build readers from
+             */
+            const SchemaSection & section (
+                std::string_view bytes_,
+                std::string_view transforms_ = { },
+                const Limits & limits_ = Limits());
+
+            /**
+             * How many distinct schema sections we've seen
+             */
+            std::size_t sections() const;
+
+            Validation validation() const { return m_validation; }
+
+            /**
+             * Build the factories for every plan in [plans_] we don't
+             * already have, skipping any that don't decode. Meant to be
+             * called before decoding starts so the first blob of each
+             * schema seen before is as cheap as the rest.
+             *
+             * Plans don't record transforms so there's nothing we can
+             * preload if we're evolving.
+             *
+             * @return how many were added
+             */
+            std::size_t preload (const PlanFile & plans_);
+
+            /**
+             * Write the plans for everything we hold to [path_] for a
+             * later process to [preload]
+             */
+            void save (const std::string & path_) const;
+    };
+
+}
+
+/******************************************************************************/
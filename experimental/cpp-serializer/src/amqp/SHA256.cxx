@@ -0,0 +1,459 @@
+#include "SHA256.h"
+
+#include <cstring>
+#include <algorithm>
+
+#ifdef AMQP_X86
+#include <immintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    using amqp::internal::sha256::Digest;
+    using amqp::internal::sha256::Engine;
+
+    constexpr uint32_t IV[8] = { // NOLINT
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    alignas (16) constexpr uint32_t K[64] = { // NOLINT
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+        0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+        0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+        0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+        0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+        0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+        0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+        0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+        0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    inline uint32_t
+    be32 (const uint8_t * p_) {
+        return static_cast<uint32_t>(p_[0]) << 24
+            | static_cast<uint32_t>(p_[1]) << 16
+            | static_cast<uint32_t>(p_[2]) << 8
+            | static_cast<uint32_t>(p_[3]);
+    }
+
+    inline void
+    put32 (uint8_t * p_, uint32_t v_) {
+        p_[0] = static_cast<uint8_t>(v_ >> 24);
+        p_[1] = static_cast<uint8_t>(v_ >> 16);
+        p_[2] = static_cast<uint8_t>(v_ >> 8);
+        p_[3] = static_cast<uint8_t>(v_);
+    }
+
+    /**
+     * The padded end of a message, the last partial block, the 0x80
+     * marker and the length in bits, one or two blocks of it
+     */
+    struct Tail {
+        uint8_t     bytes[128];
+        std::size_t blocks;
+
+        explicit Tail (std::string_view message_) : bytes { } {
+            auto rest = message_.size() % 64;
+
+            std::memcpy (bytes, message_.data() + message_.size() - rest, rest);
+            bytes[rest] = 0x80;
+
+            blocks = rest + 9 > 64 ? 2 : 1;
+
+            uint64_t bits = static_cast<uint64_t>(message_.size()) * 8;
+            put32 (bytes + 64 * blocks - 8, static_cast<uint32_t>(bits >> 32));
+            put32 (bytes + 64 * blocks - 4, static_cast<uint32_t>(bits));
+        }
+    };
+
+    Digest
+    digest (const uint32_t (&state_)[8]) {
+        Digest rtn;
+        for (int i { 0 } ; i < 8 ; ++i) {
+            put32 (rtn.data() + 4 * i, state_[i]);
+        }
+
+        return rtn;
+    }
+
+    /**
+     * A message is its whole blocks, read where they lie, then its tail
+     */
+    template<void (*compress_)(uint32_t *, const uint8_t *, std::size_t)>
+    Digest
+    single (std::string_view message_) {
+        uint32_t state[8];
+        std::copy (std::begin (IV), std::end (IV), state);
+
+        compress_ (
+            state,
+            reinterpret_cast<const uint8_t *>(message_.data()),
+            message_.size() / 64);
+
+        Tail tail (message_);
+        compress_ (state, tail.bytes, tail.blocks);
+
+        return digest (state);
+    }
+
+    /**************************************************************************
+     *
+     * Portable
+     *
+     **************************************************************************/
+
+    inline uint32_t
+    rotr (uint32_t x_, int n_) {
+        return (x_ >> n_) | (x_ << (32 - n_));
+    }
+
+    void
+    compressScalar (uint32_t * state_, const uint8_t * data_, std::size_t blocks_) {
+        uint32_t w[64];
+
+        for ( ; blocks_ ; --blocks_, data_ += 64) {
+            for (int t { 0 } ; t < 16 ; ++t) {
+                w[t] = be32 (data_ + 4 * t);
+            }
+
+            for (int t { 16 } ; t < 64 ; ++t) {
+                auto s0 = rotr (w[t - 15], 7) ^ rotr (w[t - 15], 18) ^ (w[t - 15] >> 3);
+                auto s1 = rotr (w[t - 2], 17) ^ rotr (w[t - 2], 19) ^ (w[t - 2] >> 10);
+                w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+            }
+
+            auto a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+            auto e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+
+            for (int t { 0 } ; t < 64 ; ++t) {
+                auto t1 = h + (rotr (e, 6) ^ rotr (e, 11) ^ rotr (e, 25))
+                    + ((e & f) ^ (~e & g)) + K[t] + w[t];
+                auto t2 = (rotr (a, 2) ^ rotr (a, 13) ^ rotr (a, 22))
+                    + ((a & b) ^ (a & c) ^ (b & c));
+
+                h = g; g = f; f = e; e = d + t1;
+                d = c; c = b; b = a; a = t1 + t2;
+            }
+
+            state_[0] += a; state_[1] += b; state_[2] += c; state_[3] += d;
+            state_[4] += e; state_[5] += f; state_[6] += g; state_[7] += h;
+        }
+    }
+
+#ifdef AMQP_X86
+
+    /**************************************************************************
+     *
+     * SHA extensions, four rounds an instruction pair
+     *
+     **************************************************************************/
+
+    __attribute__ ((target ("sha,sse4.1")))
+    void
+    compressSHANI (uint32_t * state_, const uint8_t * data_, std::size_t blocks_) {
+        const __m128i order = _mm_set_epi64x (
+            0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+        // the instructions want the state as ABEF and CDGH
+        auto tmp = _mm_shuffle_epi32 (
+            _mm_loadu_si128 (reinterpret_cast<const __m128i *>(state_)), 0xB1);
+        auto state1 = _mm_shuffle_epi32 (
+            _mm_loadu_si128 (reinterpret_cast<const __m128i *>(state_ + 4)), 0x1B);
+        auto state0 = _mm_alignr_epi8 (tmp, state1, 8);
+        state1 = _mm_blend_epi16 (state1, tmp, 0xF0);
+
+        for ( ; blocks_ ; --blocks_, data_ += 64) {
+            auto abef = state0;
+            auto cdgh = state1;
+
+            __m128i msg[4];
+
+            for (int i { 0 } ; i < 16 ; ++i) {
+                auto & current = msg[i & 3];
+
+                if (i < 4) {
+                    current = _mm_shuffle_epi8 (
+                        _mm_loadu_si128 (reinterpret_cast<const __m128i *>(data_ + 16 * i)),
+                        order);
+                }
+
+                auto m = _mm_add_epi32 (
+                    current, _mm_load_si128 (reinterpret_cast<const __m128i *>(K + 4 * i)));
+
+                state1 = _mm_sha256rnds2_epu32 (state1, state0, m);
+
+                if (i >= 3 && i < 15) {
+                    auto & next = msg[(i + 1) & 3];
+                    next = _mm_add_epi32 (next, _mm_alignr_epi8 (current, msg[(i + 3) & 3], 4));
+                    next = _mm_sha256msg2_epu32 (next, current);
+                }
+
+                state0 = _mm_sha256rnds2_epu32 (state0, state1, _mm_shuffle_epi32 (m, 0x0E));
+
+                if (i >= 1 && i < 13) {
+                    auto & previous = msg[(i + 3) & 3];
+                    previous = _mm_sha256msg1_epu32 (previous, current);
+                }
+            }
+
+            state0 = _mm_add_epi32 (state0, abef);
+            state1 = _mm_add_epi32 (state1, cdgh);
+        }
+
+        tmp = _mm_shuffle_epi32 (state0, 0x1B);
+        state1 = _mm_shuffle_epi32 (state1, 0xB1);
+        state0 = _mm_blend_epi16 (tmp, state1, 0xF0);
+        state1 = _mm_alignr_epi8 (state1, tmp, 8);
+
+        _mm_storeu_si128 (reinterpret_cast<__m128i *>(state_), state0);
+        _mm_storeu_si128 (reinterpret_cast<__m128i *>(state_ + 4), state1);
+    }
+
+    /**************************************************************************
+     *
+     * AVX2, eight messages at once, one to a lane
+     *
+     **************************************************************************/
+
+    template<int n_>
+    __attribute__ ((target ("avx2"))) inline __m256i
+    rotr8 (__m256i x_) {
+        return _mm256_or_si256 (_mm256_srli_epi32 (x_, n_), _mm256_slli_epi32 (x_, 32 - n_));
+    }
+
+    __attribute__ ((target ("avx2"))) inline __m256i
+    add8 (__m256i a_, __m256i b_) {
+        return _mm256_add_epi32 (a_, b_);
+    }
+
+    /**
+     * One block from each lane, the lanes [active_] doesn't have set
+     * being left as they were
+     */
+    __attribute__ ((target ("avx2")))
+    void
+    compress8 (__m256i * state_, __m256i * w_, __m256i active_) {
+        auto a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+        auto e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+
+        for (int t { 0 } ; t < 64 ; ++t) {
+            if (t >= 16) {
+                auto w15 = w_[(t - 15) & 15];
+                auto w2 = w_[(t - 2) & 15];
+
+                auto s0 = _mm256_xor_si256 (
+                    _mm256_xor_si256 (rotr8<7> (w15), rotr8<18> (w15)),
+                    _mm256_srli_epi32 (w15, 3));
+                auto s1 = _mm256_xor_si256 (
+                    _mm256_xor_si256 (rotr8<17> (w2), rotr8<19> (w2)),
+                    _mm256_srli_epi32 (w2, 10));
+
+                w_[t & 15] = add8 (add8 (w_[t & 15], s0), add8 (w_[(t - 7) & 15], s1));
+            }
+
+            auto S1 = _mm256_xor_si256 (
+                _mm256_xor_si256 (rotr8<6> (e), rotr8<11> (e)), rotr8<25> (e));
+            auto ch = _mm256_xor_si256 (
+                _mm256_and_si256 (e, f), _mm256_andnot_si256 (e, g));
+            auto t1 = add8 (
+                add8 (add8 (h, S1), add8 (ch, _mm256_set1_epi32 (static_cast<int>(K[t])))),
+                w_[t & 15]);
+
+            auto S0 = _mm256_xor_si256 (
+                _mm256_xor_si256 (rotr8<2> (a), rotr8<13> (a)), rotr8<22> (a));
+            auto maj = _mm256_xor_si256 (
+                _mm256_xor_si256 (_mm256_and_si256 (a, b), _mm256_and_si256 (a, c)),
+                _mm256_and_si256 (b, c));
+            auto t2 = add8 (S0, maj);
+
+            h = g; g = f; f = e; e = add8 (d, t1);
+            d = c; c = b; b = a; a = add8 (t1, t2);
+        }
+
+        const __m256i worked[8] = { a, b, c, d, e, f, g, h };
+
+        for (int i { 0 } ; i < 8 ; ++i) {
+            state_[i] = _mm256_blendv_epi8 (state_[i], add8 (state_[i], worked[i]), active_);
+        }
+    }
+
+    /**
+     * Up to eight messages, any lanes beyond [count_] just idle. Each
+     * lane runs for as many blocks as its message needs.
+     */
+    __attribute__ ((target ("avx2")))
+    void
+    lanes (const std::string_view * messages_, std::size_t count_, Digest * out_) {
+        struct Lane {
+            const uint8_t * data  { nullptr };
+            std::size_t     whole { 0 };
+            std::size_t     blocks { 0 };
+        };
+
+        Lane lane[8];
+        alignas (32) uint8_t tails[8][128] { };
+        alignas (32) uint32_t blocks[8] { };
+
+        std::size_t rounds { 0 };
+
+        for (std::size_t l { 0 } ; l < count_ ; ++l) {
+            Tail tail (messages_[l]);
+            std::memcpy (tails[l], tail.bytes, sizeof (tail.bytes));
+
+            lane[l].data = reinterpret_cast<const uint8_t *>(messages_[l].data());
+            lane[l].whole = messages_[l].size() / 64;
+            lane[l].blocks = lane[l].whole + tail.blocks;
+
+            blocks[l] = static_cast<uint32_t>(lane[l].blocks);
+            rounds = std::max (rounds, lane[l].blocks);
+        }
+
+        __m256i state[8];
+        for (int i { 0 } ; i < 8 ; ++i) {
+            state[i] = _mm256_set1_epi32 (static_cast<int>(IV[i]));
+        }
+
+        const auto remaining = _mm256_load_si256 (reinterpret_cast<const __m256i *>(blocks));
+
+        alignas (32) uint32_t words[16][8];
+        __m256i w[16];
+
+        for (std::size_t r { 0 } ; r < rounds ; ++r) {
+            for (std::size_t l { 0 } ; l < 8 ; ++l) {
+                const uint8_t * block = tails[l];
+
+                if (r < lane[l].whole) {
+                    block = lane[l].data + 64 * r;
+                } else if (r < lane[l].blocks) {
+                    block = tails[l] + 64 * (r - lane[l].whole);
+                }
+
+                for (int j { 0 } ; j < 16 ; ++j) {
+                    words[j][l] = be32 (block + 4 * j);
+                }
+            }
+
+            for (int j { 0 } ; j < 16 ; ++j) {
+                w[j] = _mm256_load_si256 (reinterpret_cast<const __m256i *>(words[j]));
+            }
+
+            compress8 (
+                state, w,
+                _mm256_cmpgt_epi32 (remaining, _mm256_set1_epi32 (static_cast<int>(r))));
+        }
+
+        alignas (32) uint32_t result[8][8];
+        for (int i { 0 } ; i < 8 ; ++i) {
+            _mm256_store_si256 (reinterpret_cast<__m256i *>(result[i]), state[i]);
+        }
+
+        for (std::size_t l { 0 } ; l < count_ ; ++l) {
+            for (int i { 0 } ; i < 8 ; ++i) {
+                put32 (out_[l].data() + 4 * i, result[i][l]);
+            }
+        }
+    }
+
+#endif
+
+    /**
+     * [engine_] as it'll hash one message or, if [several_], more.
+     * Eight lanes at once still beat the extensions doing one at a time,
+     * but only if there are several to fill them.
+     */
+    Engine
+    resolve (Engine engine_, bool several_) {
+        using namespace amqp::internal;
+
+        static const Engine one = cpu::best ({ Engine::SHANI });
+        static const Engine many = cpu::best (sha256::KERNELS);
+
+        if (engine_ == Engine::Best) {
+            return several_ ? many : one;
+        }
+
+        return cpu::resolve (engine_, sha256::KERNELS, "SHA-256");
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::sha256
+ *
+ ******************************************************************************/
+
+amqp::internal::sha256::Digest
+amqp::internal::sha256::
+hash (std::string_view message_, Engine engine_) {
+    engine_ = resolve (engine_, false);
+
+    switch (engine_) {
+#ifdef AMQP_X86
+        case Engine::SHANI : return single<compressSHANI> (message_);
+        case Engine::AVX2  : {
+            Digest rtn;
+            lanes (&message_, 1, &rtn);
+            return rtn;
+        }
+#endif
+        default : return single<compressScalar> (message_);
+    }
+}
+
+/******************************************************************************/
+
+std::vector<amqp::internal::sha256::Digest>
+amqp::internal::sha256::
+hash (const std::vector<std::string_view> & messages_, Engine engine_) {
+    engine_ = resolve (engine_, messages_.size() > 1);
+
+    std::vector<Digest> rtn (messages_.size());
+
+#ifdef AMQP_X86
+    if (engine_ == Engine::AVX2) {
+        for (std::size_t i { 0 } ; i < messages_.size() ; i += 8) {
+            lanes (
+                messages_.data() + i,
+                std::min<std::size_t> (8, messages_.size() - i),
+                rtn.data() + i);
+        }
+
+        return rtn;
+    }
+#endif
+
+    std::transform (
+        messages_.begin(), messages_.end(), rtn.begin(),
+        [engine_](std::string_view message_) { return hash (message_, engine_); });
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::sha256::
+toString (const Digest & digest_) {
+    static const char hex[] = "0123456789ABCDEF";
+
+    std::string rtn (digest_.size() * 2, '0');
+    for (std::size_t i { 0 } ; i < digest_.size() ; ++i) {
+        rtn[2 * i]     = hex[digest_[i] >> 4];
+        rtn[2 * i + 1] = hex[digest_[i] & 0xF];
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
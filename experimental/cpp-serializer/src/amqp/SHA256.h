@@ -0,0 +1,44 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include "amqp/Cpu.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::sha256 {
+
+    using Digest = std::array<uint8_t, 32>;
+
+    using cpu::Engine;
+
+    /**
+     * What can do the hashing. Several messages are hashed eight at once
+     * in parallel AVX2 lanes, a single message with the SHA extensions,
+     * so which is best depends on how many there are.
+     */
+    constexpr cpu::Kernels KERNELS { Engine::AVX2, Engine::SHANI };
+
+    Digest hash (std::string_view, Engine = Engine::Best);
+
+    /**
+     * Hash each of [messages_], several at once where the engine can
+     */
+    std::vector<Digest> hash (
+        const std::vector<std::string_view> & messages_,
+        Engine = Engine::Best);
+
+    /**
+     * Upper case hex, as Corda prints a SecureHash
+     */
+    std::string toString (const Digest &);
+
+}
+
+/******************************************************************************/
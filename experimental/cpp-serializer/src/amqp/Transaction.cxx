@@ -0,0 +1,200 @@
+#include "Transaction.h"
+
+#include <map>
+#include <array>
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "amqp/Nested.h"
+#include "amqp/AMQPHeader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using amqp::internal::sha256::Digest;
+    using amqp::internal::sha256::Engine;
+
+    /**
+     * Corda has a dozen or so, anything far beyond that is a blob out to
+     * have us build an enormous tree
+     */
+    constexpr int32_t MAX_GROUP { 1024 };
+
+    std::string_view
+    view (const Digest & digest_) {
+        return { reinterpret_cast<const char *>(digest_.data()), digest_.size() };
+    }
+
+    std::string_view
+    view (const amqp::internal::binding::Bytes & bytes_) {
+        return { reinterpret_cast<const char *>(bytes_.data()), bytes_.size() };
+    }
+
+    /**
+     * Corda hashes its nonces and components twice over
+     */
+    std::vector<Digest>
+    twice (const std::vector<std::string> & messages_, Engine engine_) {
+        std::vector<std::string_view> views (messages_.begin(), messages_.end());
+
+        auto once = amqp::internal::sha256::hash (views, engine_);
+
+        std::transform (
+            once.begin(), once.end(), views.begin(),
+            [](const Digest & digest_) { return view (digest_); });
+
+        return amqp::internal::sha256::hash (views, engine_);
+    }
+
+    void
+    append32 (std::string & out_, int32_t value_) {
+        auto v = static_cast<uint32_t>(value_);
+        for (int shift { 24 } ; shift >= 0 ; shift -= 8) {
+            out_ += static_cast<char>((v >> shift) & 0xffU);
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::transaction
+ *
+ ******************************************************************************/
+
+amqp::internal::sha256::Digest
+amqp::internal::transaction::
+merkleRoot (std::vector<sha256::Digest> leaves_, sha256::Engine engine_) {
+    if (leaves_.empty()) {
+        throw std::runtime_error ("A Merkle tree needs at least one leaf");
+    }
+
+    std::size_t width { 1 };
+    while (width < leaves_.size()) {
+        width <<= 1U;
+    }
+
+    leaves_.resize (width, sha256::Digest { });
+
+    std::vector<std::array<char, 64>> pairs;
+    std::vector<std::string_view> views;
+
+    while (leaves_.size() > 1) {
+        pairs.resize (leaves_.size() / 2);
+        views.resize (pairs.size());
+
+        for (std::size_t i { 0 } ; i < pairs.size() ; ++i) {
+            std::memcpy (pairs[i].data(), leaves_[2 * i].data(), 32);
+            std::memcpy (pairs[i].data() + 32, leaves_[2 * i + 1].data(), 32);
+            views[i] = std::string_view (pairs[i].data(), pairs[i].size());
+        }
+
+        leaves_ = sha256::hash (views, engine_);
+    }
+
+    return leaves_.front();
+}
+
+/******************************************************************************/
+
+amqp::internal::sha256::Digest
+amqp::internal::transaction::
+id (const WireTransaction & tx_, sha256::Engine engine_) {
+    const auto & salt = tx_.privacySalt.bytes;
+
+    if (salt.size() != 32) {
+        throw std::runtime_error ("A privacy salt must be 32 bytes");
+    }
+
+    if (tx_.componentGroups.empty()) {
+        throw std::runtime_error ("A transaction needs component groups");
+    }
+
+    // every nonce is the salt followed by the component's group and its
+    // index within it
+    std::vector<std::string> nonces;
+
+    for (const auto & group : tx_.componentGroups) {
+        if (group.groupIndex < 0
+            || group.groupIndex > MAX_GROUP
+            || group.components.empty()
+        ) {
+            throw std::runtime_error ("Malformed component group");
+        }
+
+        for (std::size_t i { 0 } ; i < group.components.size() ; ++i) {
+            auto & nonce = nonces.emplace_back (view (salt));
+            append32 (nonce, group.groupIndex);
+            append32 (nonce, static_cast<int32_t>(i));
+        }
+    }
+
+    auto nonceHashes = twice (nonces, engine_);
+
+    std::vector<std::string> components;
+    components.reserve (nonceHashes.size());
+
+    auto nonce = nonceHashes.begin();
+    for (const auto & group : tx_.componentGroups) {
+        for (const auto & component : group.components) {
+            auto & salted = components.emplace_back (view (*nonce++));
+            salted.append (view (component.bytes));
+        }
+    }
+
+    auto componentHashes = twice (components, engine_);
+
+    std::map<int32_t, sha256::Digest> roots;
+
+    auto hash = componentHashes.begin();
+    for (const auto & group : tx_.componentGroups) {
+        std::vector<sha256::Digest> leaves (hash, hash + group.components.size());
+        hash += group.components.size();
+
+        if (!roots.emplace (group.groupIndex, merkleRoot (std::move (leaves), engine_)).second) {
+            throw std::runtime_error ("Duplicate component group");
+        }
+    }
+
+    sha256::Digest allOnes;
+    allOnes.fill (0xff);
+
+    std::vector<sha256::Digest> groups (roots.rbegin()->first + 1, allOnes);
+    for (const auto & [ index, root ] : roots) {
+        groups[index] = root;
+    }
+
+    return merkleRoot (std::move (groups), engine_);
+}
+
+/******************************************************************************/
+
+amqp::internal::sha256::Digest
+amqp::internal::transaction::
+id (
+    std::string_view blob_,
+    const binding::Binder & binder_,
+    ReaderCache & cache_
+) {
+    auto signedTx = binder_.decode<SignedTransaction> (blob_, cache_);
+
+    if (!signedTx.txBits.bytes.empty()) {
+        auto bits = view (signedTx.txBits.bytes);
+
+        if (!Nested::isBlob (bits)) {
+            throw std::runtime_error ("A signed transaction's bits must be a blob");
+        }
+
+        // only ever a WireTransaction, one signed transaction wrapping
+        // another isn't something Corda writes
+        return id (binder_.decode<WireTransaction> (
+            bits.substr (amqp::AMQP_HEADER.size() + 1), cache_));
+    }
+
+    return id (binder_.decode<WireTransaction> (blob_, cache_));
+}
+
+/******************************************************************************/
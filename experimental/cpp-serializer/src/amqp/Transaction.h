@@ -0,0 +1,110 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include "amqp/Binding.h"
+#include "amqp/SHA256.h"
+
+/******************************************************************************
+ *
+ * Corda transactions
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::transaction {
+
+    /**
+     * Any of the types Corda keeps a run of bytes in, PrivacySalt and
+     * SerializedBytes included
+     */
+    struct OpaqueBytes {
+        binding::Bytes bytes;
+    };
+
+    /**
+     * Each component is itself a serialised blob
+     */
+    struct ComponentGroup {
+        int32_t                  groupIndex { 0 };
+        std::vector<OpaqueBytes> components;
+    };
+
+    /**
+     * Only what the id is computed from
+     */
+    struct WireTransaction {
+        std::vector<ComponentGroup> componentGroups;
+        OpaqueBytes                 privacySalt;
+    };
+
+    struct SignedTransaction {
+        OpaqueBytes txBits;
+    };
+
+}
+
+/******************************************************************************/
+
+AMQP_BINDING (amqp::internal::transaction::OpaqueBytes,
+    "net.corda.core.utilities.OpaqueBytes",
+    AMQP_MEMBER (amqp::internal::transaction::OpaqueBytes, bytes))
+
+AMQP_BINDING (amqp::internal::transaction::ComponentGroup,
+    "net.corda.core.transactions.ComponentGroup",
+    AMQP_MEMBER (amqp::internal::transaction::ComponentGroup, groupIndex),
+    AMQP_MEMBER (amqp::internal::transaction::ComponentGroup, components))
+
+AMQP_BINDING (amqp::internal::transaction::WireTransaction,
+    "net.corda.core.transactions.WireTransaction",
+    AMQP_MEMBER (amqp::internal::transaction::WireTransaction, componentGroups),
+    AMQP_MEMBER (amqp::internal::transaction::WireTransaction, privacySalt))
+
+AMQP_BINDING (amqp::internal::transaction::SignedTransaction,
+    "net.corda.core.transactions.SignedTransaction",
+    AMQP_MEMBER (amqp::internal::transaction::SignedTransaction, txBits))
+
+/******************************************************************************/
+
+namespace amqp::internal::transaction {
+
+    /**
+     * Corda's Merkle tree root. The leaves are padded with zero hashes
+     * to a power of two and each node is the hash of its children's
+     * hashes concatenated, every level's nodes being hashed together.
+     *
+     * @throws std::runtime_error if there are no leaves
+     */
+    sha256::Digest merkleRoot (
+        std::vector<sha256::Digest> leaves_,
+        sha256::Engine = sha256::Engine::Best);
+
+    /**
+     * The id of [tx_], the root of the tree over its component groups,
+     * each group the root of the tree over its components. Every
+     * component is salted with a nonce derived from the privacy salt and
+     * its place in the transaction, groups it doesn't have below its
+     * highest count as the all ones hash.
+     *
+     * Every component and nonce in the transaction is hashed at once.
+     */
+    sha256::Digest id (
+        const WireTransaction & tx_,
+        sha256::Engine = sha256::Engine::Best);
+
+    /**
+     * The id of the transaction in [blob_], a Corda blob without its
+     * header holding either a WireTransaction or a SignedTransaction
+     * wrapping one, throws if a SignedTransaction wraps anything else
+     */
+    sha256::Digest id (
+        std::string_view blob_,
+        const binding::Binder &,
+        ReaderCache &);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,798 @@
+#include "Verifier.h"
+
+#include <memory>
+#include <stdexcept>
+
+#include "amqp/schema/Descriptors.h"
+#include "amqp/schema/field-types/Field.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+#include "amqp/reader/PropertyReader.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::Verifier::AutoCrumb
+ *
+ ******************************************************************************/
+
+amqp::internal::
+Verifier::AutoCrumb::AutoCrumb (
+    std::vector<Crumb> & path_,
+    std::string_view name_
+) : m_path (path_) {
+    m_path.push_back ({ name_, 0 });
+}
+
+/******************************************************************************/
+
+amqp::internal::
+Verifier::AutoCrumb::AutoCrumb (
+    std::vector<Crumb> & path_,
+    std::size_t index_
+) : m_path (path_) {
+    m_path.push_back ({ { }, index_ });
+}
+
+/******************************************************************************/
+
+amqp::internal::
+Verifier::AutoCrumb::~AutoCrumb() {
+    m_path.pop_back();
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::Verifier::AutoDepth
+ *
+ ******************************************************************************/
+
+amqp::internal::
+Verifier::AutoDepth::AutoDepth (std::size_t & depth_)
+    : m_depth (depth_)
+{
+    ++m_depth;
+}
+
+/******************************************************************************/
+
+amqp::internal::
+Verifier::AutoDepth::~AutoDepth() {
+    --m_depth;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::Verifier
+ *
+ ******************************************************************************/
+
+amqp::DecodeResult
+amqp::internal::
+Verifier::verify (pn_data_t * data_, const Limits & limits_) {
+    Verifier verifier (data_, limits_);
+
+    auto point = pn_data_point (data_);
+    verifier.verifyEnvelope();
+    pn_data_restore (data_, point);
+
+    return std::move (verifier.m_result);
+}
+
+/******************************************************************************/
+
+amqp::DecodeResult
+amqp::internal::
+Verifier::verify (
+    pn_data_t * data_,
+    const Schema & schema_,
+    const Limits & limits_
+) {
+    Verifier verifier (data_, limits_, &schema_.m_types);
+
+    auto point = pn_data_point (data_);
+
+    pn_data_rewind (data_);
+
+    if (!verifier.next()) {
+        verifier.fail (DecodeStatus::MissingElement, "blob has no value");
+    } else {
+        AutoCrumb crumb (verifier.m_path, "value");
+        verifier.verifyValue ({ });
+    }
+
+    pn_data_restore (data_, point);
+
+    return std::move (verifier.m_result);
+}
+
+/******************************************************************************/
+
+amqp::internal::
+Verifier::Verifier (
+    pn_data_t * data_,
+    const Limits & limits_,
+    const TypeMap * types_
+) : m_data (data_)
+  , m_limits (limits_)
+  , m_deadline (std::chrono::steady_clock::now() + limits_.time)
+  , m_types (types_ ? types_ : &m_ownTypes)
+{
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::Verifier::Schema
+ *
+ ******************************************************************************/
+
+amqp::internal::
+Verifier::Schema::Schema (
+    std::string_view section_,
+    const Limits & limits_
+) {
+    std::unique_ptr<pn_data_t, decltype (&pn_data_free)> data (
+        pn_data (0), &pn_data_free);
+
+    auto rtn = pn_data_decode (data.get(), section_.data(), section_.size());
+
+    if (rtn < 0 || static_cast<std::size_t>(rtn) != section_.size()) {
+        throw std::runtime_error ("Failed to decode schema");
+    }
+
+    Verifier verifier (data.get(), limits_);
+
+    pn_data_rewind (data.get());
+    pn_data_next (data.get());
+
+    if (!verifier.verifySchema()) {
+        if (verifier.m_result.status == DecodeStatus::LimitExceeded) {
+            throw LimitExceeded (verifier.m_result.what);
+        }
+
+        throw std::runtime_error ("Bad schema: " + verifier.m_result.what);
+    }
+
+    // the types' views are into the decoded section, reserving up front
+    // means the arena never moves as we copy them across
+    std::size_t length { 0 };
+    for (const auto & [ descriptor, type ] : verifier.m_ownTypes) {
+        length += descriptor.size();
+        for (const auto & [ name, fieldType ] : type.fields) {
+            length += name.size() + fieldType.size();
+        }
+    }
+
+    m_arena.reserve (length);
+
+    auto keep = [this](std::string_view view_) {
+        auto offset = m_arena.size();
+        m_arena.append (view_);
+        return std::string_view (m_arena.data() + offset, view_.size());
+    };
+
+    for (auto & [ descriptor, type ] : verifier.m_ownTypes) {
+        auto & kept = m_types.emplace (keep (descriptor), std::move (type)).first->second;
+
+        for (auto & [ name, fieldType ] : kept.fields) {
+            name = keep (name);
+            fieldType = keep (fieldType);
+        }
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Only the first failure is recorded, everything after it is just us
+ * unwinding
+ */
+bool
+amqp::internal::
+Verifier::fail (DecodeStatus status_, const char * what_) {
+    if (m_result.ok()) {
+        m_result.status = status_;
+        m_result.node = m_node;
+        m_result.what = what_;
+
+        for (const auto & crumb : m_path) {
+            if (crumb.name.empty()) {
+                m_result.path += '[';
+                m_result.path += std::to_string (crumb.index);
+                m_result.path += ']';
+            } else {
+                if (!m_result.path.empty()) {
+                    m_result.path += '.';
+                }
+                m_result.path += crumb.name;
+            }
+        }
+    }
+
+    return false;
+}
+
+/******************************************************************************/
+
+/**
+ * Running out of budget looks to the caller like running out of nodes,
+ * so once it happens every walk stops where it is and we unwind
+ */
+bool
+amqp::internal::
+Verifier::next() {
+    if (m_node == m_limits.nodes) {
+        return fail (DecodeStatus::LimitExceeded, "too many nodes");
+    }
+
+    if (m_limits.time.count()
+        && m_node % 1024 == 0
+        && std::chrono::steady_clock::now() > m_deadline
+    ) {
+        return fail (DecodeStatus::LimitExceeded, "took too long");
+    }
+
+    if (!pn_data_next (m_data)) {
+        return false;
+    }
+
+    ++m_node;
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Move to the next sibling, which must exist and be of type [type_]
+ */
+bool
+amqp::internal::
+Verifier::child (pn_type_t type_, const char * what_) {
+    if (!next()) {
+        return fail (DecodeStatus::MissingElement, what_);
+    }
+
+    if (pn_data_type (m_data) != type_) {
+        return fail (DecodeStatus::UnexpectedType, what_);
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::
+Verifier::childDescriptor (int id_) {
+    if (!child (PN_ULONG, "expected a Corda descriptor")) {
+        return false;
+    }
+
+    auto id = pn_data_get_ulong (m_data);
+
+    if (id != (::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS | id_)) {
+        return fail (DecodeStatus::UnknownDescriptor, "unexpected Corda descriptor");
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::
+Verifier::text() const {
+    auto bytes = pn_data_type (m_data) == PN_SYMBOL
+        ? pn_data_get_symbol (m_data)
+        : pn_data_get_string (m_data);
+
+    return { bytes.start, bytes.size };
+}
+
+/******************************************************************************/
+
+/**
+ * Step over the current node and everything beneath it, we still visit
+ * each node so the count stays true
+ */
+bool
+amqp::internal::
+Verifier::skip() {
+    switch (pn_data_type (m_data)) {
+        case PN_DESCRIBED :
+        case PN_LIST :
+        case PN_MAP :
+        case PN_ARRAY : {
+            AutoDepth depth (m_depth);
+
+            if (m_depth > m_limits.depth) {
+                return fail (DecodeStatus::LimitExceeded, "nested too deeply");
+            }
+
+            pn_data_enter (m_data);
+            while (next()) {
+                if (!skip()) {
+                    return false;
+                }
+            }
+            pn_data_exit (m_data);
+            break;
+        }
+        default :
+            break;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Skip whatever is left at this level and go back up to the parent
+ */
+bool
+amqp::internal::
+Verifier::leave() {
+    while (next()) {
+        if (!skip()) {
+            return false;
+        }
+    }
+
+    pn_data_exit (m_data);
+
+    // running out of nodes ends a list as surely as reaching its end,
+    // it mustn't pass for one
+    return m_result.ok();
+}
+
+/******************************************************************************/
+
+/**
+ * The value comes first in the envelope but we can't say anything about it
+ * until we've seen the schema, so remember where it was and come back
+ */
+bool
+amqp::internal::
+Verifier::verifyEnvelope() {
+    if (pn_data_type (m_data) != PN_DESCRIBED) {
+        return fail (DecodeStatus::UnexpectedType, "expected an envelope");
+    }
+
+    pn_data_enter (m_data);
+
+    if (!childDescriptor (::amqp::schema::descriptors::ENVELOPE)
+        || !child (PN_LIST, "expected an envelope")
+    ) {
+        return false;
+    }
+
+    pn_data_enter (m_data);
+
+    if (!next()) {
+        return fail (DecodeStatus::MissingElement, "envelope has no value");
+    }
+
+    auto value = pn_data_point (m_data);
+    auto valueNode = m_node;
+
+    skip();
+
+    if (!next()) {
+        return fail (DecodeStatus::MissingElement, "envelope has no schema");
+    }
+
+    {
+        AutoCrumb crumb (m_path, "schema");
+
+        if (!verifySchema()) {
+            return false;
+        }
+    }
+
+    pn_data_restore (m_data, value);
+    m_node = valueNode;
+
+    AutoCrumb crumb (m_path, "value");
+
+    return verifyValue ({ });
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::
+Verifier::verifySchema() {
+    if (pn_data_type (m_data) != PN_DESCRIBED) {
+        return fail (DecodeStatus::UnexpectedType, "expected a schema");
+    }
+
+    pn_data_enter (m_data);
+
+    if (!childDescriptor (::amqp::schema::descriptors::SCHEMA)
+        || !child (PN_LIST, "expected a schema")
+    ) {
+        return false;
+    }
+
+    pn_data_enter (m_data);
+
+    if (!child (PN_LIST, "expected a list of types")) {
+        return false;
+    }
+
+    pn_data_enter (m_data);
+
+    AutoCrumb types (m_path, "types");
+
+    for (std::size_t i { 0 } ; next() ; ++i) {
+        AutoCrumb crumb (m_path, i);
+
+        if (!verifyTypeNotation()) {
+            return false;
+        }
+    }
+
+    pn_data_exit (m_data);
+    leave();
+    return leave();
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::
+Verifier::verifyTypeNotation() {
+    if (pn_data_type (m_data) != PN_DESCRIBED) {
+        return fail (DecodeStatus::UnexpectedType, "expected a type");
+    }
+
+    pn_data_enter (m_data);
+
+    if (!child (PN_ULONG, "expected a Corda descriptor")) {
+        return false;
+    }
+
+    auto id = pn_data_get_ulong (m_data);
+    bool restricted;
+
+    if (id == (::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS
+            | ::amqp::schema::descriptors::COMPOSITE_TYPE)
+    ) {
+        restricted = false;
+    } else if (id == (::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS
+            | ::amqp::schema::descriptors::RESTRICTED_TYPE)
+    ) {
+        restricted = true;
+    } else {
+        return fail (
+            DecodeStatus::UnknownDescriptor,
+            "expected a composite or restricted type");
+    }
+
+    if (!child (PN_LIST, "expected a type")) {
+        return false;
+    }
+
+    pn_data_enter (m_data);
+
+    if (!child (PN_STRING, "expected a type name")) {
+        return false;
+    }
+
+    if (!next()) {
+        return fail (DecodeStatus::MissingElement, "type has no label");
+    }
+
+    if (!child (PN_LIST, "expected a list of provided interfaces")) {
+        return false;
+    }
+
+    skip();
+
+    std::string_view source;
+
+    if (restricted) {
+        if (!child (PN_STRING, "expected a restricted type's source")) {
+            return false;
+        }
+
+        source = text();
+    }
+
+    if (!next()) {
+        return fail (DecodeStatus::MissingElement, "type has no descriptor");
+    }
+
+    std::string_view symbol;
+
+    {
+        AutoCrumb crumb (m_path, "descriptor");
+
+        if (!verifyDescriptor (symbol)) {
+            return false;
+        }
+    }
+
+    if (!child (PN_LIST, restricted
+            ? "expected a list of choices"
+            : "expected a list of fields")
+    ) {
+        return false;
+    }
+
+    Type type;
+    auto elements = pn_data_get_list (m_data);
+
+    pn_data_enter (m_data);
+
+    {
+        AutoCrumb crumb (m_path, restricted ? "choices" : "fields");
+
+        for (std::size_t i { 0 } ; next() ; ++i) {
+            AutoCrumb index (m_path, i);
+
+            if (!restricted) {
+                if (!verifyField (type)) {
+                    return false;
+                }
+
+                continue;
+            }
+
+            if (pn_data_type (m_data) != PN_DESCRIBED) {
+                return fail (DecodeStatus::UnexpectedType, "expected a choice");
+            }
+
+            pn_data_enter (m_data);
+
+            if (!childDescriptor (::amqp::schema::descriptors::CHOICE)
+                || !child (PN_LIST, "expected a choice")
+            ) {
+                return false;
+            }
+
+            pn_data_enter (m_data);
+
+            if (!child (PN_STRING, "expected a choice's name")) {
+                return false;
+            }
+
+            leave();
+            leave();
+        }
+    }
+
+    pn_data_exit (m_data);
+
+    if (!restricted) {
+        type.kind = Type::Composite;
+    } else if (source == "list") {
+        type.kind = elements ? Type::Enum : Type::List;
+    } else if (source == "map") {
+        type.kind = Type::Map;
+    }
+
+    if (!symbol.empty()) {
+        m_ownTypes[symbol] = std::move (type);
+    }
+
+    leave();
+    return leave();
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::
+Verifier::verifyDescriptor (std::string_view & symbol_) {
+    if (pn_data_type (m_data) != PN_DESCRIBED) {
+        return fail (DecodeStatus::UnexpectedType, "expected a descriptor");
+    }
+
+    pn_data_enter (m_data);
+
+    if (!childDescriptor (::amqp::schema::descriptors::OBJECT)
+        || !child (PN_LIST, "expected a descriptor")
+    ) {
+        return false;
+    }
+
+    pn_data_enter (m_data);
+
+    if (next()) {
+        if (pn_data_type (m_data) == PN_SYMBOL) {
+            symbol_ = text();
+        } else if (pn_data_type (m_data) != PN_NULL) {
+            return fail (DecodeStatus::UnexpectedType, "expected a symbol");
+        }
+    }
+
+    leave();
+    return leave();
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::
+Verifier::verifyField (Type & type_) {
+    if (pn_data_type (m_data) != PN_DESCRIBED) {
+        return fail (DecodeStatus::UnexpectedType, "expected a field");
+    }
+
+    pn_data_enter (m_data);
+
+    if (!childDescriptor (::amqp::schema::descriptors::FIELD)
+        || !child (PN_LIST, "expected a field")
+    ) {
+        return false;
+    }
+
+    pn_data_enter (m_data);
+
+    if (!child (PN_STRING, "expected a field's name")) {
+        return false;
+    }
+
+    auto name = text();
+
+    if (!child (PN_STRING, "expected a field's type")) {
+        return false;
+    }
+
+    type_.fields.emplace_back (name, text());
+
+    leave();
+    return leave();
+}
+
+/******************************************************************************/
+
+/**
+ * @param type_ the type the schema says this value has, if we know it
+ */
+bool
+amqp::internal::
+Verifier::verifyValue (std::string_view type_) {
+    switch (pn_data_type (m_data)) {
+        case PN_NULL :
+            return true;
+        case PN_DESCRIBED :
+            return verifyDescribed();
+        case PN_LIST :
+        case PN_MAP :
+        case PN_ARRAY :
+            return skip();
+        default :
+            break;
+    }
+
+    auto actual = reader::PropertyReader::findType (pn_data_type (m_data));
+
+    if (!actual) {
+        return fail (DecodeStatus::Unsupported, "not a type we can read");
+    }
+
+    if (schema::Field::typeIsPrimitive (type_) && *actual != type_) {
+        return fail (
+            DecodeStatus::UnexpectedType,
+            "value doesn't match the type of its field");
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::
+Verifier::verifyDescribed() {
+    AutoDepth depth (m_depth);
+
+    if (m_depth > m_limits.depth) {
+        return fail (DecodeStatus::LimitExceeded, "nested too deeply");
+    }
+
+    pn_data_enter (m_data);
+
+    if (!next()) {
+        return fail (DecodeStatus::MissingElement, "described type has no descriptor");
+    }
+
+    if (pn_data_type (m_data) == PN_ULONG) {
+        if (stripCorda (pn_data_get_ulong (m_data)) == static_cast<uint32_t>(
+                ::amqp::schema::descriptors::REFERENCED_OBJECT)
+        ) {
+            return fail (DecodeStatus::Unsupported, "referenced objects");
+        }
+
+        return fail (DecodeStatus::UnknownDescriptor, "unexpected numeric descriptor");
+    }
+
+    if (pn_data_type (m_data) != PN_SYMBOL) {
+        return fail (DecodeStatus::UnexpectedType, "expected a symbol descriptor");
+    }
+
+    auto it = m_types->find (text());
+
+    if (it == m_types->end()) {
+        return fail (DecodeStatus::UnknownDescriptor, "descriptor isn't in the schema");
+    }
+
+    if (!next()) {
+        return fail (DecodeStatus::MissingElement, "described type has no value");
+    }
+
+    const auto & type = it->second;
+
+    switch (type.kind) {
+        case Type::Composite : {
+            if (pn_data_type (m_data) != PN_LIST) {
+                return fail (DecodeStatus::UnexpectedType, "expected a list of properties");
+            }
+
+            pn_data_enter (m_data);
+
+            for (std::size_t i { 0 } ; next() ; ++i) {
+                if (i >= type.fields.size()) {
+                    return fail (
+                        DecodeStatus::UnexpectedType,
+                        "more properties than the schema has fields");
+                }
+
+                AutoCrumb crumb (m_path, type.fields[i].first);
+
+                if (!verifyValue (type.fields[i].second)) {
+                    return false;
+                }
+            }
+
+            pn_data_exit (m_data);
+            break;
+        }
+        case Type::List :
+        case Type::Map : {
+            auto expected = type.kind == Type::List ? PN_LIST : PN_MAP;
+
+            if (pn_data_type (m_data) != expected) {
+                return fail (DecodeStatus::UnexpectedType, type.kind == Type::List
+                    ? "expected a list"
+                    : "expected a map");
+            }
+
+            pn_data_enter (m_data);
+
+            for (std::size_t i { 0 } ; next() ; ++i) {
+                AutoCrumb crumb (m_path, expected == PN_MAP ? i / 2 : i);
+
+                if (!verifyValue ({ })) {
+                    return false;
+                }
+            }
+
+            pn_data_exit (m_data);
+            break;
+        }
+        case Type::Enum : {
+            if (pn_data_type (m_data) != PN_LIST) {
+                return fail (DecodeStatus::UnexpectedType, "expected an enum");
+            }
+
+            pn_data_enter (m_data);
+
+            if (!child (PN_STRING, "expected an enum constant")) {
+                return false;
+            }
+
+            leave();
+            break;
+        }
+        case Type::Other :
+            skip();
+            break;
+    }
+
+    return leave();
+}
+
+/******************************************************************************/
@@ -0,0 +1,168 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <string_view>
+
+#include <proton/codec.h>
+
+#include "amqp/Limits.h"
+#include "amqp/DecodeResult.h"
+
+/******************************************************************************
+ *
+ * class Verifier
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Walks a decoded blob checking it has the shape the schema and the
+     * readers built from it expect, without building anything and without
+     * throwing.
+     *
+     * The readers report a malformed blob by throwing, which is fine when
+     * inspecting the odd blob but when scanning a corpus with a lot of bad
+     * ones in it, unwinding becomes most of the work. Running this first
+     * means those blobs are rejected with a status, where and how we got
+     * there instead.
+     *
+     * Strings are held as views into the proton tree so verifying a blob
+     * doesn't copy any of it.
+     */
+    class Verifier {
+        private :
+            struct Type {
+                enum Kind { Composite, List, Map, Enum, Other };
+
+                Kind kind { Other };
+
+                /**
+                 * name and type of each field of a composite
+                 */
+                std::vector<std::pair<std::string_view, std::string_view>> fields;
+            };
+
+            /**
+             * One step of the path to where we are, either a property name
+             * or an index into a container
+             */
+            struct Crumb {
+                std::string_view name;
+                std::size_t      index;
+            };
+
+            class AutoCrumb {
+                private :
+                    std::vector<Crumb> & m_path;
+
+                public :
+                    AutoCrumb (std::vector<Crumb> &, std::string_view);
+                    AutoCrumb (std::vector<Crumb> &, std::size_t);
+                    ~AutoCrumb();
+            };
+
+            class AutoDepth {
+                private :
+                    std::size_t & m_depth;
+
+                public :
+                    explicit AutoDepth (std::size_t &);
+                    ~AutoDepth();
+            };
+
+            pn_data_t * m_data;
+            std::size_t m_node { 0 };
+            std::size_t m_depth { 0 };
+
+            const Limits & m_limits;
+            std::chrono::steady_clock::time_point m_deadline;
+
+            std::vector<Crumb> m_path;
+
+            using TypeMap = std::map<std::string_view, Type>;
+
+            /**
+             * Every type in the schema, by descriptor, either the ones we
+             * found in the blob or those given to us
+             */
+            TypeMap         m_ownTypes;
+            const TypeMap * m_types;
+
+            DecodeResult m_result;
+
+            Verifier (pn_data_t *, const Limits &, const TypeMap * = nullptr);
+
+            bool fail (DecodeStatus, const char *);
+
+            bool next();
+            bool child (pn_type_t, const char *);
+            bool childDescriptor (int);
+            std::string_view text() const;
+            bool skip();
+            bool leave();
+
+            bool verifyEnvelope();
+            bool verifySchema();
+            bool verifyTypeNotation();
+            bool verifyDescriptor (std::string_view &);
+            bool verifyField (Type &);
+            bool verifyValue (std::string_view);
+            bool verifyDescribed();
+
+        public :
+            /**
+             * A schema section as we see it, kept so blobs sharing the
+             * section need only have their values verified. Immutable
+             * once built so may be shared between threads.
+             */
+            class Schema {
+                private :
+                    friend class Verifier;
+
+                    /**
+                     * Every string the types refer to, the decoded
+                     * section is let go of once we've copied them out
+                     */
+                    std::string m_arena;
+                    TypeMap     m_types;
+
+                public :
+                    /**
+                     * @throws std::runtime_error if [section_] isn't a
+                     * schema we'd accept from within a blob, LimitExceeded
+                     * if checking it would take us past [limits_]
+                     */
+                    explicit Schema (
+                        std::string_view section_,
+                        const Limits & limits_ = Limits());
+
+                    Schema (const Schema &) = delete;
+            };
+
+            /**
+             * Leaves [data_] positioned where it was found. A blob that
+             * would take us past [limits_] fails with LimitExceeded.
+             */
+            static DecodeResult verify (
+                pn_data_t * data_,
+                const Limits & limits_ = Limits());
+
+            /**
+             * Verify just a blob's value, [data_] holding nothing else,
+             * against a schema already verified
+             */
+            static DecodeResult verify (
+                pn_data_t * data_,
+                const Schema & schema_,
+                const Limits & limits_ = Limits());
+    };
+
+}
+
+/******************************************************************************/
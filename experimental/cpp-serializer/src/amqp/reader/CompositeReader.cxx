@@ -11,11 +11,14 @@
 #include "amqp/reader/IReader.h"
 #include "proton/proton_wrapper.h"
 
+#include "amqp/Budget.h"
+
 /******************************************************************************/
 
+template<class Policy>
 const std::string
 amqp::internal::reader::
-CompositeReader::m_name { // NOLINT
+CompositeReader<Policy>::m_name { // NOLINT
     "Composite Reader"
 };
 
@@ -24,51 +27,59 @@ CompositeReader::m_name { // NOLINT
  *
  ******************************************************************************/
 
+template<class Policy>
 amqp::internal::reader::
-CompositeReader::CompositeReader (
+CompositeReader<Policy>::CompositeReader (
         std::string type_,
-        sVec<std::weak_ptr<Reader>> & readers_
-) : m_readers (readers_)
+        std::string descriptor_,
+        sVec<std::string> fieldNames_,
+        sVec<const Reader *> readers_
+) : m_readers (std::move (readers_))
+  , m_fieldNames (std::move (fieldNames_))
   , m_type (std::move (type_))
+  , m_descriptor (std::move (descriptor_))
 {
     DBG ("MAKE CompositeReader: " << m_type << ": " << m_readers.size() << std::endl); // NOLINT
-    for (auto const reader : m_readers) {
-        assert (reader.lock());
-        if (auto r = reader.lock()) {
-            DBG ("  prop: " << r->name() << " " << r->type() << std::endl); // NOLINT
-        }
+    assert (m_fieldNames.size() == m_readers.size());
+    for (const auto reader : m_readers) {
+        assert (reader);
+        DBG ("  prop: " << reader->name() << " " << reader->type() << std::endl); // NOLINT
     }
 }
 
 /******************************************************************************/
 
+template<class Policy>
 const std::string &
 amqp::internal::reader::
-CompositeReader::name() const {
+CompositeReader<Policy>::name() const {
     return m_name;
 }
 
 /******************************************************************************/
 
+template<class Policy>
 const std::string &
 amqp::internal::reader::
-CompositeReader::type() const  {
+CompositeReader<Policy>::type() const  {
     return m_type;
 }
 
 /******************************************************************************/
 
+template<class Policy>
 std::any
 amqp::internal::reader::
-CompositeReader::read (pn_data_t * data_) const {
+CompositeReader<Policy>::read (pn_data_t * data_) const {
     return std::any(1);
 }
 
 /******************************************************************************/
 
+template<class Policy>
 std::string
 amqp::internal::reader::
-CompositeReader::readString (pn_data_t * data_) const {
+CompositeReader<Policy>::readString (pn_data_t * data_) const {
     pn_data_next (data_);
     proton::auto_enter ae (data_);
 
@@ -78,9 +89,10 @@ CompositeReader::readString (pn_data_t * data_) const {
 /******************************************************************************/
 
 
+template<class Policy>
 sVec<uPtr<amqp::reader::IValue>>
 amqp::internal::reader::
-CompositeReader::_dump (
+CompositeReader<Policy>::_dump (
         pn_data_t * data_,
         const SchemaType & schema_
 ) const {
@@ -90,38 +102,48 @@ CompositeReader::_dump (
         << type()
         << std::endl); // NOLINT
 
-    proton::is_described (data_);
-    proton::auto_enter ae (data_);
+    Budget::Frame frame;
 
-    const auto & it = schema_.fromDescriptor (
-            proton::get_symbol<std::string>(data_));
-
-    auto & fields = dynamic_cast<schema::Composite &> (
-            *(it->second.get())).fields();
+    Check<Policy>::described (data_);
+    proton::auto_enter ae (data_);
 
-    assert (fields.size() == m_readers.size());
+    // We know the shape of the type from when we were built, all that
+    // needs confirming is that this is an instance of it
+    Check<Policy>::symbol (data_, m_descriptor);
 
     pn_data_next (data_);
 
-    sVec<uPtr<amqp::reader::IValue>> read;
-    read.reserve (fields.size());
+    Check<Policy>::list (data_);
+    proton::auto_enter ae2 (data_);
 
-    proton::is_list (data_);
-    {
-        proton::auto_enter ae (data_);
+    return fields (data_, schema_);
+}
 
-        for (int i (0) ; i < m_readers.size() ; ++i) {
-            if (auto l =  m_readers[i].lock()) {
-                DBG (fields[i]->name() << " "
-                    << (l ? "true" : "false") << std::endl); // NOLINT
+/******************************************************************************/
 
-                read.emplace_back (l->dump (fields[i]->name(), data_, schema_));
-            } else {
+template<class Policy>
+sVec<uPtr<amqp::reader::IValue>>
+amqp::internal::reader::
+CompositeReader<Policy>::fields (
+        pn_data_t * data_,
+        const SchemaType & schema_
+) const {
+    sVec<uPtr<amqp::reader::IValue>> read;
+    read.reserve (m_readers.size());
+
+    for (std::size_t i (0) ; i < m_readers.size() ; ++i) {
+        if constexpr (Policy::validate) {
+            if (!m_readers[i]) {
                 std::stringstream s;
-                s << "null field reader: " << fields[i]->name();
+                s << "null field reader: " << m_fieldNames[i];
                 throw std::runtime_error (s.str());
             }
         }
+
+        DBG (m_fieldNames[i] << std::endl); // NOLINT
+
+        read.emplace_back (
+            m_readers[i]->dump (m_fieldNames[i], data_, schema_));
     }
 
     return read;
@@ -129,9 +151,10 @@ CompositeReader::_dump (
 
 /******************************************************************************/
 
+template<class Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-CompositeReader::dump (
+CompositeReader<Policy>::dump (
     const std::string & name_,
     pn_data_t * data_,
     const SchemaType & schema_) const
@@ -148,9 +171,10 @@ CompositeReader::dump (
 /**
  *
  */
+template<class Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-CompositeReader::dump (
+CompositeReader<Policy>::dump (
     pn_data_t * data_,
     const SchemaType & schema_) const
 {
@@ -162,3 +186,7 @@ CompositeReader::dump (
 
 /******************************************************************************/
 
+template class amqp::internal::reader::CompositeReader<amqp::internal::reader::Strict>;
+template class amqp::internal::reader::CompositeReader<amqp::internal::reader::Trusted>;
+
+/******************************************************************************/
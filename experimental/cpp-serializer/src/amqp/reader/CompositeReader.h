@@ -9,22 +9,43 @@
 #include <iostream>
 #include <amqp/schema/described-types/Schema.h>
 
+#include "Policy.h"
+
 /******************************************************************************/
 
 namespace amqp::internal::reader {
 
+    template<class Policy>
     class CompositeReader : public Reader {
-        private :
-            std::vector<std::weak_ptr<Reader>> m_readers;
+        protected :
+            // Readers for each field, owned by the factory
+            std::vector<const Reader *> m_readers;
+
+            // The name of each field, in the same order as [m_readers]
+            std::vector<std::string> m_fieldNames;
+
+            /**
+             * Read the fields of the composite whose list we've just
+             * entered, in the order they're to be dumped
+             */
+            virtual std::vector<std::unique_ptr<amqp::reader::IValue>> fields (
+                pn_data_t *,
+                const SchemaType &) const;
 
+        private :
             static const std::string m_name;
 
             std::string m_type;
 
+            // what we expect to find on the wire in front of an instance
+            std::string m_descriptor;
+
         public :
             CompositeReader (
                 std::string,
-                std::vector<std::weak_ptr<Reader>> &);
+                std::string,
+                std::vector<std::string>,
+                std::vector<const Reader *>);
 
             ~CompositeReader() override = default;
 
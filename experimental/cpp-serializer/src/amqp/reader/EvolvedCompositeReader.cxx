@@ -0,0 +1,117 @@
+#include "EvolvedCompositeReader.h"
+
+#include <string>
+#include <assert.h>
+
+#include <proton/codec.h>
+
+#include "debug.h"
+#include "Reader.h"
+#include "amqp/reader/IReader.h"
+
+/******************************************************************************/
+
+template<class Policy>
+const std::string
+amqp::internal::reader::
+EvolvedCompositeReader<Policy>::m_name { // NOLINT
+    "Evolved Composite Reader"
+};
+
+/******************************************************************************
+ *
+ *
+ ******************************************************************************/
+
+template<class Policy>
+amqp::internal::reader::
+EvolvedCompositeReader<Policy>::EvolvedCompositeReader (
+        std::string type_,
+        std::string descriptor_,
+        sVec<std::string> fieldNames_,
+        sVec<const Reader *> readers_,
+        const Evolution::Layout & layout_
+) : CompositeReader<Policy> (
+        std::move (type_),
+        std::move (descriptor_),
+        std::move (fieldNames_),
+        std::move (readers_))
+  , m_source (layout_.source)
+  , m_names (layout_.names)
+  , m_defaults (layout_.defaults)
+{
+    assert (m_names.size() == m_source.size());
+
+    auto & readers = this->m_readers;
+
+    // Drop the readers for the fields we no longer have so we know to
+    // step over them
+    std::vector<bool> used (readers.size(), false);
+    for (auto source : m_source) {
+        if (source >= 0) {
+            used.at (source) = true;
+        }
+    }
+
+    for (std::size_t i { 0 } ; i < readers.size() ; ++i) {
+        if (!used[i]) {
+            readers[i] = nullptr;
+        }
+    }
+}
+
+/******************************************************************************/
+
+template<class Policy>
+const std::string &
+amqp::internal::reader::
+EvolvedCompositeReader<Policy>::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+template<class Policy>
+sVec<uPtr<amqp::reader::IValue>>
+amqp::internal::reader::
+EvolvedCompositeReader<Policy>::fields (
+        pn_data_t * data_,
+        const SchemaType & schema_
+) const {
+    const auto & readers = this->m_readers;
+    const auto & fieldNames = this->m_fieldNames;
+
+    // The blob's fields, in its order, those we skip left empty
+    sVec<uPtr<amqp::reader::IValue>> theirs (readers.size());
+
+    for (std::size_t i (0) ; i < readers.size() ; ++i) {
+        if (!readers[i]) {
+            DBG ("skip " << fieldNames[i] << std::endl); // NOLINT
+            pn_data_next (data_);
+            continue;
+        }
+
+        theirs[i] = readers[i]->dump (fieldNames[i], data_, schema_);
+    }
+
+    sVec<uPtr<amqp::reader::IValue>> read;
+    read.reserve (m_source.size());
+
+    for (std::size_t i (0) ; i < m_source.size() ; ++i) {
+        if (m_source[i] >= 0) {
+            read.emplace_back (std::move (theirs[m_source[i]]));
+        } else {
+            read.emplace_back (std::make_unique<TypedPair<std::string>> (
+                m_names[i], std::string (m_defaults[i])));
+        }
+    }
+
+    return read;
+}
+
+/******************************************************************************/
+
+template class amqp::internal::reader::EvolvedCompositeReader<amqp::internal::reader::Strict>;
+template class amqp::internal::reader::EvolvedCompositeReader<amqp::internal::reader::Trusted>;
+
+/******************************************************************************/
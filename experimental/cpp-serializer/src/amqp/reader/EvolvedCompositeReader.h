@@ -0,0 +1,62 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "CompositeReader.h"
+
+#include <vector>
+
+#include "amqp/Evolution.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Reads a composite written by another version of a CorDapp as the
+     * version we expect, see [Evolution].
+     *
+     * Everything about the mapping is worked out before we're built, per
+     * object we read the blob's fields in its order, step over those we
+     * don't have, and hand them back in ours with the defaults filled in.
+     * Everything else is read just as any other composite.
+     */
+    template<class Policy>
+    class EvolvedCompositeReader : public CompositeReader<Policy> {
+        public :
+            using typename CompositeReader<Policy>::SchemaType;
+
+        private :
+            // For each of our fields the blob's field it's read from, or -1
+            std::vector<int> m_source;
+
+            // Our field names, in our order
+            std::vector<std::string> m_names;
+
+            // What each of our fields the blob doesn't have reads as
+            std::vector<std::string> m_defaults;
+
+            static const std::string m_name;
+
+            std::vector<std::unique_ptr<amqp::reader::IValue>> fields (
+                pn_data_t *,
+                const SchemaType &) const override;
+
+        public :
+            /**
+             * [fieldNames_] and [readers_] are the blob's fields, as the
+             * schema it carries lists them
+             */
+            EvolvedCompositeReader (
+                std::string,
+                std::string,
+                std::vector<std::string> fieldNames_,
+                std::vector<const Reader *> readers_,
+                const Evolution::Layout &);
+
+            const std::string & name() const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,54 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+
+/******************************************************************************
+ *
+ * Validation policies
+ *
+ * The compile time side of amqp::Validation. Readers are instantiated for
+ * one or the other when they're built and so the choice costs nothing per
+ * node, in the Trusted case the checks don't exist at all.
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    struct Strict {
+        static constexpr bool validate = true;
+    };
+
+    struct Trusted {
+        static constexpr bool validate = false;
+    };
+
+    template<class Policy>
+    struct Check {
+        static void described (pn_data_t * data_) {
+            if constexpr (Policy::validate) {
+                proton::is_described (data_);
+            }
+        }
+
+        static void list (pn_data_t * data_) {
+            if constexpr (Policy::validate) {
+                proton::is_list (data_);
+            }
+        }
+
+        static void symbol (pn_data_t * data_, const std::string & expected_) {
+            if constexpr (Policy::validate) {
+                proton::is_symbol (data_, expected_);
+            }
+        }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,201 @@
+#include "PolymorphicReader.h"
+#include "PropertyReader.h"
+
+#include <proton/codec.h>
+
+#include "debug.h"
+
+#include "proton/proton_wrapper.h"
+
+/******************************************************************************
+ *
+ * PolymorphicReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+PolymorphicReader::m_name { // NOLINT
+    "Polymorphic Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+PolymorphicReader::m_type { // NOLINT
+    "*"
+};
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * class PolymorphicReader
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+PolymorphicReader::PolymorphicReader (
+    const Resolver & resolver_
+) : m_resolver (resolver_) {
+}
+
+/******************************************************************************/
+
+/**
+ * Find the reader for the described type at the current position in
+ * [data_], first in the cache and then asking the resolver.
+ */
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+PolymorphicReader::resolveDescriptor (pn_data_t * data_) const {
+    proton::auto_enter ae (data_);
+    proton::is_symbol (data_);
+
+    auto symbol = pn_data_get_symbol (data_);
+    std::string_view descriptor { symbol.start, symbol.size };
+
+    for (const auto & entry : m_cache) {
+        auto reader = entry.reader.load (std::memory_order_acquire);
+
+        if (!reader) {
+            // claimed entries are published out of order so a later one
+            // may be visible already, but it's rare enough to be a miss
+            break;
+        }
+
+        if (entry.descriptor == descriptor) {
+            return reader;
+        }
+    }
+
+    DBG ("PolymorphicReader miss - " << descriptor << std::endl); // NOLINT
+
+    auto reader = m_resolver.resolveDescriptor (descriptor);
+
+    if (!reader) {
+        throw std::runtime_error (
+            "No reader for descriptor " + std::string (descriptor));
+    }
+
+    if (m_claimed.load (std::memory_order_relaxed) < CacheSize) {
+        auto slot = m_claimed.fetch_add (1, std::memory_order_relaxed);
+
+        if (slot < CacheSize) {
+            m_cache[slot].descriptor = descriptor;
+            m_cache[slot].reader.store (reader, std::memory_order_release);
+        }
+    }
+
+    return reader;
+}
+
+/******************************************************************************/
+
+/**
+ * @return the reader for the value at the current position in [data_] or
+ * nullptr if that value is null
+ */
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+PolymorphicReader::resolve (pn_data_t * data_) const {
+    switch (pn_data_type (data_)) {
+        case PN_DESCRIBED : return resolveDescriptor (data_);
+        case PN_NULL : return nullptr;
+        default : {
+            /*
+             * Boxed primitives held in an interface typed property, Object
+             * or Comparable for example, are written as plain AMQP values
+             * without a descriptor
+             */
+            auto reader = m_resolver.resolveType (
+                    PropertyReader::typeOf (pn_data_type (data_)));
+
+            if (!reader) {
+                throw std::runtime_error ("Missing primitive reader");
+            }
+
+            return reader;
+        }
+    }
+}
+
+/******************************************************************************/
+
+std::any
+amqp::internal::reader::
+PolymorphicReader::read (pn_data_t * data_) const {
+    if (auto reader = resolve (data_)) {
+        return reader->read (data_);
+    }
+
+    pn_data_next (data_);
+    return std::any();
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+PolymorphicReader::readString (pn_data_t * data_) const {
+    if (auto reader = resolve (data_)) {
+        return reader->readString (data_);
+    }
+
+    pn_data_next (data_);
+    return "null";
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+PolymorphicReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    if (auto reader = resolve (data_)) {
+        return reader->dump (name_, data_, schema_);
+    }
+
+    proton::auto_next an (data_);
+
+    return std::make_unique<TypedPair<std::string>> (name_, "null");
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+PolymorphicReader::dump (
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    if (auto reader = resolve (data_)) {
+        return reader->dump (data_, schema_);
+    }
+
+    proton::auto_next an (data_);
+
+    return std::make_unique<TypedSingle<std::string>> ("null");
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+PolymorphicReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+PolymorphicReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
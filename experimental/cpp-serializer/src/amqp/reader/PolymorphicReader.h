@@ -0,0 +1,114 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "Reader.h"
+
+#include <any>
+#include <array>
+#include <atomic>
+#include <string>
+#include <string_view>
+
+/******************************************************************************/
+
+struct pn_data_t;
+
+/******************************************************************************
+ *
+ * class PolymorphicReader
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Reads a property whose type is only known from what is on the wire,
+     * i.e. a field declared in the schema as "*" because the JVM type of
+     * the property was an interface or abstract class.
+     *
+     * Each field site gets its own instance and with it a small inline
+     * cache of the descriptors it has seen and the readers they resolved
+     * to. Almost every site only ever sees one or two concrete types so
+     * the common case is a string compare rather than a trip through the
+     * factory.
+     *
+     * Like every reader it may be shared between threads, the cache is
+     * the only thing it writes and is filled without locking, see
+     * [CacheEntry].
+     */
+    class PolymorphicReader : public Reader {
+        public :
+            /**
+             * How a [PolymorphicReader] finds the reader for a concrete type
+             * it has not seen before. Implemented by whatever owns the
+             * readers and must outlive them.
+             */
+            class Resolver {
+                public :
+                    virtual ~Resolver() = default;
+
+                    virtual const Reader * resolveDescriptor (
+                        std::string_view) const = 0;
+
+                    virtual const Reader * resolveType (
+                        const std::string &) const = 0;
+            };
+
+        private :
+            static const std::string m_name;
+            static const std::string m_type;
+
+            static constexpr std::size_t CacheSize = 4;
+
+            /**
+             * A thread fills an entry by first claiming it, then writing
+             * the descriptor and finally publishing the reader. Lookups
+             * only trust entries whose reader they can see, by which time
+             * the descriptor is complete and will never change again.
+             */
+            struct CacheEntry {
+                std::string                 descriptor;
+                std::atomic<const Reader *> reader { nullptr };
+            };
+
+            const Resolver & m_resolver;
+
+            /**
+             * Entries are claimed in order and never evicted. Once all are
+             * claimed a site is megamorphic and any further types go
+             * straight to the resolver. Two threads missing on the same
+             * type at once may both cache it, which costs an entry but is
+             * otherwise harmless.
+             */
+            mutable std::array<CacheEntry, CacheSize> m_cache;
+            mutable std::atomic<std::size_t> m_claimed { 0 };
+
+            const Reader * resolve (pn_data_t *) const;
+            const Reader * resolveDescriptor (pn_data_t *) const;
+
+        public :
+            explicit PolymorphicReader (const Resolver &);
+
+            ~PolymorphicReader() override = default;
+
+            std::any read (pn_data_t *) const override;
+
+            std::string readString (pn_data_t *) const override;
+
+            uPtr<amqp::reader::IValue> dump(
+                const std::string &,
+                pn_data_t *,
+                const SchemaType &) const override;
+
+            uPtr<amqp::reader::IValue> dump(
+                pn_data_t *,
+                const SchemaType &) const override;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -1,13 +1,10 @@
 #include "PropertyReader.h"
 
-#include "amqp/reader/property-readers/IntPropertyReader.h"
-#include "amqp/reader/property-readers/BoolPropertyReader.h"
-#include "amqp/reader/property-readers/LongPropertyReader.h"
-#include "amqp/reader/property-readers/StringPropertyReader.h"
-#include "amqp/reader/property-readers/DoublePropertyReader.h"
+#include "amqp/reader/property-readers/PrimitiveReader.h"
 
 #include <map>
 #include <string>
+#include <sstream>
 #include <iostream>
 #include <functional>
 
@@ -21,37 +18,65 @@ namespace {
 
     using namespace amqp::internal::reader;
 
-    std::map<
-            std::string,
-            std::shared_ptr<amqp::internal::reader::PropertyReader>(*)()
-    > propertyMap = { // NOLINT
-        {
-            "int", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<IntPropertyReader> ();
-            }
-        },
-        {
-            "string", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<StringPropertyReader> ();
-            }
-        },
-        {
-            "boolean", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<BoolPropertyReader> ();
-            }
-        },
-        {
-            "long", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<LongPropertyReader> ();
-            }
-        },
-        {
-            "double", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<DoublePropertyReader> ();
-            }
-        }
+    using Maker = uPtr<PropertyReader>(*)();
+
+    struct Primitive {
+        pn_type_t pnType;
+        Maker     strict;
+        Maker     trusted;
     };
 
+    template<typename T, class Tag>
+    std::pair<const std::string, Primitive>
+    entry() {
+        return {
+            Tag::type(),
+            {
+                Tag::pnType,
+                []() -> uPtr<PropertyReader> {
+                    return std::make_unique<PrimitiveReader<T, Tag, Strict>>();
+                },
+                []() -> uPtr<PropertyReader> {
+                    return std::make_unique<PrimitiveReader<T, Tag, Trusted>>();
+                }
+            }
+        };
+    }
+
+    /**
+     * Everything we know about the AMQP primitives, keyed by the name the
+     * schema uses for them. Anything else that needs to enumerate or look
+     * up the primitives derives from this.
+     */
+    const std::map<std::string, Primitive> & primitiveMap() {
+        using namespace primitives;
+
+        static const std::map<std::string, Primitive> map { // NOLINT
+            entry<bool, Boolean>(),
+            entry<int8_t, Byte>(),
+            entry<uint8_t, UByte>(),
+            entry<int16_t, Short>(),
+            entry<uint16_t, UShort>(),
+            entry<int32_t, Int>(),
+            entry<uint32_t, UInt>(),
+            entry<int64_t, Long>(),
+            entry<uint64_t, ULong>(),
+            entry<float, Float>(),
+            entry<double, Double>(),
+            entry<pn_char_t, Char>(),
+            entry<pn_timestamp_t, Timestamp>(),
+            entry<pn_uuid_t, UUID>(),
+            entry<pn_decimal32_t, Decimal32>(),
+            entry<pn_decimal64_t, Decimal64>(),
+            entry<pn_decimal128_t, Decimal128>(),
+            entry<std::string, Binary>(),
+            entry<std::string, Symbol>(),
+            entry<std::string, String>()
+        };
+
+        return map;
+    }
+
 }
 
 /******************************************************************************
@@ -60,26 +85,84 @@ namespace {
  *
  ******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::PropertyReader>
+uPtr<amqp::internal::reader::PropertyReader>
+amqp::internal::reader::
+PropertyReader::make (const FieldPtr & field_, Validation validation_) {
+    return make (field_->type(), validation_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::internal::reader::PropertyReader>
+amqp::internal::reader::
+PropertyReader::make (const std::string & type_, Validation validation_) {
+    auto it = primitiveMap().find (type_);
+
+    if (it == primitiveMap().end()) {
+        throw std::runtime_error ("No property reader for type " + type_);
+    }
+
+    return validation_ == Validation::Trusted
+        ? it->second.trusted()
+        : it->second.strict();
+}
+
+/******************************************************************************/
+
+uPtr<amqp::internal::reader::PropertyReader>
+amqp::internal::reader::
+PropertyReader::make (
+    const internal::schema::Field & field_,
+    Validation validation_
+) {
+    return make (field_.type(), validation_);
+}
+
+/******************************************************************************/
+
+const std::vector<std::string> &
 amqp::internal::reader::
-PropertyReader::make (const FieldPtr & field_) {
-    return propertyMap[field_->type()]();
+PropertyReader::primitives() {
+    static const std::vector<std::string> names = []() {
+        std::vector<std::string> rtn;
+        rtn.reserve (primitiveMap().size());
+
+        for (const auto & p : primitiveMap()) {
+            rtn.push_back (p.first);
+        }
+
+        return rtn;
+    }();
+
+    return names;
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::PropertyReader>
+const std::string &
 amqp::internal::reader::
-PropertyReader::make (const std::string & type_) {
-    return propertyMap[type_]();
+PropertyReader::typeOf (pn_type_t type_) {
+    if (auto type = findType (type_)) {
+        return *type;
+    }
+
+    std::stringstream ss;
+    ss << "Cannot read a property of AMQP type " << type_;
+    throw std::runtime_error (ss.str());
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::PropertyReader>
+const std::string *
 amqp::internal::reader::
-PropertyReader::make (const internal::schema::Field & field_) {
-    return propertyMap[field_.type()]();
+PropertyReader::findType (pn_type_t type_) {
+    for (const auto & p : primitiveMap()) {
+        if (p.second.pnType == type_) {
+            return &p.first;
+        }
+    }
+
+    return nullptr;
 }
 
 /******************************************************************************/
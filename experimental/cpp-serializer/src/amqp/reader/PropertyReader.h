@@ -4,6 +4,11 @@
 
 #include "Reader.h"
 
+#include <vector>
+
+#include <proton/codec.h>
+
+#include "amqp/Validation.h"
 #include "amqp/schema/field-types/Field.h"
 
 /******************************************************************************/
@@ -18,9 +23,33 @@ namespace amqp::internal::reader {
             /**
              * Static Factory method for creating appropriate derived types
              */
-            static std::shared_ptr<PropertyReader> make (const internal::schema::Field &);
-            static std::shared_ptr<PropertyReader> make (const FieldPtr &);
-            static std::shared_ptr<PropertyReader> make (const std::string &);
+            static uPtr<PropertyReader> make (
+                const internal::schema::Field &,
+                Validation = Validation::Strict);
+
+            static uPtr<PropertyReader> make (
+                const FieldPtr &,
+                Validation = Validation::Strict);
+
+            static uPtr<PropertyReader> make (
+                const std::string &,
+                Validation = Validation::Strict);
+
+            /**
+             * The schema name of every AMQP primitive we have a reader for
+             */
+            static const std::vector<std::string> & primitives();
+
+            /**
+             * Map an undescribed value on the wire back to the schema's
+             * name for its type, throws if it isn't a primitive
+             */
+            static const std::string & typeOf (pn_type_t);
+
+            /**
+             * As [typeOf] but returns nullptr rather than throwing
+             */
+            static const std::string * findType (pn_type_t);
 
             PropertyReader() = default;
             ~PropertyReader() override = default;
@@ -5,6 +5,7 @@
 #include <any>
 #include <list>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 
@@ -168,6 +169,17 @@ TypedSingle<std::string>::dump() const {
     return m_value;
 }
 
+/**
+ * Views are over strings owned by a reader, interned enum constants for
+ * example, and so are only good for as long as that reader is
+ */
+template<>
+inline std::string
+amqp::internal::reader::
+TypedSingle<std::string_view>::dump() const {
+    return std::string (m_value);
+}
+
 template<>
 std::string
 amqp::internal::reader::
@@ -208,6 +220,20 @@ TypedPair<std::string>::dump() const {
     return m_property + " : " + m_value;
 }
 
+template<>
+inline std::string
+amqp::internal::reader::
+TypedPair<std::string_view>::dump() const {
+    std::string rtn;
+    rtn.reserve (m_property.size() + 3 + m_value.size());
+
+    rtn += m_property;
+    rtn += " : ";
+    rtn += m_value;
+
+    return rtn;
+}
+
 template<>
 std::string
 amqp::internal::reader::
@@ -248,6 +274,10 @@ namespace amqp::internal::reader  {
      * In other words, when encountering a graph of nodes with values, an
      * instance of [Reader] will give a sub tree of that graph contextual
      * meaning.
+     *
+     * Readers are immutable once built, everything a read changes lives in
+     * the pn_data_t it is handed, so a reader may be used by any number of
+     * threads at once as long as no two of them share a pn_data_t.
      */
     class Reader : public IReader {
         public :
@@ -10,8 +10,11 @@
 /******************************************************************************/
 
 amqp::internal::reader::
-RestrictedReader::RestrictedReader (std::string type_)
-    : m_type (std::move (type_))
+RestrictedReader::RestrictedReader (
+    std::string type_,
+    std::string descriptor_
+) : m_type (std::move (type_))
+  , m_descriptor (std::move (descriptor_))
 { }
 
 /******************************************************************************/
@@ -22,8 +22,12 @@ namespace amqp::internal::reader {
             static const std::string m_name;
             const std::string m_type;
 
+        protected :
+            // what we expect to find on the wire in front of an instance
+            const std::string m_descriptor;
+
         public :
-            explicit RestrictedReader (std::string);
+            RestrictedReader (std::string, std::string);
             ~RestrictedReader() override = default;
 
             std::any read (pn_data_t *) const override ;
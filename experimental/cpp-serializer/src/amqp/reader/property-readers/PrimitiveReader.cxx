@@ -0,0 +1,180 @@
+#include "PrimitiveReader.h"
+
+#include <cstdio>
+#include <charconv>
+
+#include "amqp/JSON.h"
+#include "amqp/Binary.h"
+
+/******************************************************************************
+ *
+ * Shared formatting, all the primitive readers funnel through these so
+ * there's one place to make them quick
+ *
+ ******************************************************************************/
+
+namespace {
+
+    template<typename T>
+    std::string
+    toChars (T value_) {
+        // big enough for any 64 bit integer and its sign
+        char buf[24];
+        auto res = std::to_chars (buf, buf + sizeof (buf), value_);
+
+        return std::string (buf, res.ptr);
+    }
+
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::primitives::
+integral (int64_t value_) {
+    return toChars (value_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::primitives::
+integral (uint64_t value_) {
+    return toChars (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::primitives::
+integral (int64_t value_, std::string & out_) {
+    char buf[24];
+    auto res = std::to_chars (buf, buf + sizeof (buf), value_);
+
+    out_.append (buf, res.ptr);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::primitives::
+floating (double value_) {
+    std::string rtn;
+    floating (value_, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * Fixed six decimal places, as std::to_string renders them
+ */
+void
+amqp::internal::reader::primitives::
+floating (double value_, std::string & out_) {
+#if __cpp_lib_to_chars >= 201611L
+    // the largest double is 309 digits before the point
+    char buf[330];
+    auto res = std::to_chars (
+        buf, buf + sizeof (buf), value_, std::chars_format::fixed, 6);
+
+    out_.append (buf, res.ptr);
+#else
+    char buf[32];
+    auto len = std::snprintf (buf, sizeof (buf), "%f", value_);
+
+    if (len < static_cast<int>(sizeof (buf))) {
+        out_.append (buf, len);
+        return;
+    }
+
+    // very large magnitudes need more room than we guessed
+    auto offset = out_.size();
+    out_.resize (offset + len + 1);
+    std::snprintf (&out_[offset], len + 1, "%f", value_);
+    out_.resize (offset + len);
+#endif
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::primitives::
+hex (const char * bytes_, std::size_t size_) {
+    std::string rtn;
+    binary::hex ({ bytes_, size_ }, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * AMQP chars are UTF-32 code points, anything that isn't a Unicode scalar
+ * value, a surrogate or beyond U+10FFFF, is shown as U+FFFD as a
+ * malformed string would be
+ */
+std::string
+amqp::internal::reader::primitives::
+utf8 (uint32_t cp_) {
+    std::string rtn;
+
+    if ((cp_ >= 0xD800 && cp_ <= 0xDFFF) || cp_ > 0x10FFFF) {
+        cp_ = 0xFFFD;
+    }
+
+    if (cp_ < 0x80) {
+        rtn += static_cast<char>(cp_);
+    } else if (cp_ < 0x800) {
+        rtn += static_cast<char>(0xC0 | (cp_ >> 6));
+        rtn += static_cast<char>(0x80 | (cp_ & 0x3F));
+    } else if (cp_ < 0x10000) {
+        rtn += static_cast<char>(0xE0 | (cp_ >> 12));
+        rtn += static_cast<char>(0x80 | ((cp_ >> 6) & 0x3F));
+        rtn += static_cast<char>(0x80 | (cp_ & 0x3F));
+    } else {
+        rtn += static_cast<char>(0xF0 | (cp_ >> 18));
+        rtn += static_cast<char>(0x80 | ((cp_ >> 12) & 0x3F));
+        rtn += static_cast<char>(0x80 | ((cp_ >> 6) & 0x3F));
+        rtn += static_cast<char>(0x80 | (cp_ & 0x3F));
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * The canonical 8-4-4-4-12 form, lower case as Java renders it
+ */
+std::string
+amqp::internal::reader::primitives::
+uuid (const pn_uuid_t & uuid_) {
+    static const char digits[] = "0123456789abcdef";
+
+    std::string rtn;
+    rtn.reserve (36);
+
+    for (std::size_t i { 0 } ; i < sizeof (uuid_.bytes) ; ++i) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) {
+            rtn += '-';
+        }
+
+        auto c = static_cast<uint8_t>(uuid_.bytes[i]);
+        rtn += digits[c >> 4];
+        rtn += digits[c & 0xF];
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::primitives::
+quoted (std::string_view value_) {
+    return json::quoted (value_);
+}
+
+/******************************************************************************/
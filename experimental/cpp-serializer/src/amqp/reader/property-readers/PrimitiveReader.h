@@ -0,0 +1,368 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "PropertyReader.h"
+#include "amqp/Budget.h"
+#include "amqp/Binary.h"
+#include "amqp/Nested.h"
+#include "amqp/reader/Policy.h"
+
+#include <any>
+#include <string>
+#include <sstream>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include <proton/types.h>
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+
+/******************************************************************************
+ *
+ * Formatting shared by every primitive reader
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader::primitives {
+
+    std::string integral (int64_t);
+    std::string integral (uint64_t);
+    std::string floating (double);
+
+    /**
+     * As above but appended to [out_], for formatting a run of them
+     * into one buffer
+     */
+    void integral (int64_t, std::string & out_);
+    void floating (double, std::string & out_);
+    std::string hex (const char *, std::size_t);
+    std::string utf8 (uint32_t);
+    std::string uuid (const pn_uuid_t &);
+
+    /**
+     * A string as JSON has it, escaped and with any malformed UTF-8
+     * replaced
+     */
+    std::string quoted (std::string_view);
+
+}
+
+/******************************************************************************
+ *
+ * Tags
+ *
+ * One per AMQP primitive, tying together the name the schema gives it,
+ * the proton type it's encoded as, how to pull it out of the tree and
+ * how it's rendered. Several share a C++ type, char and uint for example,
+ * hence the need for the tag.
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader::primitives {
+
+    struct Boolean {
+        static constexpr pn_type_t pnType = PN_BOOL;
+        static const std::string & type() { static const std::string t { "boolean" }; return t; }
+        static bool get (pn_data_t * d_) { return pn_data_get_bool (d_); }
+        static std::string format (bool v_) { return v_ ? "true" : "false"; }
+    };
+
+    struct Byte {
+        static constexpr pn_type_t pnType = PN_BYTE;
+        static const std::string & type() { static const std::string t { "byte" }; return t; }
+        static int8_t get (pn_data_t * d_) { return pn_data_get_byte (d_); }
+        static std::string format (int8_t v_) { return integral (int64_t { v_ }); }
+    };
+
+    struct UByte {
+        static constexpr pn_type_t pnType = PN_UBYTE;
+        static const std::string & type() { static const std::string t { "ubyte" }; return t; }
+        static uint8_t get (pn_data_t * d_) { return pn_data_get_ubyte (d_); }
+        static std::string format (uint8_t v_) { return integral (uint64_t { v_ }); }
+    };
+
+    struct Short {
+        static constexpr pn_type_t pnType = PN_SHORT;
+        static const std::string & type() { static const std::string t { "short" }; return t; }
+        static int16_t get (pn_data_t * d_) { return pn_data_get_short (d_); }
+        static std::string format (int16_t v_) { return integral (int64_t { v_ }); }
+    };
+
+    struct UShort {
+        static constexpr pn_type_t pnType = PN_USHORT;
+        static const std::string & type() { static const std::string t { "ushort" }; return t; }
+        static uint16_t get (pn_data_t * d_) { return pn_data_get_ushort (d_); }
+        static std::string format (uint16_t v_) { return integral (uint64_t { v_ }); }
+    };
+
+    struct Int {
+        static constexpr pn_type_t pnType = PN_INT;
+        static const std::string & type() { static const std::string t { "int" }; return t; }
+        static int32_t get (pn_data_t * d_) { return pn_data_get_int (d_); }
+        static std::string format (int32_t v_) { return integral (int64_t { v_ }); }
+    };
+
+    struct UInt {
+        static constexpr pn_type_t pnType = PN_UINT;
+        static const std::string & type() { static const std::string t { "uint" }; return t; }
+        static uint32_t get (pn_data_t * d_) { return pn_data_get_uint (d_); }
+        static std::string format (uint32_t v_) { return integral (uint64_t { v_ }); }
+    };
+
+    struct Long {
+        static constexpr pn_type_t pnType = PN_LONG;
+        static const std::string & type() { static const std::string t { "long" }; return t; }
+        static int64_t get (pn_data_t * d_) { return pn_data_get_long (d_); }
+        static std::string format (int64_t v_) { return integral (v_); }
+    };
+
+    struct ULong {
+        static constexpr pn_type_t pnType = PN_ULONG;
+        static const std::string & type() { static const std::string t { "ulong" }; return t; }
+        static uint64_t get (pn_data_t * d_) { return pn_data_get_ulong (d_); }
+        static std::string format (uint64_t v_) { return integral (v_); }
+    };
+
+    struct Float {
+        static constexpr pn_type_t pnType = PN_FLOAT;
+        static const std::string & type() { static const std::string t { "float" }; return t; }
+        static float get (pn_data_t * d_) { return pn_data_get_float (d_); }
+        static std::string format (float v_) { return floating (v_); }
+    };
+
+    struct Double {
+        static constexpr pn_type_t pnType = PN_DOUBLE;
+        static const std::string & type() { static const std::string t { "double" }; return t; }
+        static double get (pn_data_t * d_) { return pn_data_get_double (d_); }
+        static std::string format (double v_) { return floating (v_); }
+    };
+
+    struct Char {
+        static constexpr pn_type_t pnType = PN_CHAR;
+        static const std::string & type() { static const std::string t { "char" }; return t; }
+        static pn_char_t get (pn_data_t * d_) { return pn_data_get_char (d_); }
+        static std::string format (pn_char_t v_) { return primitives::quoted (utf8 (v_)); }
+    };
+
+    /**
+     * Milliseconds since the epoch
+     */
+    struct Timestamp {
+        static constexpr pn_type_t pnType = PN_TIMESTAMP;
+        static const std::string & type() { static const std::string t { "timestamp" }; return t; }
+        static pn_timestamp_t get (pn_data_t * d_) { return pn_data_get_timestamp (d_); }
+        static std::string format (pn_timestamp_t v_) { return integral (int64_t { v_ }); }
+    };
+
+    struct UUID {
+        static constexpr pn_type_t pnType = PN_UUID;
+        static const std::string & type() { static const std::string t { "uuid" }; return t; }
+        static pn_uuid_t get (pn_data_t * d_) { return pn_data_get_uuid (d_); }
+        static std::string format (const pn_uuid_t & v_) { return primitives::quoted (uuid (v_)); }
+    };
+
+    /**
+     * Nothing Corda writes uses the IEEE 754 decimal types so rather than
+     * decode them we just show their bits
+     */
+    struct Decimal32 {
+        static constexpr pn_type_t pnType = PN_DECIMAL32;
+        static const std::string & type() { static const std::string t { "decimal32" }; return t; }
+        static pn_decimal32_t get (pn_data_t * d_) { return pn_data_get_decimal32 (d_); }
+        static std::string format (pn_decimal32_t v_) { return hex (reinterpret_cast<const char *>(&v_), sizeof (v_)); }
+    };
+
+    struct Decimal64 {
+        static constexpr pn_type_t pnType = PN_DECIMAL64;
+        static const std::string & type() { static const std::string t { "decimal64" }; return t; }
+        static pn_decimal64_t get (pn_data_t * d_) { return pn_data_get_decimal64 (d_); }
+        static std::string format (pn_decimal64_t v_) { return hex (reinterpret_cast<const char *>(&v_), sizeof (v_)); }
+    };
+
+    struct Decimal128 {
+        static constexpr pn_type_t pnType = PN_DECIMAL128;
+        static const std::string & type() { static const std::string t { "decimal128" }; return t; }
+        static pn_decimal128_t get (pn_data_t * d_) { return pn_data_get_decimal128 (d_); }
+        static std::string format (const pn_decimal128_t & v_) { return hex (v_.bytes, sizeof (v_.bytes)); }
+    };
+
+    struct Binary {
+        static constexpr pn_type_t pnType = PN_BINARY;
+        static const std::string & type() { static const std::string t { "binary" }; return t; }
+        static std::string get (pn_data_t * d_) { auto b = pn_data_get_binary (d_); return { b.start, b.size }; }
+        static std::string_view view (pn_data_t * d_) { auto b = pn_data_get_binary (d_); return { b.start, b.size }; }
+        static std::string format (std::string_view v_) { return binary::render (v_); }
+    };
+
+    struct Symbol {
+        static constexpr pn_type_t pnType = PN_SYMBOL;
+        static const std::string & type() { static const std::string t { "symbol" }; return t; }
+        static std::string get (pn_data_t * d_) { auto b = pn_data_get_symbol (d_); return { b.start, b.size }; }
+        static std::string_view view (pn_data_t * d_) { auto b = pn_data_get_symbol (d_); return { b.start, b.size }; }
+        static std::string format (std::string_view v_) { return quoted (v_); }
+    };
+
+    struct String {
+        static constexpr pn_type_t pnType = PN_STRING;
+        static const std::string & type() { static const std::string t { "string" }; return t; }
+        static std::string get (pn_data_t * d_) { auto b = pn_data_get_string (d_); return { b.start, b.size }; }
+        static std::string_view view (pn_data_t * d_) { auto b = pn_data_get_string (d_); return { b.start, b.size }; }
+        static std::string format (std::string_view v_) { return quoted (v_); }
+    };
+
+    /**
+     * Tags that can format a value straight from the bytes proton holds,
+     * without copying them out first
+     */
+    template<class Tag, typename = void>
+    struct viewable : std::false_type { };
+
+    template<class Tag>
+    struct viewable<Tag, std::void_t<decltype (Tag::view (nullptr))>> : std::true_type { };
+
+}
+
+/******************************************************************************
+ *
+ * class PrimitiveReader
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    template<typename T, class Tag, class Policy = Strict>
+    class PrimitiveReader : public PropertyReader {
+        static_assert (std::is_same_v<T, decltype (Tag::get (nullptr))>);
+
+        private :
+            /**
+             * Null is a perfectly reasonable value for a boxed primitive
+             * so we need to be able to say we didn't read anything
+             */
+            static bool readNull (pn_data_t * data_) {
+                if (pn_data_type (data_) == PN_NULL) {
+                    pn_data_next (data_);
+                    return true;
+                }
+
+                return false;
+            }
+
+            /**
+             * With [view_] set, only for a [viewable] tag, what we hand
+             * back is a view of the bytes in [data_]
+             */
+            template<bool view_ = false>
+            static auto readAndNext (pn_data_t * data_) {
+                if constexpr (Policy::validate) {
+                    if (pn_data_type (data_) != Tag::pnType) {
+                        std::stringstream ss;
+                        ss << "Expected a " << Tag::type() << " but found ["
+                           << data_ << "]";
+                        throw std::runtime_error (ss.str());
+                    }
+                }
+
+                proton::auto_next an (data_);
+
+                if constexpr (view_) {
+                    return Tag::view (data_);
+                } else {
+                    return Tag::get (data_);
+                }
+            }
+
+            /**
+             * A binary that's a whole Corda blob, nullptr for anything else
+             */
+            static uPtr<amqp::reader::IValue> nested (
+                pn_data_t * data_,
+                const std::string * name_
+            ) {
+                if constexpr (std::is_same_v<Tag, primitives::Binary>) {
+                    if (pn_data_type (data_) == PN_BINARY) {
+                        auto b = pn_data_get_binary (data_);
+
+                        if (auto rtn = Nested::value ({ b.start, b.size }, name_)) {
+                            Budget::node();
+                            pn_data_next (data_);
+
+                            return rtn;
+                        }
+                    }
+                }
+
+                return nullptr;
+            }
+
+        public :
+            using tag_type = Tag;
+
+            PrimitiveReader() = default;
+            ~PrimitiveReader() override = default;
+
+            std::any read (pn_data_t * data_) const override {
+                Budget::node();
+
+                if (readNull (data_)) {
+                    return std::any();
+                }
+
+                return std::any { readAndNext (data_) };
+            }
+
+            std::string readString (pn_data_t * data_) const override {
+                Budget::node();
+
+                if (readNull (data_)) {
+                    return "null";
+                }
+
+                auto rtn = Tag::format (readAndNext<primitives::viewable<Tag>::value> (data_));
+                Budget::bytes (rtn.size());
+
+                return rtn;
+            }
+
+            uPtr<amqp::reader::IValue> dump (
+                const std::string & name_,
+                pn_data_t * data_,
+                const SchemaType &
+            ) const override {
+                if (auto rtn = nested (data_, &name_)) {
+                    return rtn;
+                }
+
+                return std::make_unique<TypedPair<std::string>> (
+                        name_,
+                        readString (data_));
+            }
+
+            uPtr<amqp::reader::IValue> dump (
+                pn_data_t * data_,
+                const SchemaType &
+            ) const override {
+                if (auto rtn = nested (data_, nullptr)) {
+                    return rtn;
+                }
+
+                return std::make_unique<TypedSingle<std::string>> (
+                        readString (data_));
+            }
+
+            const std::string & name() const override {
+                static const std::string name { Tag::type() + " Reader" };
+                return name;
+            }
+
+            const std::string & type() const override {
+                return Tag::type();
+            }
+    };
+
+}
+
+/******************************************************************************/
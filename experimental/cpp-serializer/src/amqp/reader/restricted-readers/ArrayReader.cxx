@@ -1,40 +1,113 @@
 #include "ArrayReader.h"
 
+#include <vector>
+#include <type_traits>
+
 #include "proton/proton_wrapper.h"
 
+#include "amqp/Budget.h"
+#include "amqp/reader/property-readers/PrimitiveReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::reader;
+
+    pn_type_t
+    numbers (const Reader * reader_) {
+        const auto & type = reader_->type();
+
+        if (type == primitives::Short::type()) return PN_SHORT;
+        if (type == primitives::Int::type()) return PN_INT;
+        if (type == primitives::Long::type()) return PN_LONG;
+        if (type == primitives::Float::type()) return PN_FLOAT;
+        if (type == primitives::Double::type()) return PN_DOUBLE;
+
+        return PN_NULL;
+    }
+
+    /**
+     * Read elements into a buffer for as long as they're [Tag]s and
+     * format the lot, returning how many that was. Anything else, the
+     * nulls a boxed array can hold for instance, is left to the caller.
+     */
+    template<class Tag>
+    std::size_t
+    bulk (pn_data_t * data_, std::size_t elements_, std::string & out_) {
+        using T = decltype (Tag::get (data_));
+
+        std::vector<T> values;
+        values.reserve (elements_);
+
+        while (values.size() < elements_ && pn_data_type (data_) == Tag::pnType) {
+            amqp::internal::Budget::node();
+            values.push_back (Tag::get (data_));
+            pn_data_next (data_);
+        }
+
+        // a guess at the usual width, it's only a reservation
+        out_.reserve (out_.size() + values.size() * (std::is_floating_point_v<T> ? 14 : 8));
+
+        for (std::size_t i { 0 } ; i < values.size() ; ++i) {
+            if (i) out_ += ", ";
+
+            if constexpr (std::is_floating_point_v<T>) {
+                primitives::floating (values[i], out_);
+            } else {
+                primitives::integral (int64_t { values[i] }, out_);
+            }
+        }
+
+        return values.size();
+    }
+
+}
+
 /******************************************************************************
  *
  * class ArrayReader
  *
  ******************************************************************************/
 
+template<class Policy>
 amqp::internal::reader::
-ArrayReader::ArrayReader (
+ArrayReader<Policy>::ArrayReader (
     std::string type_,
-    std::weak_ptr<Reader> reader_
-) : RestrictedReader (std::move (type_))
-  , m_reader (std::move (reader_))
+    std::string descriptor_,
+    const Reader * reader_
+) : RestrictedReader (std::move (type_), std::move (descriptor_))
+  , m_reader (reader_)
+  , m_numbers (::numbers (reader_))
 { }
 
 /******************************************************************************/
 
+template<class Policy>
 amqp::internal::schema::Restricted::RestrictedTypes
 amqp::internal::reader::
-ArrayReader::restrictedType() const {
+ArrayReader<Policy>::restrictedType() const {
     return internal::schema::Restricted::RestrictedTypes::array_t;
 }
 
 /******************************************************************************/
 
+template<class Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-ArrayReader::dump (
+ArrayReader<Policy>::dump (
         const std::string & name_,
         pn_data_t * data_,
         const SchemaType & schema_
 ) const {
     proton::auto_next an (data_);
 
+    if (m_numbers != PN_NULL) {
+        return std::make_unique<TypedPair<std::string>> (
+                name_,
+                numbers (data_, schema_));
+    }
+
     return std::make_unique<TypedPair<sList<uPtr<amqp::reader::IValue>>>>(
             name_,
             dump_ (data_, schema_));
@@ -42,39 +115,50 @@ ArrayReader::dump (
 
 /******************************************************************************/
 
+template<class Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-ArrayReader::dump(
+ArrayReader<Policy>::dump(
         pn_data_t * data_,
         const SchemaType & schema_
 ) const {
     proton::auto_next an (data_);
 
+    if (m_numbers != PN_NULL) {
+        return std::make_unique<TypedSingle<std::string>> (
+                numbers (data_, schema_));
+    }
+
     return std::make_unique<TypedSingle<sList<uPtr<amqp::reader::IValue>>>>(
             dump_ (data_, schema_));
 }
 
 /******************************************************************************/
 
+template<class Policy>
 sList<uPtr<amqp::reader::IValue>>
 amqp::internal::reader::
-ArrayReader::dump_(
+ArrayReader<Policy>::dump_(
         pn_data_t * data_,
         const SchemaType & schema_
 ) const {
-    proton::is_described (data_);
+    Budget::Frame frame;
+
+    Check<Policy>::described (data_);
 
     decltype (dump_ (data_, schema_)) read;
 
     {
         proton::auto_enter ae (data_);
-        schema_.fromDescriptor (proton::readAndNext<std::string>(data_));
+        Check<Policy>::symbol (data_, m_descriptor);
+        pn_data_next (data_);
 
         {
             proton::auto_list_enter ale (data_, true);
+            Budget::elements (ale.elements());
 
             for (size_t i { 0 } ; i < ale.elements() ; ++i) {
-                read.emplace_back (m_reader.lock()->dump (data_, schema_));
+                read.emplace_back (m_reader->dump (data_, schema_));
             }
         }
     }
@@ -84,3 +168,60 @@ ArrayReader::dump_(
 
 /******************************************************************************/
 
+/**
+ * Rendered exactly as [dump_]'s list of values would be
+ */
+template<class Policy>
+std::string
+amqp::internal::reader::
+ArrayReader<Policy>::numbers (
+        pn_data_t * data_,
+        const SchemaType & schema_
+) const {
+    Budget::Frame frame;
+
+    Check<Policy>::described (data_);
+
+    std::string rtn { "[ " };
+
+    {
+        proton::auto_enter ae (data_);
+        Check<Policy>::symbol (data_, m_descriptor);
+        pn_data_next (data_);
+
+        {
+            proton::auto_list_enter ale (data_, true);
+            Budget::elements (ale.elements());
+
+            std::size_t read { 0 };
+
+            switch (m_numbers) {
+                case PN_SHORT  : read = bulk<primitives::Short> (data_, ale.elements(), rtn); break;
+                case PN_INT    : read = bulk<primitives::Int> (data_, ale.elements(), rtn); break;
+                case PN_LONG   : read = bulk<primitives::Long> (data_, ale.elements(), rtn); break;
+                case PN_FLOAT  : read = bulk<primitives::Float> (data_, ale.elements(), rtn); break;
+                case PN_DOUBLE : read = bulk<primitives::Double> (data_, ale.elements(), rtn); break;
+                default : break;
+            }
+
+            // whatever stopped the run, and everything after it, is read
+            // as any other array's elements are
+            for ( ; read < ale.elements() ; ++read) {
+                if (read) rtn += ", ";
+                rtn += m_reader->dump (data_, schema_)->dump();
+            }
+        }
+    }
+
+    rtn += " ]";
+    Budget::bytes (rtn.size());
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+template class amqp::internal::reader::ArrayReader<amqp::internal::reader::Strict>;
+template class amqp::internal::reader::ArrayReader<amqp::internal::reader::Trusted>;
+
+/******************************************************************************/
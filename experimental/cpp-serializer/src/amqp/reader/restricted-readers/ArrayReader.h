@@ -3,27 +3,40 @@
 /******************************************************************************/
 
 #include "RestrictedReader.h"
+#include "amqp/reader/Policy.h"
+
+#include <proton/codec.h>
 
 /******************************************************************************/
 
 namespace amqp::internal::reader {
 
+    template<class Policy>
     class ArrayReader : public RestrictedReader {
         private :
-            // How to read the underlying types
-            std::weak_ptr<Reader> m_reader;
+            // How to read the underlying types, owned by the factory
+            const Reader * m_reader;
+
+            /**
+             * The proton type of our elements if they're numbers, which
+             * are read into one buffer and formatted in a single pass
+             * rather than given a value apiece, PN_NULL otherwise
+             */
+            const pn_type_t m_numbers;
 
             std::list<uPtr<amqp::reader::IValue>> dump_(
                 pn_data_t *,
                 const SchemaType &) const;
 
+            std::string numbers (pn_data_t *, const SchemaType &) const;
+
             /**
              * cope with the fact Java can box primitives
              */
             std::string m_primType;
 
         public :
-            ArrayReader (std::string, std::weak_ptr<Reader>);
+            ArrayReader (std::string, std::string, const Reader *);
 
             ~ArrayReader() final = default;
 
@@ -1,94 +1,188 @@
 #include "EnumReader.h"
 
+#include <algorithm>
+#include <string_view>
+
+#include "debug.h"
+
 #include "amqp/reader/IReader.h"
 #include "amqp/schema/Descriptors.h"
 #include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
 #include "proton/proton_wrapper.h"
 
+#include "amqp/Budget.h"
+
 /******************************************************************************/
 
+template<class Policy>
 amqp::internal::reader::
-EnumReader::EnumReader (
+EnumReader<Policy>::EnumReader (
     std::string type_,
+    std::string descriptor_,
     std::vector<std::string> choices_
-) : RestrictedReader (std::move (type_))
-  , m_choices (std::move (choices_)
-) {
+) : RestrictedReader (std::move (type_), std::move (descriptor_))
+  , m_choices (std::move (choices_))
+  , m_values (m_choices)
+{
+
+}
+
+/******************************************************************************/
 
+template<class Policy>
+amqp::internal::reader::
+EnumReader<Policy>::EnumReader (
+    std::string type_,
+    std::string descriptor_,
+    std::vector<std::string> choices_,
+    std::vector<std::string> values_
+) : RestrictedReader (std::move (type_), std::move (descriptor_))
+  , m_choices (std::move (choices_))
+  , m_values (std::move (values_))
+{
+    if (m_values.size() != m_choices.size()) {
+        throw std::runtime_error ("Every enum constant needs a value");
+    }
 }
 
 /******************************************************************************/
 
 namespace {
 
-    std::string
-    getValue (pn_data_t * data_) {
-        proton::is_described (data_);
-
-        {
-            proton::auto_enter ae (data_);
-
-            /*
-             * Referenced objects are added to a stream when the serialiser
-             * notices it's writing a value it's already written, so to save
-             * space it will just link back to that. Currently we have
-             * no mechanism for decoding that so just throw an error
-             */
-            if (pn_data_type (data_) == PN_ULONG) {
-                if (amqp::stripCorda(pn_data_get_ulong(data_)) ==
+    template<class Policy>
+    void
+    checkDescriptor (pn_data_t * data_, const std::string & descriptor_) {
+        /*
+         * Referenced objects are added to a stream when the serialiser
+         * notices it's writing a value it's already written, so to save
+         * space it will just link back to that. Currently we have
+         * no mechanism for decoding that so just throw an error
+         */
+        if (pn_data_type (data_) == PN_ULONG) {
+            if (amqp::stripCorda(pn_data_get_ulong(data_)) ==
                 amqp::schema::descriptors::REFERENCED_OBJECT
             ) {
-                    throw std::runtime_error (
-                            "Currently don't support referenced objects");
-                }
+                throw std::runtime_error (
+                        "Currently don't support referenced objects");
             }
+        }
+
+        amqp::internal::reader::Check<Policy>::symbol (data_, descriptor_);
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * An enum is written as its constant's name followed by its ordinal. We
+ * read the ordinal and check it against the name rather than build a new
+ * string, the value we return just refers to our copy of the name.
+ *
+ * The only time they won't agree is when the class has evolved since the
+ * schema we've been given was written, in which case the name is what
+ * counts.
+ *
+ * @param name_ the property being read, nullptr if it's an element of
+ * a container
+ */
+template<class Policy>
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+EnumReader<Policy>::read (
+    const std::string * name_,
+    pn_data_t * data_
+) const {
+    Budget::node();
 
-            auto fingerprint = proton::readAndNext<std::string>(data_);
+    proton::auto_next an (data_);
+    Check<Policy>::described (data_);
 
-            proton::auto_list_enter ale (data_, true);
+    proton::auto_enter ae (data_);
+    checkDescriptor<Policy> (data_, m_descriptor);
+    pn_data_next (data_);
 
-            return proton::readAndNext<std::string>(data_);
+    proton::auto_list_enter ale (data_, true);
 
-            /*
-             * After a string representation of the enumerated value
-             * the ordinal value is also encoded. We don't need that for
-             * just dumping things to a string but if I don't leave this
-             * here I'll forget its even a thing
-             */
-            // auto idx = proton::readAndNext<int>(data_);
+    if constexpr (Policy::validate) {
+        if (pn_data_type (data_) != PN_STRING) {
+            throw std::runtime_error ("Expected an enum constant name");
         }
     }
+
+    auto bytes = pn_data_get_string (data_);
+    std::string_view constant { bytes.start, bytes.size };
+
+    const std::string * choice { nullptr };
+
+    if (pn_data_next (data_) && pn_data_type (data_) == PN_INT) {
+        auto ordinal = pn_data_get_int (data_);
+
+        if (ordinal >= 0
+            && static_cast<std::size_t>(ordinal) < m_choices.size()
+            && m_choices[ordinal] == constant
+        ) {
+            choice = &m_values[ordinal];
+        }
+    }
+
+    if (!choice) {
+        auto it = std::find (m_choices.begin(), m_choices.end(), constant);
+
+        if (it != m_choices.end()) {
+            choice = &m_values[it - m_choices.begin()];
+        }
+    }
+
+    if (choice) {
+        std::string_view view { *choice };
+
+        if (name_) {
+            return std::make_unique<TypedPair<std::string_view>> (*name_, view);
+        }
+
+        return std::make_unique<TypedSingle<std::string_view>> (view);
+    }
+
+    DBG ("Unknown enum constant " << constant << std::endl); // NOLINT
+
+    if (name_) {
+        return std::make_unique<TypedPair<std::string>> (
+                *name_,
+                std::string (constant));
+    }
+
+    return std::make_unique<TypedSingle<std::string>> (std::string (constant));
 }
 
 /******************************************************************************/
 
+template<class Policy>
 std::unique_ptr<amqp::reader::IValue>
 amqp::internal::reader::
-EnumReader::dump (
+EnumReader<Policy>::dump (
         const std::string & name_,
         pn_data_t * data_,
         const SchemaType & schema_
 ) const {
-    proton::auto_next an (data_);
-    proton::is_described (data_);
-
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            getValue(data_));
+    return read (&name_, data_);
 }
 
 /******************************************************************************/
 
+template<class Policy>
 std::unique_ptr<amqp::reader::IValue>
 amqp::internal::reader::
-EnumReader::dump(
+EnumReader<Policy>::dump(
         pn_data_t * data_,
         const SchemaType & schema_
 ) const {
-    proton::auto_next an (data_);
-    proton::is_described (data_);
-
-    return std::make_unique<TypedSingle<std::string>> (getValue(data_));
+    return read (nullptr, data_);
 }
 
 /******************************************************************************/
+
+template class amqp::internal::reader::EnumReader<amqp::internal::reader::Strict>;
+template class amqp::internal::reader::EnumReader<amqp::internal::reader::Trusted>;
+
+/******************************************************************************/
@@ -1,16 +1,41 @@
 #pragma once
 
 #include "RestrictedReader.h"
+#include "amqp/reader/Policy.h"
 
 /******************************************************************************/
 
 namespace amqp::internal::reader {
 
+    template<class Policy>
     class EnumReader : public RestrictedReader {
         private :
+            /**
+             * The constant names indexed by ordinal
+             */
             std::vector<std::string> m_choices;
+
+            /**
+             * What each constant reads as, the constants themselves
+             * unless the enum has evolved since the blob was written
+             */
+            std::vector<std::string> m_values;
+
+            uPtr<amqp::reader::IValue> read (
+                const std::string *,
+                pn_data_t *) const;
+
         public :
-            EnumReader (std::string, std::vector<std::string>);
+            EnumReader (std::string, std::string, std::vector<std::string>);
+
+            /**
+             * @param values_ what each of [choices_] should read as
+             */
+            EnumReader (
+                std::string,
+                std::string,
+                std::vector<std::string> choices_,
+                std::vector<std::string> values_);
 
             std::unique_ptr<amqp::reader::IValue> dump(
                 const std::string &,
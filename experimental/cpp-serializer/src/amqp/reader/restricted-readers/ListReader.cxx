@@ -2,23 +2,27 @@
 
 #include "proton/proton_wrapper.h"
 
+#include "amqp/Budget.h"
+
 /******************************************************************************
  *
  * class ListReader
  *
  ******************************************************************************/
 
+template<class Policy>
 amqp::internal::schema::Restricted::RestrictedTypes
 amqp::internal::reader::
-ListReader::restrictedType() const {
+ListReader<Policy>::restrictedType() const {
     return internal::schema::Restricted::RestrictedTypes::list_t;
 }
 
 /******************************************************************************/
 
+template<class Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-ListReader::dump (
+ListReader<Policy>::dump (
     const std::string & name_,
     pn_data_t * data_,
     const SchemaType & schema_
@@ -32,9 +36,10 @@ ListReader::dump (
 
 /******************************************************************************/
 
+template<class Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-ListReader::dump(
+ListReader<Policy>::dump(
     pn_data_t * data_,
     const SchemaType & schema_
 ) const {
@@ -46,25 +51,30 @@ ListReader::dump(
 
 /******************************************************************************/
 
+template<class Policy>
 sList<uPtr<amqp::reader::IValue>>
 amqp::internal::reader::
-ListReader::dump_(
+ListReader<Policy>::dump_(
         pn_data_t * data_,
         const SchemaType & schema_
 ) const {
-    proton::is_described (data_);
+    Budget::Frame frame;
+
+    Check<Policy>::described (data_);
 
     decltype (dump_(data_, schema_)) read;
 
     {
         proton::auto_enter ae (data_);
-        schema_.fromDescriptor (proton::readAndNext<std::string>(data_));
+        Check<Policy>::symbol (data_, m_descriptor);
+        pn_data_next (data_);
 
         {
             proton::auto_list_enter ale (data_, true);
+            Budget::elements (ale.elements());
 
             for (size_t i { 0 } ; i < ale.elements() ; ++i) {
-                read.emplace_back (m_reader.lock()->dump (data_, schema_));
+                read.emplace_back (m_reader->dump (data_, schema_));
             }
         }
     }
@@ -73,3 +83,8 @@ ListReader::dump_(
 }
 
 /******************************************************************************/
+
+template class amqp::internal::reader::ListReader<amqp::internal::reader::Strict>;
+template class amqp::internal::reader::ListReader<amqp::internal::reader::Trusted>;
+
+/******************************************************************************/
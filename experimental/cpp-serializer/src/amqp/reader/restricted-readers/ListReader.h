@@ -3,15 +3,17 @@
 /******************************************************************************/
 
 #include "RestrictedReader.h"
+#include "amqp/reader/Policy.h"
 
 /******************************************************************************/
 
 namespace amqp::internal::reader {
 
+    template<class Policy>
     class ListReader : public RestrictedReader {
         private :
-            // How to read the underlying types
-            std::weak_ptr<Reader> m_reader;
+            // How to read the underlying types, owned by the factory
+            const Reader * m_reader;
 
             std::list<uPtr<amqp::reader::IValue>> dump_(
                 pn_data_t *,
@@ -20,9 +22,10 @@ namespace amqp::internal::reader {
         public :
             ListReader (
                 const std::string & type_,
-                std::weak_ptr<Reader> reader_
-            ) : RestrictedReader (type_)
-              , m_reader (std::move (reader_))
+                const std::string & descriptor_,
+                const Reader * reader_
+            ) : RestrictedReader (type_, descriptor_)
+              , m_reader (reader_)
             { }
 
             ~ListReader() final = default;
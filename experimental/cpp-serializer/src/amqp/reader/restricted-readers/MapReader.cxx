@@ -4,45 +4,56 @@
 #include "amqp/reader/IReader.h"
 #include "proton/proton_wrapper.h"
 
+#include "amqp/Budget.h"
+
 /******************************************************************************/
 
+template<class Policy>
 amqp::internal::schema::Restricted::RestrictedTypes
 amqp::internal::reader::
-MapReader::restrictedType() const {
+MapReader<Policy>::restrictedType() const {
     return schema::Restricted::Restricted::map_t;
 }
 
 /******************************************************************************/
 
+template<class Policy>
 sVec<uPtr<amqp::reader::IValue>>
 amqp::internal::reader::
-MapReader::dump_(
+MapReader<Policy>::dump_(
     pn_data_t * data_,
     const SchemaType & schema_
 ) const {
-    proton::is_described (data_);
+    Budget::Frame frame;
+
+    Check<Policy>::described (data_);
     proton::auto_enter ae (data_);
 
-    // gloss over fetching the descriptor from the schema since
-    // we don't need it, we know the types this is a reader for
-    // and don't need context from the schema as there isn't
-    // any. Maps have a Key and a Value, they aren't named
-    // parameters, unlike composite types.
-    schema_.fromDescriptor (proton::readAndNext<std::string>(data_));
+    // no need to go anywhere near the schema, we know the types this
+    // is a reader for and there isn't any context it could give us.
+    // Maps have a Key and a Value, they aren't named parameters,
+    // unlike composite types.
+    Check<Policy>::symbol (data_, m_descriptor);
+    pn_data_next (data_);
 
     {
         proton::auto_map_enter am (data_, true);
+        Budget::elements (am.elements());
 
         decltype (dump_(data_, schema_)) rtn;
         rtn.reserve (am.elements() / 2);
 
         for (int i {0} ; i < am.elements() ; i += 2) {
+            // the order in which function arguments are evaluated is
+            // unspecified so the key must be read before we go near
+            // the value
+            auto key = m_keyReader->dump (data_, schema_);
+            auto value = m_valueReader->dump (data_, schema_);
+
             rtn.emplace_back (
                 std::make_unique<ValuePair> (
-                    m_keyReader.lock()->dump (data_, schema_),
-                    m_valueReader.lock()->dump (data_, schema_)
-                )
-            );
+                    std::move (key),
+                    std::move (value)));
         }
 
         return rtn;
@@ -51,9 +62,10 @@ MapReader::dump_(
 
 /******************************************************************************/
 
+template<class Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-MapReader::dump(
+MapReader<Policy>::dump(
         const std::string & name_,
         pn_data_t * data_,
         const SchemaType & schema_
@@ -67,9 +79,10 @@ MapReader::dump(
 
 /******************************************************************************/
 
+template<class Policy>
 std::unique_ptr<amqp::reader::IValue>
 amqp::internal::reader::
-MapReader::dump(
+MapReader<Policy>::dump(
         pn_data_t * data_,
         const SchemaType & schema_
 ) const  {
@@ -80,3 +93,8 @@ MapReader::dump(
 }
 
 /******************************************************************************/
+
+template class amqp::internal::reader::MapReader<amqp::internal::reader::Strict>;
+template class amqp::internal::reader::MapReader<amqp::internal::reader::Trusted>;
+
+/******************************************************************************/
@@ -3,16 +3,18 @@
 /******************************************************************************/
 
 #include "RestrictedReader.h"
+#include "amqp/reader/Policy.h"
 
 /******************************************************************************/
 
 namespace amqp::internal::reader {
 
+    template<class Policy>
     class MapReader : public RestrictedReader {
         private :
-            // How to read the underlying types
-            std::weak_ptr<Reader> m_keyReader;
-            std::weak_ptr<Reader> m_valueReader;
+            // How to read the underlying types, owned by the factory
+            const Reader * m_keyReader;
+            const Reader * m_valueReader;
 
             sVec<uPtr<amqp::reader::IValue>> dump_(
                     pn_data_t *,
@@ -21,11 +23,12 @@ namespace amqp::internal::reader {
         public :
             MapReader (
                 const std::string & type_,
-                std::weak_ptr<Reader> keyReader_,
-                std::weak_ptr<Reader> valueReader_
-            ) : RestrictedReader (type_)
-              , m_keyReader (std::move (keyReader_))
-              , m_valueReader (std::move (valueReader_))
+                const std::string & descriptor_,
+                const Reader * keyReader_,
+                const Reader * valueReader_
+            ) : RestrictedReader (type_, descriptor_)
+              , m_keyReader (keyReader_)
+              , m_valueReader (valueReader_)
             { }
 
             ~MapReader() final = default;
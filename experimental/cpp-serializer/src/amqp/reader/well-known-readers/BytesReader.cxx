@@ -0,0 +1,165 @@
+#include "BytesReader.h"
+
+#include <array>
+#include <algorithm>
+
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+
+#include "amqp/Budget.h"
+#include "amqp/Binary.h"
+#include "amqp/Nested.h"
+
+namespace {
+
+    pn_bytes_t
+    asBinary (pn_data_t * data_) {
+        if (pn_data_type (data_) != PN_BINARY) {
+            throw std::runtime_error ("Expected binary");
+        }
+
+        return pn_data_get_binary (data_);
+    }
+
+}
+
+/******************************************************************************
+ *
+ * BytesReader
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+BytesReader::BytesReader (
+    std::string type_,
+    bool wrapped_
+) : WellKnownReader (std::move (type_))
+  , m_wrapped (wrapped_)
+{ }
+
+/******************************************************************************/
+
+/**
+ * The bytes remain owned by the proton tree so are only good until it
+ * changes
+ */
+pn_bytes_t
+amqp::internal::reader::
+BytesReader::bytes (pn_data_t * data_) const {
+    proton::is_described (data_);
+    proton::auto_enter ae (data_);
+    proton::is_symbol (data_);
+    pn_data_next (data_);
+
+    if (m_wrapped) {
+        proton::is_list (data_);
+        proton::auto_enter ae2 (data_);
+
+        return asBinary (data_);
+    }
+
+    return asBinary (data_);
+}
+
+/******************************************************************************/
+
+std::any
+amqp::internal::reader::
+BytesReader::read (pn_data_t * data_) const {
+    proton::auto_next an (data_);
+
+    auto b = bytes (data_);
+
+    return std::any { std::vector<uint8_t> (b.start, b.start + b.size) };
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+BytesReader::render (pn_data_t * data_) const {
+    auto b = bytes (data_);
+
+    return binary::render ({ b.start, b.size });
+}
+
+/**
+ * OpaqueBytes is what Corda wraps most of the blobs it nests in, the
+ * components of a transaction for instance
+ */
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+BytesReader::nested (pn_data_t * data_, const std::string * name_) const {
+    auto b = bytes (data_);
+
+    auto rtn = Nested::value ({ b.start, b.size }, name_);
+
+    if (rtn) {
+        Budget::node();
+        pn_data_next (data_);
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+BytesReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_
+) const {
+    if (auto rtn = nested (data_, &name_)) {
+        return rtn;
+    }
+
+    return WellKnownReader::dump (name_, data_, schema_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+BytesReader::dump (pn_data_t * data_, const SchemaType & schema_) const {
+    if (auto rtn = nested (data_, nullptr)) {
+        return rtn;
+    }
+
+    return WellKnownReader::dump (data_, schema_);
+}
+
+/******************************************************************************
+ *
+ * SHA256Reader
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+SHA256Reader::SHA256Reader()
+    : BytesReader ("net.corda.core.crypto.SecureHash$SHA256", true)
+{ }
+
+/******************************************************************************/
+
+std::any
+amqp::internal::reader::
+SHA256Reader::read (pn_data_t * data_) const {
+    proton::auto_next an (data_);
+
+    auto b = bytes (data_);
+
+    std::array<uint8_t, 32> rtn { };
+
+    if (b.size != rtn.size()) {
+        throw std::runtime_error ("A SHA256 hash must be 32 bytes");
+    }
+
+    std::copy (b.start, b.start + b.size, rtn.begin());
+
+    return std::any { rtn };
+}
+
+/******************************************************************************/
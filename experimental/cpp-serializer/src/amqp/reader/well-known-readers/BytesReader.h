@@ -0,0 +1,69 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "WellKnownReader.h"
+
+#include <vector>
+#include <cstdint>
+
+#include <proton/types.h>
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Types that boil down to an opaque run of bytes. Either a described
+     * binary, PublicKey for example, or a composite whose only property
+     * is that binary, as with OpaqueBytes and SecureHash.
+     *
+     * Rendered as the [Rendering] in scope says, by default as upper case
+     * hex to match Corda's own toString
+     */
+    class BytesReader : public WellKnownReader {
+        private :
+            const bool m_wrapped;
+
+        protected :
+            pn_bytes_t bytes (pn_data_t *) const;
+
+            std::string render (pn_data_t *) const override;
+
+            /**
+             * Our bytes if they're a whole Corda blob, nullptr otherwise
+             */
+            uPtr<amqp::reader::IValue> nested (
+                pn_data_t *,
+                const std::string *) const;
+
+        public :
+            BytesReader (std::string, bool);
+
+            std::any read (pn_data_t *) const override;
+
+            uPtr<amqp::reader::IValue> dump(
+                const std::string &,
+                pn_data_t *,
+                const SchemaType &) const override;
+
+            uPtr<amqp::reader::IValue> dump(
+                pn_data_t *,
+                const SchemaType &) const override;
+    };
+
+    /******************************************************************************/
+
+    /**
+     * As a [BytesReader] but knowing there are exactly 32 of them
+     */
+    class SHA256Reader : public BytesReader {
+        public :
+            SHA256Reader();
+
+            std::any read (pn_data_t *) const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,125 @@
+#include "InstantReader.h"
+
+#include <iomanip>
+#include <sstream>
+
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Days since the epoch to a proleptic Gregorian year, month and day,
+     * see http://howardhinnant.github.io/date_algorithms.html
+     */
+    void
+    civil (int64_t days_, int64_t & year_, int & month_, int & day_) {
+        days_ += 719468;
+
+        const int64_t era = (days_ >= 0 ? days_ : days_ - 146096) / 146097;
+        const int64_t doe = days_ - era * 146097;
+        const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const int64_t mp  = (5 * doy + 2) / 153;
+
+        day_   = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+        month_ = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+        year_  = yoe + era * 400 + (month_ <= 2);
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::
+InstantReader::InstantReader() : WellKnownReader ("java.time.Instant") {
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::InstantReader::Instant
+amqp::internal::reader::
+InstantReader::instant (pn_data_t * data_) {
+    proton::is_described (data_);
+    proton::auto_enter ae (data_);
+    proton::is_symbol (data_);
+    pn_data_next (data_);
+    proton::is_list (data_);
+
+    proton::auto_enter ae2 (data_);
+
+    if (pn_data_type (data_) != PN_LONG) {
+        throw std::runtime_error ("Expected the seconds of an Instant");
+    }
+
+    auto seconds = pn_data_get_long (data_);
+    pn_data_next (data_);
+
+    if (pn_data_type (data_) != PN_INT) {
+        throw std::runtime_error ("Expected the nanoseconds of an Instant");
+    }
+
+    return { seconds, pn_data_get_int (data_) };
+}
+
+/******************************************************************************/
+
+std::any
+amqp::internal::reader::
+InstantReader::read (pn_data_t * data_) const {
+    proton::auto_next an (data_);
+
+    return std::any { instant (data_) };
+}
+
+/******************************************************************************/
+
+/**
+ * ISO-8601 in UTC, as Instant.toString does, showing as many groups of
+ * three fractional digits as are needed
+ */
+std::string
+amqp::internal::reader::
+InstantReader::render (pn_data_t * data_) const {
+    auto i = instant (data_);
+
+    int64_t days = i.seconds / 86400;
+    int64_t secs = i.seconds % 86400;
+
+    if (secs < 0) {
+        secs += 86400;
+        --days;
+    }
+
+    int64_t year;
+    int month, day;
+    civil (days, year, month, day);
+
+    std::stringstream ss;
+    ss << std::setfill ('0')
+        << std::setw (4) << year << "-"
+        << std::setw (2) << month << "-"
+        << std::setw (2) << day << "T"
+        << std::setw (2) << secs / 3600 << ":"
+        << std::setw (2) << (secs / 60) % 60 << ":"
+        << std::setw (2) << secs % 60;
+
+    if (i.nanos != 0) {
+        if (i.nanos % 1000000 == 0) {
+            ss << "." << std::setw (3) << i.nanos / 1000000;
+        } else if (i.nanos % 1000 == 0) {
+            ss << "." << std::setw (6) << i.nanos / 1000;
+        } else {
+            ss << "." << std::setw (9) << i.nanos;
+        }
+    }
+
+    ss << "Z";
+
+    return ss.str();
+}
+
+/******************************************************************************/
@@ -0,0 +1,38 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "WellKnownReader.h"
+
+#include <cstdint>
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * java.time.Instant, written through a proxy holding the seconds
+     * since the epoch and the nanoseconds into that second
+     */
+    class InstantReader : public WellKnownReader {
+        public :
+            struct Instant {
+                int64_t seconds;
+                int32_t nanos;
+            };
+
+        private :
+            static Instant instant (pn_data_t *);
+
+        protected :
+            std::string render (pn_data_t *) const override;
+
+        public :
+            InstantReader();
+
+            std::any read (pn_data_t *) const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,37 @@
+#include "ToStringReader.h"
+
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+
+/******************************************************************************/
+
+amqp::internal::reader::
+ToStringReader::ToStringReader (std::string type_)
+    : WellKnownReader (std::move (type_))
+{ }
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+ToStringReader::render (pn_data_t * data_) const {
+    proton::is_described (data_);
+    proton::auto_enter ae (data_);
+    proton::is_symbol (data_);
+    pn_data_next (data_);
+
+    return proton::get_string (data_);
+}
+
+/******************************************************************************/
+
+std::any
+amqp::internal::reader::
+ToStringReader::read (pn_data_t * data_) const {
+    proton::auto_next an (data_);
+
+    return std::any { render (data_) };
+}
+
+/******************************************************************************/
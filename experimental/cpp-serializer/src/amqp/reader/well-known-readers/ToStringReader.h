@@ -0,0 +1,28 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "WellKnownReader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Types the JVM serialises as nothing more than their string form,
+     * BigDecimal, Currency and X500Principal for example. That string
+     * is already the canonical rendering so it is what we hand back.
+     */
+    class ToStringReader : public WellKnownReader {
+        protected :
+            std::string render (pn_data_t *) const override;
+
+        public :
+            explicit ToStringReader (std::string);
+
+            std::any read (pn_data_t *) const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,162 @@
+#include "WellKnownReader.h"
+
+#include <map>
+
+#include "proton/proton_wrapper.h"
+
+#include "amqp/Budget.h"
+
+#include "BytesReader.h"
+#include "InstantReader.h"
+#include "ToStringReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::reader;
+
+    const std::map<
+            std::string,
+            uPtr<WellKnownReader>(*)()
+    > wellKnown = { // NOLINT
+        {
+            "java.time.Instant", []() -> uPtr<WellKnownReader> {
+                return std::make_unique<InstantReader>();
+            }
+        },
+        {
+            "java.math.BigDecimal", []() -> uPtr<WellKnownReader> {
+                return std::make_unique<ToStringReader> ("java.math.BigDecimal");
+            }
+        },
+        {
+            "java.util.Currency", []() -> uPtr<WellKnownReader> {
+                return std::make_unique<ToStringReader> ("java.util.Currency");
+            }
+        },
+        {
+            "javax.security.auth.x500.X500Principal", []() -> uPtr<WellKnownReader> {
+                return std::make_unique<ToStringReader> (
+                        "javax.security.auth.x500.X500Principal");
+            }
+        },
+        {
+            "java.security.PublicKey", []() -> uPtr<WellKnownReader> {
+                return std::make_unique<BytesReader> (
+                        "java.security.PublicKey", false);
+            }
+        },
+        {
+            "net.corda.core.utilities.OpaqueBytes", []() -> uPtr<WellKnownReader> {
+                return std::make_unique<BytesReader> (
+                        "net.corda.core.utilities.OpaqueBytes", true);
+            }
+        },
+        {
+            "net.corda.core.crypto.SecureHash$SHA256", []() -> uPtr<WellKnownReader> {
+                return std::make_unique<SHA256Reader>();
+            }
+        }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * Static methods
+ *
+ ******************************************************************************/
+
+uPtr<amqp::internal::reader::WellKnownReader>
+amqp::internal::reader::
+WellKnownReader::make (const std::string & type_) {
+    auto it = wellKnown.find (type_);
+
+    return (it == wellKnown.end()) ? nullptr : it->second();
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+WellKnownReader::isWellKnown (const std::string & type_) {
+    return wellKnown.find (type_) != wellKnown.end();
+}
+
+/******************************************************************************
+ *
+ * WellKnownReader
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+WellKnownReader::m_name { // NOLINT
+    "Well Known Reader"
+};
+
+/******************************************************************************/
+
+amqp::internal::reader::
+WellKnownReader::WellKnownReader (std::string type_)
+    : m_type (std::move (type_))
+{ }
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+WellKnownReader::readString (pn_data_t * data_) const {
+    Budget::node();
+
+    proton::auto_next an (data_);
+
+    auto rtn = render (data_);
+    Budget::bytes (rtn.size());
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+WellKnownReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType &) const
+{
+    return std::make_unique<TypedPair<std::string>> (
+            name_,
+            readString (data_));
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+WellKnownReader::dump (
+    pn_data_t * data_,
+    const SchemaType &) const
+{
+    return std::make_unique<TypedSingle<std::string>> (readString (data_));
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+WellKnownReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+WellKnownReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
@@ -0,0 +1,73 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "Reader.h"
+
+#include <any>
+#include <string>
+
+/******************************************************************************/
+
+struct pn_data_t;
+
+/******************************************************************************
+ *
+ * class WellKnownReader
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Types the JVM writes with a custom serialiser, Instant, BigDecimal,
+     * PublicKey, SecureHash and friends, show up in almost every Corda
+     * blob. Rather than treating them as generic composites, or not
+     * being able to read them at all where they're written as a described
+     * string or binary, we recognise them by name and read them straight
+     * into a native form with a canonical rendering.
+     */
+    class WellKnownReader : public Reader {
+        private :
+            static const std::string m_name;
+
+            const std::string m_type;
+
+        protected :
+            /**
+             * Render the value at the current position in [data_] without
+             * moving past it
+             */
+            virtual std::string render (pn_data_t *) const = 0;
+
+        public :
+            /**
+             * @return a reader for [type_] or nullptr if it isn't one we know
+             */
+            static uPtr<WellKnownReader> make (const std::string & type_);
+
+            static bool isWellKnown (const std::string & type_);
+
+            explicit WellKnownReader (std::string);
+            ~WellKnownReader() override = default;
+
+            std::any read (pn_data_t *) const override = 0;
+
+            std::string readString (pn_data_t *) const override;
+
+            uPtr<amqp::reader::IValue> dump(
+                const std::string &,
+                pn_data_t *,
+                const SchemaType &) const override;
+
+            uPtr<amqp::reader::IValue> dump(
+                pn_data_t *,
+                const SchemaType &) const override;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,31 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    class TypeNotation;
+
+    /**
+     * Finding the individual types a schema describes, for factories that
+     * only build readers for the types they need
+     */
+    class TypeLookup {
+        public :
+            virtual ~TypeLookup() = default;
+
+            /**
+             * The type called, or with the descriptor, given if the schema
+             * describes it, otherwise null. Lives as long as the schema.
+             */
+            virtual const TypeNotation * findType (const std::string &) const = 0;
+            virtual const TypeNotation * findDescriptor (const std::string &) const = 0;
+    };
+
+}
+
+/******************************************************************************/
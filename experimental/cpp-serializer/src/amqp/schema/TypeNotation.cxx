@@ -0,0 +1,90 @@
+#include "TypeNotation.h"
+
+#include <iostream>
+#include <type_traits>
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::schema;
+
+    /**
+     * Both sides of the comparison are concrete types so we can go
+     * straight to the right overload of dependsOnRHS rather than bouncing
+     * through [AMQPTypeNotation] and then switching on the restricted
+     * type of the left hand side.
+     *
+     * Semantics match [OrderedTypeNotation::dependsOn], i.e. we are asking
+     * the right hand side whether it depends on, or is depended upon by,
+     * the left.
+     */
+    struct DependsOn {
+        template<class LHS, class RHS>
+        int operator() (const LHS & lhs_, const RHS & rhs_) const {
+            if constexpr (std::is_same_v<RHS, Composite>) {
+                return rhs_.dependsOnRHS (lhs_);
+            } else {
+                return static_cast<const Restricted &>(rhs_).dependsOnRHS (lhs_);
+            }
+        }
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    std::ostream &
+    operator << (std::ostream & stream_, const TypeNotation & type_) {
+        type_.visit ([& stream_](const auto & t) {
+            if constexpr (std::is_same_v<std::decay_t<decltype (t)>, Composite>) {
+                stream_ << t;
+            } else {
+                stream_ << static_cast<const Restricted &>(t);
+            }
+        });
+
+        return stream_;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::TypeNotation
+ *
+ ******************************************************************************/
+
+const amqp::internal::schema::AMQPTypeNotation &
+amqp::internal::schema::
+TypeNotation::notation() const {
+    return visit ([](const auto & t) -> const AMQPTypeNotation & { return t; });
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+TypeNotation::name() const {
+    return notation().name();
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+TypeNotation::descriptor() const {
+    return notation().descriptor();
+}
+
+/******************************************************************************/
+
+int
+amqp::internal::schema::
+TypeNotation::dependsOn (const TypeNotation & rhs_) const {
+    return std::visit (DependsOn(), m_type, rhs_.m_type);
+}
+
+/******************************************************************************/
@@ -0,0 +1,75 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <iosfwd>
+#include <variant>
+
+#include "types.h"
+
+#include "amqp/AMQPDescribed.h"
+#include "amqp/schema/described-types/Composite.h"
+#include "amqp/schema/restricted-types/Map.h"
+#include "amqp/schema/restricted-types/List.h"
+#include "amqp/schema/restricted-types/Enum.h"
+#include "amqp/schema/restricted-types/Array.h"
+
+/******************************************************************************
+ *
+ * class amqp::internal::schema::TypeNotation
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * A Corda AMQP schema can only ever describe a closed set of types,
+     * composites and the four flavours of restricted type. Rather than
+     * holding those behind a pointer to [AMQPTypeNotation] and recovering
+     * the concrete type with a dynamic_cast every time we need it we
+     * hold them by value in a variant and let std::visit do the dispatch.
+     */
+    class TypeNotation : public AMQPDescribed {
+        public :
+            using Variant = std::variant<Composite, List, Map, Array, Enum>;
+
+            friend std::ostream & operator << (std::ostream &, const TypeNotation &);
+
+        private :
+            Variant m_type;
+
+        public :
+            template<
+                class T,
+                typename = std::enable_if_t<
+                    !std::is_same_v<std::decay_t<T>, TypeNotation>>>
+            explicit TypeNotation (T && type_)
+                : m_type (std::forward<T> (type_))
+            { }
+
+            TypeNotation (TypeNotation &&) = default;
+            TypeNotation (const TypeNotation &) = delete;
+
+            ~TypeNotation() override = default;
+
+            const AMQPTypeNotation & notation() const;
+
+            const std::string & name() const;
+            const std::string & descriptor() const;
+
+            int dependsOn (const TypeNotation &) const;
+
+            template<class T>
+            const T & get() const {
+                return std::get<T> (m_type);
+            }
+
+            template<class Visitor>
+            decltype(auto) visit (Visitor && visitor_) const {
+                return std::visit (std::forward<Visitor> (visitor_), m_type);
+            }
+    };
+
+}
+
+/******************************************************************************/
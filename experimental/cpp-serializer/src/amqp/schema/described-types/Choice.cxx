@@ -14,8 +14,9 @@ operator << (std::ostream & os_, const amqp::internal::schema::Choice & choice_)
 /******************************************************************************/
 
 amqp::internal::schema::
-Choice::Choice (std::string choice_)
+Choice::Choice (std::string choice_, std::string value_)
      : m_choice (std::move (choice_))
+     , m_value (std::move (value_))
 {
 
 }
@@ -29,3 +30,14 @@ Choice::choice() const {
 }
 
 /******************************************************************************/
+
+/**
+ * For an enum constant this is its ordinal
+ */
+const std::string &
+amqp::internal::schema::
+Choice::value() const {
+    return m_value;
+}
+
+/******************************************************************************/
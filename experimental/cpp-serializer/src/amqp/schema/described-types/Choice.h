@@ -14,13 +14,15 @@ namespace amqp::internal::schema {
 
         private :
             std::string m_choice;
+            std::string m_value;
 
         public :
             Choice() = delete;
 
-            explicit Choice (std::string);
+            explicit Choice (std::string, std::string = "");
 
             const std::string & choice() const;
+            const std::string & value() const;
 
     };
 
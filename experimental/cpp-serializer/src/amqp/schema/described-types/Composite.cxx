@@ -59,6 +59,22 @@ Composite::fields() const {
 
 /******************************************************************************/
 
+const std::string &
+amqp::internal::schema::
+Composite::label() const {
+    return m_label;
+}
+
+/******************************************************************************/
+
+const std::list<std::string> &
+amqp::internal::schema::
+Composite::provides() const {
+    return m_provides;
+}
+
+/******************************************************************************/
+
 amqp::internal::schema::AMQPTypeNotation::Type
 amqp::internal::schema::
 Composite::type() const {
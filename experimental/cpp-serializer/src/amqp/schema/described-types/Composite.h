@@ -69,6 +69,8 @@ namespace amqp::internal::schema {
                 std::vector<std::unique_ptr<Field>> fields_);
 
             const std::vector<std::unique_ptr<Field>> & fields() const;
+            const std::string & label() const;
+            const std::list<std::string> & provides() const;
 
             Type type() const override;
 
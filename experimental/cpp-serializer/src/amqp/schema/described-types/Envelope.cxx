@@ -14,7 +14,12 @@ operator << (
         std::ostream & stream_,
         const amqp::internal::schema::Envelope & e_
 ) {
-    stream_ << *(e_.m_schema);
+    if (auto schema = dynamic_cast<const Schema *> (e_.m_schema.get())) {
+        stream_ << *schema;
+    } else {
+        stream_ << "indexed schema" << std::endl;
+    }
+
     return stream_;
 }
 
@@ -28,10 +33,12 @@ operator << (
 
 amqp::internal::schema::
 Envelope::Envelope (
-    uPtr<Schema> & schema_,
-    std::string descriptor_
+    uPtr<ISchemaType> & schema_,
+    std::string descriptor_,
+    uPtr<Transforms> transforms_
 ) : m_schema (std::move (schema_))
   , m_descriptor (std::move (descriptor_))
+  , m_transforms (transforms_ ? std::move (transforms_) : std::make_unique<Transforms>())
 { }
 
 /******************************************************************************/
@@ -51,3 +58,11 @@ Envelope::descriptor() const {
 }
 
 /******************************************************************************/
+
+const amqp::internal::schema::Transforms &
+amqp::internal::schema::
+Envelope::transforms() const {
+    return *m_transforms;
+}
+
+/******************************************************************************/
@@ -5,6 +5,7 @@
 #include "amqp/AMQPDescribed.h"
 
 #include "amqp/schema/described-types/Schema.h"
+#include "amqp/schema/described-types/Transforms.h"
 
 #include <iosfwd>
 
@@ -17,19 +18,30 @@ namespace amqp::internal::schema {
             friend std::ostream & operator << (std::ostream &, const Envelope &);
 
         private :
-            std::unique_ptr<Schema> m_schema;
+            /**
+             * Either a [Schema] or an [IndexedSchema]
+             */
+            std::unique_ptr<ISchemaType> m_schema;
             std::string m_descriptor;
 
+            /**
+             * Empty for blobs written before Corda had transforms
+             */
+            std::unique_ptr<Transforms> m_transforms;
+
         public :
             Envelope() = delete;
 
             Envelope (
-                std::unique_ptr<Schema> & schema_,
-                std::string descriptor_);
+                std::unique_ptr<ISchemaType> & schema_,
+                std::string descriptor_,
+                std::unique_ptr<Transforms> transforms_ = nullptr);
 
             const ISchemaType & schema() const;
 
             const std::string & descriptor() const;
+
+            const Transforms & transforms() const;
     };
 
 }
@@ -0,0 +1,412 @@
+#include "FlatSchema.h"
+
+#include <list>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "debug.h"
+
+#include "Choice.h"
+#include "Composite.h"
+#include "Descriptor.h"
+
+#include "field-types/Field.h"
+#include "restricted-types/Restricted.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::schema;
+
+    /**
+     * Writes each distinct string into the arena once, type names turn up
+     * again as field types and in requires so most of them are repeats
+     */
+    class Packer {
+        private :
+            std::string & m_arena;
+            std::vector<FlatSchema::Text> & m_texts;
+
+            std::unordered_map<std::string, FlatSchema::Text> m_seen;
+
+        public :
+            Packer (std::string & arena_, std::vector<FlatSchema::Text> & texts_)
+                : m_arena (arena_)
+                , m_texts (texts_)
+            { }
+
+            FlatSchema::Text
+            text (const std::string & string_) {
+                auto it = m_seen.find (string_);
+
+                if (it != m_seen.end()) {
+                    return it->second;
+                }
+
+                if (m_arena.size() + string_.size() > std::numeric_limits<uint32_t>::max()) {
+                    throw std::runtime_error ("Schema too large to flatten");
+                }
+
+                FlatSchema::Text rtn {
+                    static_cast<uint32_t>(m_arena.size()),
+                    static_cast<uint32_t>(string_.size())
+                };
+
+                m_arena += string_;
+                m_seen.emplace (string_, rtn);
+
+                return rtn;
+            }
+
+            template<class C>
+            FlatSchema::Range
+            texts (const C & strings_) {
+                FlatSchema::Range rtn {
+                    static_cast<uint32_t>(m_texts.size()),
+                    static_cast<uint32_t>(strings_.size())
+                };
+
+                for (const auto & string : strings_) {
+                    m_texts.push_back (text (string));
+                }
+
+                return rtn;
+            }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::FlatSchema
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::
+FlatSchema::FlatSchema (const Schema & schema_) {
+    Packer packer (m_arena, m_texts);
+
+    m_types.reserve (schema_.types().size());
+
+    for (const auto & type : schema_) {
+        Type flat { };
+
+        flat.name = packer.text (type.name());
+        flat.descriptor = packer.text (type.descriptor());
+
+        type.visit (overloaded {
+            [&](const Composite & composite_) {
+                flat.kind = Kind::Composite;
+                flat.label = packer.text (composite_.label());
+                flat.provides = packer.texts (composite_.provides());
+                flat.fields = Range {
+                    static_cast<uint32_t>(m_fields.size()),
+                    static_cast<uint32_t>(composite_.fields().size())
+                };
+
+                for (const auto & field : composite_.fields()) {
+                    m_fields.push_back (Field {
+                        packer.text (field->name()),
+                        packer.text (field->type()),
+                        packer.text (field->defaultValue()),
+                        packer.text (field->label()),
+                        packer.texts (field->requires()),
+                        field->mandatory(),
+                        field->multiple()
+                    });
+                }
+            },
+            [&](const Restricted & restricted_) {
+                switch (restricted_.source()) {
+                    case Restricted::list_t  : flat.kind = Kind::List; break;
+                    case Restricted::map_t   : flat.kind = Kind::Map; break;
+                    case Restricted::array_t : flat.kind = Kind::Array; break;
+                    case Restricted::enum_t  : flat.kind = Kind::Enum; break;
+                }
+
+                flat.label = packer.text (restricted_.label());
+                flat.provides = packer.texts (restricted_.provides());
+            }
+        });
+
+        if (flat.kind == Kind::Enum) {
+            const auto & choices = type.get<Enum>().choices();
+
+            flat.choices = Range {
+                static_cast<uint32_t>(m_texts.size()),
+                static_cast<uint32_t>(choices.size())
+            };
+
+            for (const auto & choice : choices) {
+                m_texts.push_back (packer.text (choice->choice()));
+                m_texts.push_back (packer.text (choice->value()));
+            }
+        }
+
+        m_types.push_back (flat);
+    }
+
+    m_arena.shrink_to_fit();
+    m_texts.shrink_to_fit();
+    m_fields.shrink_to_fit();
+
+    m_byName.resize (m_types.size());
+    for (uint32_t i { 0 } ; i < m_byName.size() ; ++i) {
+        m_byName[i] = i;
+    }
+    m_byDescriptor = m_byName;
+
+    std::sort (m_byName.begin(), m_byName.end(), [this](auto lhs_, auto rhs_) {
+        return text (m_types[lhs_].name) < text (m_types[rhs_].name);
+    });
+
+    std::sort (m_byDescriptor.begin(), m_byDescriptor.end(), [this](auto lhs_, auto rhs_) {
+        return text (m_types[lhs_].descriptor) < text (m_types[rhs_].descriptor);
+    });
+
+    m_built.resize (m_types.size());
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::schema::
+FlatSchema::text (Text text_) const {
+    return std::string_view (m_arena).substr (text_.offset, text_.length);
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::schema::
+FlatSchema::text (Range range_, std::size_t i_) const {
+    return text (m_texts[range_.first + i_]);
+}
+
+/******************************************************************************/
+
+std::optional<std::size_t>
+amqp::internal::schema::
+FlatSchema::find (
+    const std::vector<uint32_t> & index_,
+    Text Type::* key_,
+    std::string_view value_
+) const {
+    auto it = std::lower_bound (
+        index_.begin(),
+        index_.end(),
+        value_,
+        [this, key_](uint32_t lhs_, std::string_view rhs_) {
+            return text (m_types[lhs_].*key_) < rhs_;
+        });
+
+    if (it == index_.end() || text (m_types[*it].*key_) != value_) {
+        return std::nullopt;
+    }
+
+    return *it;
+}
+
+/******************************************************************************/
+
+std::optional<std::size_t>
+amqp::internal::schema::
+FlatSchema::indexOfType (std::string_view name_) const {
+    return find (m_byName, &Type::name, name_);
+}
+
+/******************************************************************************/
+
+std::optional<std::size_t>
+amqp::internal::schema::
+FlatSchema::indexOfDescriptor (std::string_view descriptor_) const {
+    return find (m_byDescriptor, &Type::descriptor, descriptor_);
+}
+
+/******************************************************************************/
+
+std::size_t
+amqp::internal::schema::
+FlatSchema::bytes() const {
+    return m_arena.capacity()
+        + m_texts.capacity() * sizeof (Text)
+        + m_fields.capacity() * sizeof (Field)
+        + m_types.capacity() * sizeof (Type)
+        + (m_byName.capacity() + m_byDescriptor.capacity()) * sizeof (uint32_t)
+        + m_built.capacity() * sizeof (uPtr<TypeNotation>);
+}
+
+/******************************************************************************/
+
+/**
+ * The type as it was before we flattened it
+ */
+amqp::internal::schema::TypeNotation
+amqp::internal::schema::
+FlatSchema::notation (std::size_t i_) const {
+    const auto & type = m_types[i_];
+
+    auto name = std::string (text (type.name));
+    auto label = std::string (text (type.label));
+    auto descriptor = std::make_unique<Descriptor> (std::string (text (type.descriptor)));
+
+    if (type.kind == Kind::Composite) {
+        std::list<std::string> provides;
+        for (std::size_t i { 0 } ; i < type.provides.count ; ++i) {
+            provides.emplace_back (text (type.provides, i));
+        }
+
+        std::vector<uPtr<schema::Field>> fields;
+        fields.reserve (type.fields.count);
+
+        for (auto i = type.fields.first ; i < type.fields.first + type.fields.count ; ++i) {
+            const auto & field = m_fields[i];
+
+            std::list<std::string> requires;
+            for (std::size_t j { 0 } ; j < field.requires.count ; ++j) {
+                requires.emplace_back (text (field.requires, j));
+            }
+
+            fields.emplace_back (schema::Field::make (
+                std::string (text (field.name)),
+                std::string (text (field.type)),
+                std::move (requires),
+                std::string (text (field.defaultValue)),
+                std::string (text (field.label)),
+                field.mandatory,
+                field.multiple));
+        }
+
+        return TypeNotation (Composite (
+            std::move (name),
+            std::move (label),
+            std::move (provides),
+            std::move (descriptor),
+            std::move (fields)));
+    }
+
+    std::vector<std::string> provides;
+    provides.reserve (type.provides.count);
+    for (std::size_t i { 0 } ; i < type.provides.count ; ++i) {
+        provides.emplace_back (text (type.provides, i));
+    }
+
+    std::vector<uPtr<Choice>> choices;
+    for (std::size_t i { 0 } ; i < type.choices.count ; ++i) {
+        choices.emplace_back (std::make_unique<Choice> (
+            std::string (text (type.choices, 2 * i)),
+            std::string (text (type.choices, 2 * i + 1))));
+    }
+
+    // enums and arrays are both lists on the wire, it's the choices and
+    // the name that tell them apart
+    auto rtn = Restricted::make (
+        std::move (descriptor),
+        std::move (name),
+        std::move (label),
+        std::move (provides),
+        type.kind == Kind::Map ? "map" : "list",
+        std::move (choices));
+
+    return std::move (*rtn);
+}
+
+/******************************************************************************/
+
+/**
+ * Must be called with [m_mutex] held
+ */
+const amqp::internal::schema::TypeNotation *
+amqp::internal::schema::
+FlatSchema::build (std::size_t i_) const {
+    if (m_built[i_]) {
+        return m_built[i_].get();
+    }
+
+    DBG ("FlatSchema::build - " << text (m_types[i_].name) << std::endl); // NOLINT
+
+    m_built[i_] = std::make_unique<TypeNotation> (notation (i_));
+
+    const auto & type = *m_built[i_];
+
+    m_descriptorToType.emplace (type.descriptor(), std::cref (type));
+    m_typeToDescriptor.emplace (type.name(), std::cref (type));
+
+    return &type;
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::TypeNotation *
+amqp::internal::schema::
+FlatSchema::findType (const std::string & type_) const {
+    auto i = indexOfType (type_);
+
+    if (!i) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return build (*i);
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::TypeNotation *
+amqp::internal::schema::
+FlatSchema::findDescriptor (const std::string & descriptor_) const {
+    auto i = indexOfDescriptor (descriptor_);
+
+    if (!i) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return build (*i);
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::SchemaMap::const_iterator
+amqp::internal::schema::
+FlatSchema::fromType (const std::string & type_) const {
+    findType (type_);
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_typeToDescriptor.find (type_);
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::SchemaMap::const_iterator
+amqp::internal::schema::
+FlatSchema::fromDescriptor (const std::string & descriptor_) const {
+    findDescriptor (descriptor_);
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_descriptorToType.find (descriptor_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::internal::schema::Schema>
+amqp::internal::schema::
+FlatSchema::materialise() const {
+    std::vector<TypeNotation> types;
+    types.reserve (m_types.size());
+
+    for (std::size_t i { 0 } ; i < m_types.size() ; ++i) {
+        types.emplace_back (notation (i));
+    }
+
+    return std::make_unique<Schema> (std::move (types));
+}
+
+/******************************************************************************/
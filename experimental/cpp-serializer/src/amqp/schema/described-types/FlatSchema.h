@@ -0,0 +1,174 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "types.h"
+#include "Schema.h"
+
+#include "schema/TypeLookup.h"
+#include "schema/TypeNotation.h"
+
+#include "amqp/AMQPDescribed.h"
+#include "amqp/schema/ISchema.h"
+
+/******************************************************************************
+ *
+ * class FlatSchema
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * A [Schema] packed down for keeping.
+     *
+     * A built schema is a forest of small heap objects, every type, field,
+     * name and list of provides its own allocation, which is the right
+     * shape for building readers from but costs many times the size of
+     * what it describes once those readers are built and it's just being
+     * held on to. Here every string lives in a single arena, each distinct
+     * one once, every field of every type in one contiguous array and every
+     * type is addressed by its index, so a schema is a handful of
+     * allocations however many types it has.
+     *
+     * Types are rebuilt as [TypeNotation]s only if someone asks for them
+     * through [ISchema] or [TypeLookup], and are kept from then on. That's
+     * serialised so, like [Schema], we're safe to share between threads.
+     */
+    class FlatSchema
+            : public amqp::schema::ISchema<SchemaMap::const_iterator>
+            , public TypeLookup
+            , public amqp::AMQPDescribed
+    {
+        public :
+            enum class Kind : uint8_t { Composite, List, Map, Array, Enum };
+
+            /**
+             * A run of the arena
+             */
+            struct Text {
+                uint32_t offset;
+                uint32_t length;
+            };
+
+            /**
+             * A run of [m_texts] or [m_fields]
+             */
+            struct Range {
+                uint32_t first;
+                uint32_t count;
+            };
+
+            struct Field {
+                Text  name;
+                Text  type;
+                Text  defaultValue;
+                Text  label;
+                Range requires;
+                bool  mandatory;
+                bool  multiple;
+            };
+
+            /**
+             * [choices] are pairs of texts, each choice followed by its
+             * value, and only an enum has any
+             */
+            struct Type {
+                Text  name;
+                Text  label;
+                Text  descriptor;
+                Range provides;
+                Range fields;
+                Range choices;
+                Kind  kind;
+            };
+
+        private :
+            std::string        m_arena;
+            std::vector<Text>  m_texts;
+            std::vector<Field> m_fields;
+
+            /**
+             * In the dependency order of the schema we were built from
+             */
+            std::vector<Type> m_types;
+
+            /**
+             * Indices into [m_types] sorted by name and by descriptor
+             */
+            std::vector<uint32_t> m_byName;
+            std::vector<uint32_t> m_byDescriptor;
+
+            /**
+             * Everything below is only touched with this held
+             */
+            mutable std::mutex m_mutex;
+
+            mutable std::vector<uPtr<TypeNotation>> m_built;
+
+            /**
+             * The types rebuilt so far, for [fromType] and [fromDescriptor]
+             */
+            mutable SchemaMap m_descriptorToType;
+            mutable SchemaMap m_typeToDescriptor;
+
+            std::optional<std::size_t> find (
+                const std::vector<uint32_t> &,
+                Text Type::*,
+                std::string_view) const;
+
+            TypeNotation notation (std::size_t) const;
+
+            const TypeNotation * build (std::size_t) const;
+
+        public :
+            explicit FlatSchema (const Schema &);
+
+            FlatSchema (const FlatSchema &) = delete;
+
+            std::size_t size() const { return m_types.size(); }
+
+            const Type & type (std::size_t i_) const { return m_types[i_]; }
+            const Field & field (std::size_t i_) const { return m_fields[i_]; }
+
+            std::string_view text (Text) const;
+
+            /**
+             * The [i_]th of the texts in [range_]
+             */
+            std::string_view text (Range range_, std::size_t i_) const;
+
+            std::optional<std::size_t> indexOfType (std::string_view) const;
+            std::optional<std::size_t> indexOfDescriptor (std::string_view) const;
+
+            /**
+             * What we hold on the heap, not counting any types rebuilt
+             */
+            std::size_t bytes() const;
+
+            const TypeNotation * findType (const std::string &) const override;
+            const TypeNotation * findDescriptor (const std::string &) const override;
+
+            /**
+             * Rebuilds the type if need be, a type we don't describe gives
+             * the end of the types rebuilt so far
+             */
+            SchemaMap::const_iterator fromType (const std::string &) const override;
+            SchemaMap::const_iterator fromDescriptor (const std::string &) const override;
+
+            /**
+             * Rebuild the whole of the schema, as it was before we packed it
+             */
+            uPtr<Schema> materialise() const;
+    };
+
+}
+
+/******************************************************************************/
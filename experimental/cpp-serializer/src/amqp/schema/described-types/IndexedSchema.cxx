@@ -0,0 +1,185 @@
+#include "IndexedSchema.h"
+
+#include <stdexcept>
+
+#include "debug.h"
+
+#include "amqp/schema/descriptors/AMQPDescriptors.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::IndexedSchema
+ *
+ ******************************************************************************/
+
+namespace {
+
+    /**
+     * Whatever the cursor was doing before, it's doing again once we're done
+     */
+    class auto_point {
+        private :
+            pn_data_t * m_data;
+            pn_handle_t m_point;
+
+        public :
+            auto_point (pn_data_t * data_, pn_handle_t point_)
+                : m_data (data_)
+                , m_point (pn_data_point (data_))
+            {
+                pn_data_restore (m_data, point_);
+            }
+
+            ~auto_point() {
+                pn_data_restore (m_data, m_point);
+            }
+    };
+
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::
+IndexedSchema::IndexedSchema (
+    pn_data_t * data_,
+    pn_handle_t point_,
+    std::vector<Entry> entries_
+) : m_data (data_)
+  , m_point (point_)
+  , m_entries (std::move (entries_))
+  , m_built (m_entries.size(), nullptr)
+{
+    for (std::size_t i { 0 } ; i < m_entries.size() ; ++i) {
+        m_byDescriptor.emplace (m_entries[i].descriptor, i);
+        m_byName.emplace (m_entries[i].name, i);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Must be called with [m_mutex] held
+ */
+const amqp::internal::schema::TypeNotation *
+amqp::internal::schema::
+IndexedSchema::build (std::size_t i_) const {
+    if (m_built[i_]) {
+        return m_built[i_];
+    }
+
+    DBG ("IndexedSchema::build - " << m_entries[i_].name << std::endl); // NOLINT
+
+    uPtr<TypeNotation> type;
+    {
+        auto_point p (m_data, m_entries[i_].point);
+        type = descriptors::dispatchDescribed<TypeNotation> (m_data);
+    }
+
+    if (!type || type->descriptor() != m_entries[i_].descriptor) {
+        throw std::runtime_error (
+            "Indexed type " + m_entries[i_].name + " didn't build as indexed");
+    }
+
+    m_types.emplace_back (std::move (type));
+    m_built[i_] = m_types.back().get();
+
+    m_descriptorToType.emplace (m_built[i_]->descriptor(), std::cref (*m_built[i_]));
+    m_typeToDescriptor.emplace (m_built[i_]->name(), std::cref (*m_built[i_]));
+
+    return m_built[i_];
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::TypeNotation *
+amqp::internal::schema::
+IndexedSchema::findType (const std::string & type_) const {
+    auto it = m_byName.find (type_);
+
+    if (it == m_byName.end()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return build (it->second);
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::TypeNotation *
+amqp::internal::schema::
+IndexedSchema::findDescriptor (const std::string & descriptor_) const {
+    auto it = m_byDescriptor.find (descriptor_);
+
+    if (it == m_byDescriptor.end()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return build (it->second);
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::SchemaMap::const_iterator
+amqp::internal::schema::
+IndexedSchema::fromType (const std::string & type_) const {
+    findType (type_);
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_typeToDescriptor.find (type_);
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::SchemaMap::const_iterator
+amqp::internal::schema::
+IndexedSchema::fromDescriptor (const std::string & descriptor_) const {
+    findDescriptor (descriptor_);
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_descriptorToType.find (descriptor_);
+}
+
+/******************************************************************************/
+
+std::vector<std::string_view>
+amqp::internal::schema::
+IndexedSchema::descriptors() const {
+    std::vector<std::string_view> rtn;
+    rtn.reserve (m_entries.size());
+
+    for (const auto & entry : m_entries) {
+        rtn.emplace_back (entry.descriptor);
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::size_t
+amqp::internal::schema::
+IndexedSchema::built() const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_types.size();
+}
+
+/******************************************************************************/
+
+uPtr<amqp::internal::schema::Schema>
+amqp::internal::schema::
+IndexedSchema::materialise() const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    auto_point p (m_data, m_point);
+
+    return descriptors::dispatchDescribed<Schema> (m_data);
+}
+
+/******************************************************************************/
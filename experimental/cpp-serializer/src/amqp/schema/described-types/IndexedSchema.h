@@ -0,0 +1,127 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <mutex>
+#include <deque>
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include <proton/codec.h>
+
+#include "types.h"
+#include "Schema.h"
+
+#include "schema/TypeLookup.h"
+#include "schema/TypeNotation.h"
+
+#include "amqp/AMQPDescribed.h"
+#include "amqp/schema/ISchema.h"
+
+/******************************************************************************
+ *
+ * class IndexedSchema
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * A schema section we've only indexed rather than built.
+     *
+     * Building a [Schema] means building every type it describes, fields,
+     * provides, label and all, then sorting them by dependency. Indexing
+     * just notes where in the decoded blob each type's definition is,
+     * along with its name and descriptor, so a type is only built if a
+     * reader actually needs it, and a schema whose readers are already
+     * cached need never be built at all.
+     *
+     * Types are built from the blob's pn_data_t, which must outlive us.
+     * Building moves that pn_data_t's cursor, we put it back afterwards,
+     * so it's safe to do part way through a decode of the same data but
+     * not from another thread whilst one is going on. Otherwise we're safe
+     * to share, building is serialised and a type, once built, never
+     * changes or moves.
+     */
+    class IndexedSchema
+            : public amqp::schema::ISchema<SchemaMap::const_iterator>
+            , public TypeLookup
+            , public amqp::AMQPDescribed
+    {
+        public :
+            /**
+             * Where in the blob a type's definition is
+             */
+            struct Entry {
+                std::string descriptor;
+                std::string name;
+                pn_handle_t point;
+            };
+
+        private :
+            pn_data_t *        m_data;
+            const pn_handle_t  m_point;
+            std::vector<Entry> m_entries;
+
+            std::map<std::string, std::size_t, std::less<>> m_byDescriptor;
+            std::map<std::string, std::size_t, std::less<>> m_byName;
+
+            /**
+             * Everything below is only touched with this held
+             */
+            mutable std::mutex m_mutex;
+
+            mutable std::vector<const TypeNotation *> m_built;
+            mutable std::deque<uPtr<TypeNotation>> m_types;
+
+            /**
+             * The types built so far, for [fromType] and [fromDescriptor]
+             */
+            mutable SchemaMap m_descriptorToType;
+            mutable SchemaMap m_typeToDescriptor;
+
+            const TypeNotation * build (std::size_t) const;
+
+        public :
+            /**
+             * @param point_ the schema section's described node in [data_]
+             */
+            IndexedSchema (
+                pn_data_t * data_,
+                pn_handle_t point_,
+                std::vector<Entry> entries_);
+
+            IndexedSchema (const IndexedSchema &) = delete;
+
+            const TypeNotation * findType (const std::string &) const override;
+            const TypeNotation * findDescriptor (const std::string &) const override;
+
+            /**
+             * Builds the type if need be, a type we don't describe gives
+             * the end of the types built so far
+             */
+            SchemaMap::const_iterator fromType (const std::string &) const override;
+            SchemaMap::const_iterator fromDescriptor (const std::string &) const override;
+
+            /**
+             * The descriptor of every type we describe, in the order the
+             * schema lists them
+             */
+            std::vector<std::string_view> descriptors() const;
+
+            /**
+             * How many of our types have been built
+             */
+            std::size_t built() const;
+
+            /**
+             * Build the whole of the schema, as if we'd never indexed it
+             */
+            uPtr<Schema> materialise() const;
+    };
+
+}
+
+/******************************************************************************/
@@ -1,7 +1,7 @@
 
 #include "amqp/AMQPDescribed.h"
 #include "amqp/schema/ISchema.h"
-#include "amqp/schema/AMQPTypeNotation.h"
+#include "amqp/schema/TypeNotation.h"
 #include "Schema.h"
 #include "types.h"
 
@@ -21,10 +21,8 @@ namespace amqp::internal::schema {
 std::ostream &
 operator << (std::ostream & stream_, const Schema & schema_) {
 
-    for (auto i { schema_.m_types.begin() } ; i != schema_.m_types.end() ; ++i) {
-        for (auto & j : *i) {
-            stream_ << j->name() << " " << j->type() << std::endl;
-        }
+    for (const auto & type : schema_.m_types) {
+        stream_ << type.name() << " " << type.notation().type() << std::endl;
     }
 
     return stream_;
@@ -32,6 +30,37 @@ operator << (std::ostream & stream_, const Schema & schema_) {
 
 }
 
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::schema;
+
+    /**
+     * The levels are already in dependency order, as is everything within
+     * them, so concatenating them keeps it
+     */
+    std::vector<TypeNotation>
+    flatten (OrderedTypeNotations<TypeNotation> types_) {
+        std::size_t count { 0 };
+        for (const auto & level : types_) {
+            count += level.size();
+        }
+
+        std::vector<TypeNotation> rtn;
+        rtn.reserve (count);
+
+        for (const auto & level : types_) {
+            for (const auto & type : level) {
+                rtn.emplace_back (std::move (*type));
+            }
+        }
+
+        return rtn;
+    }
+
+}
+
 /******************************************************************************
  *
  * amqp::internal::schema::Schema
@@ -40,20 +69,30 @@ operator << (std::ostream & stream_, const Schema & schema_) {
 
 amqp::internal::schema::
 Schema::Schema (
-    OrderedTypeNotations<AMQPTypeNotation> types_
+    OrderedTypeNotations<TypeNotation> types_
+) : Schema (flatten (std::move (types_))) {
+}
+
+/******************************************************************************/
+
+/**
+ * The maps hold references into [m_types] so it must never change once
+ * we start populating them
+ */
+amqp::internal::schema::
+Schema::Schema (
+    std::vector<TypeNotation> types_
 ) : m_types (std::move (types_)) {
-    for (auto i { m_types.begin() } ; i != m_types.end() ; ++i) {
-        for (auto & j : *i) {
-            DBG ("Schema: " << j->descriptor() << " " << j->name() << std::endl); // NOLINT
-            m_descriptorToType.emplace (j->descriptor(), std::ref (j));
-            m_typeToDescriptor.emplace (j->name(), std::ref (j));
-        }
+    for (const auto & type : m_types) {
+        DBG ("Schema: " << type.descriptor() << " " << type.name() << std::endl); // NOLINT
+        m_descriptorToType.emplace (type.descriptor(), std::cref (type));
+        m_typeToDescriptor.emplace (type.name(), std::cref (type));
     }
 }
 
 /******************************************************************************/
 
-const amqp::internal::schema::OrderedTypeNotations<amqp::internal::schema::AMQPTypeNotation> &
+const std::vector<amqp::internal::schema::TypeNotation> &
 amqp::internal::schema::
 Schema::types() const {
     return m_types;
@@ -77,3 +116,23 @@ Schema::fromDescriptor (const std::string & descriptor_) const {
 
 /******************************************************************************/
 
+const amqp::internal::schema::TypeNotation *
+amqp::internal::schema::
+Schema::findType (const std::string & type_) const {
+    auto it = m_typeToDescriptor.find (type_);
+
+    return it == m_typeToDescriptor.end() ? nullptr : &it->second.get();
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::TypeNotation *
+amqp::internal::schema::
+Schema::findDescriptor (const std::string & descriptor_) const {
+    auto it = m_descriptorToType.find (descriptor_);
+
+    return it == m_descriptorToType.end() ? nullptr : &it->second.get();
+}
+
+/******************************************************************************/
+
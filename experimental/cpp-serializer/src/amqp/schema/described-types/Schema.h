@@ -4,11 +4,14 @@
 
 #include <set>
 #include <map>
+#include <vector>
 #include <iosfwd>
 
 #include "types.h"
 #include "Composite.h"
 #include "Descriptor.h"
+#include "schema/TypeLookup.h"
+#include "schema/TypeNotation.h"
 #include "schema/OrderedTypeNotations.h"
 
 #include "amqp/AMQPDescribed.h"
@@ -20,7 +23,7 @@ namespace amqp::internal::schema {
 
     using SchemaMap = std::map<
             std::string,
-            const std::reference_wrapper<const uPtr <AMQPTypeNotation>>>;
+            const std::reference_wrapper<const TypeNotation>>;
 
     using ISchemaType = amqp::schema::ISchema<SchemaMap::const_iterator>;
 
@@ -30,29 +33,45 @@ namespace amqp::internal::schema {
 
 namespace amqp::internal::schema {
 
+    /**
+     * Immutable once constructed, so may be shared between threads
+     */
     class Schema
             : public amqp::schema::ISchema<SchemaMap::const_iterator>
+            , public TypeLookup
             , public amqp::AMQPDescribed
     {
         public :
             friend std::ostream & operator << (std::ostream &, const Schema &);
 
         private :
-            OrderedTypeNotations<AMQPTypeNotation> m_types;
+            /**
+             * The types flattened out of their dependency ordered levels
+             * into a single contiguous block, still in dependency order
+             */
+            std::vector<TypeNotation> m_types;
 
             SchemaMap m_descriptorToType;
             SchemaMap m_typeToDescriptor;
 
         public :
-            explicit Schema (OrderedTypeNotations<AMQPTypeNotation>);
+            explicit Schema (OrderedTypeNotations<TypeNotation>);
 
-            const OrderedTypeNotations<AMQPTypeNotation> & types() const;
+            /**
+             * [types_] must already be in dependency order
+             */
+            explicit Schema (std::vector<TypeNotation> types_);
+
+            const std::vector<TypeNotation> & types() const;
 
             SchemaMap::const_iterator fromType (const std::string &) const override;
             SchemaMap::const_iterator fromDescriptor (const std::string &) const override ;
 
-            decltype (m_types.begin()) begin() const { return m_types.begin(); }
-            decltype (m_types.end()) end() const { return m_types.end(); }
+            const TypeNotation * findType (const std::string &) const override;
+            const TypeNotation * findDescriptor (const std::string &) const override;
+
+            decltype (m_types.cbegin()) begin() const { return m_types.cbegin(); }
+            decltype (m_types.cend()) end() const { return m_types.cend(); }
     };
 
 }
@@ -0,0 +1,92 @@
+#include "Transforms.h"
+
+#include <iostream>
+#include <stdexcept>
+
+/******************************************************************************
+ *
+ * Non member related functions
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::schema {
+
+std::ostream &
+operator << (std::ostream & stream_, const Transforms & transforms_) {
+    for (const auto & [ type, transforms ] : transforms_.m_types) {
+        stream_ << type << " " << transforms.size() << " transforms" << std::endl;
+    }
+
+    return stream_;
+}
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::Transform
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::
+Transform::Transform (
+    const std::string & name_,
+    std::vector<std::string> arguments_
+) : m_kind (Unknown)
+  , m_arguments (std::move (arguments_))
+{
+    if (name_ == "EnumDefault") {
+        m_kind = EnumDefault;
+    } else if (name_ == "Rename") {
+        m_kind = Rename;
+    }
+
+    if (m_kind != Unknown && m_arguments.size() != 2) {
+        throw std::runtime_error (
+            name_ + " transform needs two arguments, not "
+                + std::to_string (m_arguments.size()));
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Corda writes an enum default as the constant to fall back to before
+ * the one added, the opposite way round to a rename
+ */
+const std::string &
+amqp::internal::schema::
+Transform::from() const {
+    return m_arguments.at (m_kind == EnumDefault ? 1 : 0);
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Transform::to() const {
+    return m_arguments.at (m_kind == EnumDefault ? 0 : 1);
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::Transforms
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::
+Transforms::Transforms (std::map<std::string, Type, std::less<>> types_)
+    : m_types (std::move (types_))
+{ }
+
+/******************************************************************************/
+
+const amqp::internal::schema::Transforms::Type *
+amqp::internal::schema::
+Transforms::find (const std::string & type_) const {
+    auto it = m_types.find (type_);
+
+    return (it == m_types.end()) ? nullptr : &it->second;
+}
+
+/******************************************************************************/
@@ -0,0 +1,97 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+#include "types.h"
+
+#include "amqp/AMQPDescribed.h"
+
+/******************************************************************************
+ *
+ * class Transform
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * One change made to a type, as the @CordaSerializationTransform
+     * annotations on its class record it. Written as the transform's name
+     * followed by its arguments:
+     *
+     *   EnumDefault, old, new - constant [new] was added, anyone who
+     *                           doesn't know it should read [old] instead
+     *   Rename, from, to      - constant [from] is now called [to]
+     *
+     * Any other kind is kept but means nothing to us.
+     */
+    class Transform : public AMQPDescribed {
+        public :
+            enum Kind { Unknown, EnumDefault, Rename };
+
+        private :
+            Kind                     m_kind;
+            std::vector<std::string> m_arguments;
+
+        public :
+            Transform (const std::string & name_, std::vector<std::string> arguments_);
+
+            Kind kind() const { return m_kind; }
+
+            /**
+             * For a rename the old name, for an enum default the added
+             * constant
+             */
+            const std::string & from() const;
+
+            /**
+             * For a rename the new name, for an enum default the constant
+             * to read the added one as
+             */
+            const std::string & to() const;
+    };
+
+}
+
+/******************************************************************************
+ *
+ * class Transforms
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * The transforms section of an envelope, every transform applied to
+     * each type the blob holds that has any, oldest first
+     */
+    class Transforms : public AMQPDescribed {
+        public :
+            friend std::ostream & operator << (std::ostream &, const Transforms &);
+
+            using Type = std::vector<Transform>;
+
+        private :
+            std::map<std::string, Type, std::less<>> m_types;
+
+        public :
+            Transforms() = default;
+
+            explicit Transforms (std::map<std::string, Type, std::less<>> types_);
+
+            /**
+             * nullptr if [type_] has never been transformed
+             */
+            const Type * find (const std::string & type_) const;
+
+            bool empty() const { return m_types.empty(); }
+    };
+
+}
+
+/******************************************************************************/
@@ -13,16 +13,16 @@
 
 #include <limits>
 #include <climits>
+#include <sstream>
 
 /******************************************************************************/
 
-/**
- *
- */
 namespace amqp::internal {
 
-    std::map<uint64_t, std::shared_ptr<internal::schema::descriptors::AMQPDescriptor>>
-    AMQPDescriptorRegistory = {
+    const std::map<
+        uint64_t,
+        std::shared_ptr<const internal::schema::descriptors::AMQPDescriptor>
+    > AMQPDescriptorRegistory = { // NOLINT
         {
             22UL,
             std::make_shared<internal::schema::descriptors::AMQPDescriptor> ("DESCRIBED", -1)
@@ -98,6 +98,21 @@ namespace amqp::internal {
 
 /******************************************************************************/
 
+const amqp::internal::schema::descriptors::AMQPDescriptor &
+amqp::internal::registeredDescriptor (uint64_t id_) {
+    auto it = AMQPDescriptorRegistory.find (id_);
+
+    if (it == AMQPDescriptorRegistory.end()) {
+        std::stringstream ss;
+        ss << "Unknown descriptor " << id_;
+        throw std::runtime_error (ss.str());
+    }
+
+    return *it->second;
+}
+
+/******************************************************************************/
+
 uint32_t
 amqp::stripCorda (uint64_t id) {
     return static_cast<uint32_t>(id & (uint64_t)UINT_MAX);
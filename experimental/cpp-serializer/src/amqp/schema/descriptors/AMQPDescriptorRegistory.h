@@ -9,17 +9,27 @@
 
 #include "AMQPDescriptor.h"
 
-/******************************************************************************/
-
-
 /******************************************************************************/
 
 /**
+ * Every descriptor we know how to read, keyed by its full AMQP id.
  *
+ * Fixed at compile time and never modified, so it can be read from any
+ * number of threads without synchronisation. Look things up through
+ * [registeredDescriptor] rather than indexing it directly, a miss must
+ * be an error, not an insertion.
  */
 namespace amqp::internal {
 
-    extern std::map<uint64_t, std::shared_ptr<internal::schema::descriptors::AMQPDescriptor>> AMQPDescriptorRegistory;
+    extern const std::map<
+        uint64_t,
+        std::shared_ptr<const internal::schema::descriptors::AMQPDescriptor>
+    > AMQPDescriptorRegistory;
+
+    /**
+     * @throws std::runtime_error if [id_] isn't a descriptor we know
+     */
+    const schema::descriptors::AMQPDescriptor & registeredDescriptor (uint64_t id_);
 
 }
 
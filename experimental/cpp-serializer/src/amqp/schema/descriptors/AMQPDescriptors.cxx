@@ -12,6 +12,7 @@
 #include "field-types/Field.h"
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/schema/described-types/Envelope.h"
+#include "amqp/schema/described-types/Transforms.h"
 #include "amqp/schema/described-types/Composite.h"
 #include "amqp/schema/restricted-types/Restricted.h"
 #include "amqp/schema/OrderedTypeNotations.h"
@@ -56,6 +57,10 @@ ReferencedObjectDescriptor::build (pn_data_t * data_) const {
 
 /******************************************************************************/
 
+/**
+ * A map of type name to a map of the kind of transform to every transform
+ * of that kind, each kind's in the order they were made
+ */
 uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 TransformSchemaDescriptor::build (pn_data_t * data_) const {
@@ -63,7 +68,48 @@ TransformSchemaDescriptor::build (pn_data_t * data_) const {
 
     DBG ("TRANSFORM SCHEMA " << data_ << std::endl); // NOLINT
 
-    return uPtr<amqp::AMQPDescribed> (nullptr);
+    if (pn_data_type (data_) != PN_MAP) {
+        throw std::runtime_error ("Expected a map of transforms");
+    }
+
+    std::map<std::string, schema::Transforms::Type, std::less<>> types;
+
+    proton::auto_map_enter byType (data_, true);
+
+    for (std::size_t i { 0 } ; i < byType.elements() / 2 ; ++i) {
+        auto & transforms = types[proton::get_string (data_)];
+        pn_data_next (data_);
+
+        if (pn_data_type (data_) != PN_MAP) {
+            throw std::runtime_error ("Expected a map of transforms by kind");
+        }
+
+        {
+            proton::auto_map_enter byKind (data_, true);
+
+            for (std::size_t j { 0 } ; j < byKind.elements() / 2 ; ++j) {
+                // each transform names its own kind so the key adds nothing
+                pn_data_next (data_);
+                proton::is_list (data_);
+
+                {
+                    proton::auto_list_enter ale (data_, true);
+
+                    for (std::size_t k { 0 } ; k < ale.elements() ; ++k) {
+                        transforms.emplace_back (
+                            std::move (*dispatchDescribed<schema::Transform> (data_)));
+                        pn_data_next (data_);
+                    }
+                }
+
+                pn_data_next (data_);
+            }
+        }
+
+        pn_data_next (data_);
+    }
+
+    return std::make_unique<schema::Transforms> (std::move (types));
 }
 
 /******************************************************************************/
@@ -75,7 +121,24 @@ TransformElementDescriptor::build (pn_data_t * data_) const {
 
     DBG ("TRANSFORM ELEMENT " << data_ << std::endl); // NOLINT
 
-    return uPtr<amqp::AMQPDescribed> (nullptr);
+    proton::is_list (data_);
+    proton::auto_list_enter ale (data_, true);
+
+    if (ale.elements() == 0) {
+        throw std::runtime_error ("Transform has no name");
+    }
+
+    auto name = proton::get_string (data_);
+
+    std::vector<std::string> arguments;
+    arguments.reserve (ale.elements() - 1);
+
+    for (std::size_t i { 1 } ; i < ale.elements() ; ++i) {
+        pn_data_next (data_);
+        arguments.emplace_back (proton::get_string (data_, true));
+    }
+
+    return std::make_unique<schema::Transform> (name, std::move (arguments));
 }
 
 /******************************************************************************/
@@ -7,6 +7,10 @@
 #include <string>
 #include <memory>
 #include <iostream>
+#include <stdexcept>
+#include <string_view>
+
+#include <proton/codec.h>
 
 #include "types.h"
 #include "amqp/AMQPDescribed.h"
@@ -40,7 +44,29 @@ namespace amqp::internal::schema::descriptors {
 
         return uPtr<T>(
             static_cast<T *>(
-                AMQPDescriptorRegistory[id]->build(data_).release()));
+                registeredDescriptor (id).build(data_).release()));
+    }
+
+    /**
+     * Decode [bytes_], a single described type lifted out of a blob, on
+     * its own
+     */
+    template<class T>
+    uPtr <T>
+    decodeDescribed (std::string_view bytes_) {
+        std::unique_ptr<pn_data_t, decltype (&pn_data_free)> data (
+            pn_data (0), &pn_data_free);
+
+        auto rtn = pn_data_decode (data.get(), bytes_.data(), bytes_.size());
+
+        if (rtn < 0 || static_cast<std::size_t>(rtn) != bytes_.size()) {
+            throw std::runtime_error ("Can't decode blob section");
+        }
+
+        pn_data_rewind (data.get());
+        pn_data_next (data.get());
+
+        return dispatchDescribed<T> (data.get());
     }
 }
 
@@ -24,7 +24,18 @@ ChoiceDescriptor::build (pn_data_t * data_) const  {
 
     auto name = proton::get_string (data_);
 
-    return std::make_unique<schema::Choice> (name);
+    /*
+     * The value is optional as far as we're concerned, only enums use it
+     * and then only to record each constant's ordinal
+     */
+    std::string value;
+    if (pn_data_next (data_)) {
+        value = proton::get_string (data_, true);
+    }
+
+    return std::make_unique<schema::Choice> (
+            std::move (name),
+            std::move (value));
 }
 
 /******************************************************************************/
@@ -12,6 +12,7 @@
 #include "amqp/schema/descriptors/AMQPDescriptors.h"
 
 #include "amqp/schema/field-types/Field.h"
+#include "amqp/schema/TypeNotation.h"
 #include "amqp/schema/described-types/Composite.h"
 #include "amqp/schema/described-types/Descriptor.h"
 
@@ -76,7 +77,7 @@ CompositeDescriptor::build (pn_data_t * data_) const {
         }
     }
 
-    return std::make_unique<schema::Composite> (
+    return std::make_unique<schema::TypeNotation> (
             schema::Composite (
                     std::move (name),
                     std::move (label),
@@ -128,7 +129,7 @@ CompositeDescriptor::read (
 
         ss_ << ai << "4] Descriptor:" << std::endl;
 
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+        registeredDescriptor (pn_data_type(data_)).read (
             (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
 
         ss_ << ai << "5] List: Fields: " << std::endl;
@@ -141,7 +142,7 @@ CompositeDescriptor::read (
                     << ale.elements() << "]"
                     << std::endl;
 
-                AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+                registeredDescriptor (pn_data_type(data_)).read (
                         data_, ss_, AutoIndent { ai2 });
             }
         }
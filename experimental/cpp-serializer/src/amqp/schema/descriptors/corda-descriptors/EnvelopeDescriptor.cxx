@@ -2,6 +2,10 @@
 
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/schema/described-types/Envelope.h"
+#include "amqp/schema/described-types/IndexedSchema.h"
+#include "amqp/schema/described-types/Transforms.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+#include "SchemaDescriptor.h"
 #include "proton/proton_wrapper.h"
 
 #include "types.h"
@@ -20,6 +24,19 @@ namespace {
         return proton::get_symbol<std::string> (data_);
     }
 
+    /**
+     * Older blobs end at the schema, expects to be on the node after it
+     */
+    uPtr<amqp::internal::schema::Transforms>
+    consumeTransforms (pn_data_t * data_) {
+        if (pn_data_type (data_) != PN_DESCRIBED) {
+            return nullptr;
+        }
+
+        return amqp::internal::schema::descriptors::dispatchDescribed<
+                amqp::internal::schema::Transforms> (data_);
+    }
+
 }
 
 /******************************************************************************
@@ -49,12 +66,12 @@ EnvelopeDescriptor::read (
         proton::auto_enter p (data_);
 
         ss_ << ai << "1]" << std::endl;
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+        registeredDescriptor (pn_data_type(data_)).read (
                 (pn_data_t *)proton::auto_next (data_), ss_, AutoIndent { ai });
 
 
         ss_ << ai << "2]" << std::endl;
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+        registeredDescriptor (pn_data_type(data_)).read (
                 (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
 
     }
@@ -94,18 +111,53 @@ EnvelopeDescriptor::build (pn_data_t * data_) const {
     /*
      * The schema
      */
-    auto schema = descriptors::dispatchDescribed<schema::Schema> (data_);
-
-    pn_data_next(data_);
+    uPtr<ISchemaType> schema = descriptors::dispatchDescribed<schema::Schema> (data_);
 
     /*
      * The transforms schema
      */
-    // Skip for now
-    // dispatchDescribed (data_);
+    uPtr<Transforms> transforms;
+    if (pn_data_next (data_)) {
+        transforms = consumeTransforms (data_);
+    }
 
-    return std::make_unique<schema::Envelope> (schema::Envelope (schema, outerType));
+    return std::make_unique<schema::Envelope> (
+            schema::Envelope (schema, outerType, std::move (transforms)));
 }
 
 /******************************************************************************/
 
+uPtr<amqp::internal::schema::Envelope>
+amqp::internal::schema::descriptors::
+EnvelopeDescriptor::index (pn_data_t * data_) const {
+    DBG ("ENVELOPE INDEX" << std::endl); // NOLINT
+
+    validateAndNext(data_);
+
+    proton::auto_enter p (data_);
+
+    std::string outerType = consumeBlob(data_);
+
+    pn_data_next (data_);
+
+    uint64_t id;
+    {
+        proton::is_described (data_);
+        proton::auto_enter p2 (data_);
+        id = pn_data_get_ulong (data_);
+    }
+
+    uPtr<ISchemaType> schema = dynamic_cast<const SchemaDescriptor &> (
+            registeredDescriptor (id)).index (data_);
+
+    // small and only ever read in full, so built rather than indexed
+    uPtr<Transforms> transforms;
+    if (pn_data_next (data_)) {
+        transforms = consumeTransforms (data_);
+    }
+
+    return std::make_unique<schema::Envelope> (
+            schema::Envelope (schema, outerType, std::move (transforms)));
+}
+
+/******************************************************************************/
@@ -3,7 +3,7 @@
 
 #include <string>
 
-#include "AMQPDescriptors.h"
+#include "amqp/schema/descriptors/AMQPDescriptors.h"
 
 /******************************************************************************
  *
@@ -13,6 +13,12 @@
 
 struct pn_data_t;
 
+namespace amqp::internal::schema {
+
+    class Envelope;
+
+}
+
 /******************************************************************************
  *
  * class amqp::internal::EnvelopeDescriptor
@@ -30,6 +36,13 @@ namespace amqp::internal::schema::descriptors {
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
+            /**
+             * As [build] but with the schema only indexed, see
+             * [SchemaDescriptor::index]. The envelope refers back into
+             * [data_] so mustn't outlive it.
+             */
+            std::unique_ptr<Envelope> index (pn_data_t * data_) const;
+
             void read (
                     pn_data_t *,
                     std::stringstream &,
@@ -4,12 +4,15 @@
 #include "debug.h"
 
 #include "amqp/schema/described-types/Choice.h"
+#include "amqp/schema/TypeNotation.h"
 #include "amqp/schema/restricted-types/Restricted.h"
 #include "amqp/schema/descriptors/AMQPDescriptors.h"
+#include "amqp/reader/well-known-readers/WellKnownReader.h"
 
 #include <map>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 
 /******************************************************************************/
 
@@ -22,11 +25,11 @@ namespace {
             },
             {
                 "java.lang.Boolean",
-                std::pair { std::regex { "java.lang.Boolean"}, "bool"}
+                std::pair { std::regex { "java.lang.Boolean"}, "boolean"}
             },
             {
                 "java.lang.Byte",
-                std::pair { std::regex { "java.lang.Byte"}, "char"}
+                std::pair { std::regex { "java.lang.Byte"}, "byte"}
             },
             {
                 "java.lang.Short",
@@ -66,6 +69,24 @@ namespace amqp::internal::schema::descriptors {
         return name;
     }
 
+    bool
+    RestrictedDescriptor::customSerialised (
+        const std::string & name_,
+        const std::string & source_
+    ) {
+        if (source_ == "list" || source_ == "map") {
+            return false;
+        }
+
+        if (!reader::WellKnownReader::isWellKnown (name_)) {
+            throw std::runtime_error (
+                "Type " + name_ + " is custom serialised as " + source_
+                    + " and isn't one we know how to read");
+        }
+
+        return true;
+    }
+
 }
 
 /******************************************************************************/
@@ -145,6 +166,19 @@ RestrictedDescriptor::build (pn_data_t * data_) const {
 
     DBG (data_ << std::endl);
 
+    /*
+     * Anything that isn't a container was written by one of the JVM's
+     * custom serialisers as a described primitive, BigDecimal as a string
+     * or PublicKey as binary for example. There's nothing in the schema
+     * for us to build a reader from so they're left to the well known
+     * readers, which recognise them by name. Any they don't recognise
+     * we could never read so the schema is rejected outright.
+     */
+    if (customSerialised (name, source)) {
+        DBG ("  custom serialised as " << source << std::endl); // NOLINT
+        return nullptr;
+    }
+
     return schema::Restricted::make (
             std::move (descriptor),
             std::move (name),
@@ -190,7 +224,7 @@ RestrictedDescriptor::read (
 
     ss_ << ai << "5] Descriptor:" << std::endl;
 
-    AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+    registeredDescriptor (pn_data_type(data_)).read (
             (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
 }
 
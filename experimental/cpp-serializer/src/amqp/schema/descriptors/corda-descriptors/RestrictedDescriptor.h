@@ -19,6 +19,18 @@ namespace amqp::internal::schema::descriptors {
              */
             static std::string makePrim (const std::string &);
 
+            /**
+             * Whether the restricted type [name_] was written by one of
+             * the JVM's custom serialisers, as something other than a
+             * list or map, and so has no notation of its own.
+             *
+             * @throws std::runtime_error if it was but isn't a type the
+             * well known readers can read
+             */
+            static bool customSerialised (
+                const std::string & name_,
+                const std::string & source_);
+
     public :
         RestrictedDescriptor() = delete;
         RestrictedDescriptor (std::string, int);
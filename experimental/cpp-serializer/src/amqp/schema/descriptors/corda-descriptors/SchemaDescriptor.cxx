@@ -9,13 +9,83 @@
 #include "amqp/AMQPDescribed.h"
 #include "amqp/schema/descriptors/AMQPDescriptors.h"
 #include "amqp/schema/described-types/Schema.h"
+#include "amqp/schema/Descriptors.h"
+#include "amqp/schema/described-types/IndexedSchema.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+#include "RestrictedDescriptor.h"
 #include "amqp/schema/OrderedTypeNotations.h"
-#include "amqp/schema/AMQPTypeNotation.h"
+#include "amqp/schema/TypeNotation.h"
 
 #include <sstream>
 
 /******************************************************************************/
 
+namespace {
+
+    using namespace amqp::internal::schema;
+
+    /**
+     * The symbol held by the Descriptor described type we're on
+     */
+    std::string
+    descriptorOf (pn_data_t * data_) {
+        proton::is_described (data_);
+        proton::auto_enter p (data_);
+        pn_data_next (data_);
+        proton::auto_enter p2 (data_);
+
+        return proton::get_symbol<std::string> (data_);
+    }
+
+    /**
+     * Just enough of a type's definition to find it again, see the build
+     * methods of CompositeDescriptor and RestrictedDescriptor for what's
+     * where. Types written by a custom serialiser have no notation so
+     * aren't indexed either, and those we can't read fail the schema.
+     */
+    bool
+    indexType (pn_data_t * data_, IndexedSchema::Entry & entry_) {
+        proton::is_described (data_);
+        proton::auto_enter p (data_);
+
+        auto id = amqp::stripCorda (pn_data_get_ulong (data_));
+
+        pn_data_next (data_);
+        proton::auto_enter p2 (data_);
+
+        entry_.name = proton::get_string (data_);
+
+        if (id == static_cast<uint32_t>(::amqp::schema::descriptors::COMPOSITE_TYPE)) {
+            // name, label, provides, descriptor
+            for (int i { 0 } ; i < 3 ; ++i) {
+                pn_data_next (data_);
+            }
+        } else if (id == static_cast<uint32_t>(::amqp::schema::descriptors::RESTRICTED_TYPE)) {
+            entry_.name = descriptors::RestrictedDescriptor::makePrim (entry_.name);
+
+            // name, label, provides, source, descriptor
+            pn_data_next (data_);
+            pn_data_next (data_);
+            pn_data_next (data_);
+
+            auto source = proton::readAndNext<std::string> (data_);
+            if (descriptors::RestrictedDescriptor::customSerialised (entry_.name, source)) {
+                return false;
+            }
+        } else {
+            throw std::runtime_error (
+                "Unexpected " + amqp::describedToString (id) + " in schema");
+        }
+
+        entry_.descriptor = descriptorOf (data_);
+
+        return true;
+    }
+
+}
+
+/******************************************************************************/
+
 amqp::internal::schema::descriptors::
 SchemaDescriptor::SchemaDescriptor (
     std::string symbol_,
@@ -32,7 +102,7 @@ SchemaDescriptor::build (pn_data_t * data_) const {
 
     validateAndNext(data_);
 
-    schema::OrderedTypeNotations<schema::AMQPTypeNotation> schemas;
+    schema::OrderedTypeNotations<schema::TypeNotation> schemas;
 
     /*
      * The Schema is stored as a list of lists of described objects
@@ -44,9 +114,15 @@ SchemaDescriptor::build (pn_data_t * data_) const {
             DBG ("  " << i << "/" << ale.elements() << std::endl); // NOLINT
             proton::auto_list_enter ale2 (data_);
             while (pn_data_next(data_)) {
-                schemas.insert (
-                    descriptors::dispatchDescribed<schema::AMQPTypeNotation> (
-                        data_));
+                auto type = descriptors::dispatchDescribed<schema::TypeNotation> (
+                        data_);
+
+                // types written by a custom serialiser have no notation
+                if (!type) {
+                    continue;
+                }
+
+                schemas.insert (std::move (type));
 
                 DBG("=======" << std::endl << schemas << "======" << std::endl);
             }
@@ -58,6 +134,40 @@ SchemaDescriptor::build (pn_data_t * data_) const {
 
 /******************************************************************************/
 
+uPtr<amqp::internal::schema::IndexedSchema>
+amqp::internal::schema::descriptors::
+SchemaDescriptor::index (pn_data_t * data_) const {
+    DBG ("SCHEMA INDEX" << std::endl); // NOLINT
+
+    auto point = pn_data_point (data_);
+
+    std::vector<IndexedSchema::Entry> entries;
+
+    {
+        proton::is_described (data_);
+        proton::auto_enter p (data_);
+
+        validateAndNext (data_);
+
+        proton::auto_list_enter ale (data_);
+
+        while (pn_data_next (data_)) {
+            proton::auto_list_enter ale2 (data_);
+
+            while (pn_data_next (data_)) {
+                IndexedSchema::Entry entry { { }, { }, pn_data_point (data_) };
+
+                if (indexType (data_, entry)) {
+                    entries.emplace_back (std::move (entry));
+                }
+            }
+        }
+    }
+
+    return std::make_unique<IndexedSchema> (data_, point, std::move (entries));
+}
+
+/******************************************************************************/
 
 void
 amqp::internal::schema::descriptors::
@@ -85,7 +195,7 @@ SchemaDescriptor::read (
                 ss_ << ai2 << i << ":" << j << "/" << ale2.elements()
                         << "] " << std::endl;
 
-                AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+                registeredDescriptor (pn_data_type(data_)).read (
                         data_, ss_,
                         AutoIndent { ai2 });
             }
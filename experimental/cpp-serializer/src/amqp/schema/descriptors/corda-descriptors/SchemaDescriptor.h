@@ -6,6 +6,12 @@
 
 struct pn_data_t;
 
+namespace amqp::internal::schema {
+
+    class IndexedSchema;
+
+}
+
 /******************************************************************************/
 
 namespace amqp::internal::schema::descriptors {
@@ -18,6 +24,12 @@ namespace amqp::internal::schema::descriptors {
 
         std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
+        /**
+         * Note where each type is rather than building it, [data_] should
+         * be on the schema's described node, which is where it's left
+         */
+        std::unique_ptr<IndexedSchema> index (pn_data_t * data_) const;
+
         void read (
                 pn_data_t *,
                 std::stringstream &,
@@ -1,5 +1,6 @@
 #include "Field.h"
 
+#include <set>
 #include <sstream>
 #include <iostream>
 
@@ -12,6 +13,8 @@
 
 #include "../restricted-types/Array.h"
 
+#include "amqp/reader/PropertyReader.h"
+
 /******************************************************************************/
 
 namespace amqp::internal::schema {
@@ -117,12 +120,13 @@ Field::Field (
 
 bool
 amqp::internal::schema::
-Field::typeIsPrimitive (const std::string & type_) {
-    return (type_ == "string" ||
-            type_ == "long" ||
-            type_ == "boolean" ||
-            type_ == "int" ||
-            type_ == "double");
+Field::typeIsPrimitive (std::string_view type_) {
+    static const std::set<std::string, std::less<>> primitives { // NOLINT
+        reader::PropertyReader::primitives().begin(),
+        reader::PropertyReader::primitives().end()
+    };
+
+    return primitives.find (type_) != primitives.end();
 }
 
 /******************************************************************************/
@@ -151,3 +155,35 @@ Field::requires() const {
 
 /******************************************************************************/
 
+const std::string &
+amqp::internal::schema::
+Field::defaultValue() const {
+    return m_default;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Field::label() const {
+    return m_label;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::schema::
+Field::mandatory() const {
+    return m_mandatory;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::schema::
+Field::multiple() const {
+    return m_multiple;
+}
+
+/******************************************************************************/
+
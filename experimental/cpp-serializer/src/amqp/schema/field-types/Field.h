@@ -9,6 +9,7 @@
 
 #include <list>
 #include <string>
+#include <string_view>
 #include <iosfwd>
 
 /******************************************************************************/
@@ -30,7 +31,7 @@ namespace amqp::internal::schema {
         public :
             friend std::ostream & operator << (std::ostream &, const Field &);
 
-            static bool typeIsPrimitive (const std::string &);
+            static bool typeIsPrimitive (std::string_view);
 
             static uPtr<Field> make (
                     std::string, std::string, std::list<std::string>,
@@ -53,6 +54,10 @@ namespace amqp::internal::schema {
             const std::string & name() const;
             const std::string & type() const;
             const std::list<std::string> & requires() const;
+            const std::string & defaultValue() const;
+            const std::string & label() const;
+            bool mandatory() const;
+            bool multiple() const;
 
             virtual bool primitive() const = 0;
             virtual const std::string & fieldType() const = 0;
@@ -1,5 +1,7 @@
 #include "Enum.h"
 
+#include <charconv>
+#include <stdexcept>
 #include <algorithm>
 
 #include "debug.h"
@@ -25,13 +27,21 @@ Enum::Enum (
         std::move (provides_),
         amqp::internal::schema::Restricted::RestrictedTypes::enum_t)
     , m_source { std::move (source_) }
-    , m_enum { name_ }
+    , m_enum { name() }
     , m_choices { std::move (choices_) }
 {
 }
 
 /******************************************************************************/
 
+const std::vector<uPtr<amqp::internal::schema::Choice>> &
+amqp::internal::schema::
+Enum::choices() const {
+    return m_choices;
+}
+
+/******************************************************************************/
+
 std::vector<std::string>::const_iterator
 amqp::internal::schema::
 Enum::begin() const {
@@ -113,15 +123,62 @@ Enum::dependsOnRHS (const amqp::internal::schema::Composite & lhs_) const {
 
 /*********************************************************o*********************/
 
+/**
+ * @return the names of the constants indexed by their ordinal. Corda writes
+ * them in ordinal order anyway but the value of each choice tells us for
+ * sure. A choice without one takes the first ordinal nothing else has, one
+ * whose value isn't an ordinal we could have, or is one already taken,
+ * means the schema is broken.
+ */
 std::vector<std::string>
 amqp::internal::schema::
 Enum::makeChoices() const {
-    std::vector<std::string> rtn;
-    std::transform (
-            m_choices.begin(),
-            m_choices.end(),
-            std::back_inserter(rtn),
-            [](const uPtr<Choice> & c) -> std::string { return c->choice(); });
+    std::vector<std::string> rtn (m_choices.size());
+    std::vector<bool> taken (m_choices.size());
+
+    for (const auto & choice : m_choices) {
+        const auto & value = choice->value();
+
+        if (value.empty()) {
+            continue;
+        }
+
+        std::size_t ordinal;
+        auto res = std::from_chars (
+                value.data(), value.data() + value.size(), ordinal);
+
+        if (res.ec != std::errc() || res.ptr != value.data() + value.size()) {
+            throw std::runtime_error (
+                "Enum " + name() + " constant " + choice->choice()
+                    + " has malformed ordinal " + value);
+        }
+
+        if (ordinal >= rtn.size()) {
+            throw std::runtime_error (
+                "Enum " + name() + " constant " + choice->choice()
+                    + " has out of range ordinal " + value);
+        }
+
+        if (taken[ordinal]) {
+            throw std::runtime_error (
+                "Enum " + name() + " constants " + rtn[ordinal] + " and "
+                    + choice->choice() + " share ordinal " + value);
+        }
+
+        rtn[ordinal] = choice->choice();
+        taken[ordinal] = true;
+    }
+
+    std::size_t free { 0 };
+
+    for (const auto & choice : m_choices) {
+        if (choice->value().empty()) {
+            while (taken[free]) ++free;
+
+            rtn[free] = choice->choice();
+            taken[free] = true;
+        }
+    }
 
     return rtn;
 }
@@ -32,6 +32,8 @@ namespace amqp::internal::schema {
             int dependsOnRHS (const Composite &) const override;
 
             std::vector<std::string> makeChoices() const;
+
+            const std::vector<uPtr<Choice>> & choices() const;
     };
 
 }
@@ -5,6 +5,8 @@
 #include "Enum.h"
 #include "Array.h"
 
+#include "amqp/schema/TypeNotation.h"
+
 #include <string>
 #include <vector>
 #include <iostream>
@@ -82,13 +84,14 @@ namespace {
 
     std::map<std::string, std::string> boxedToUnboxed = {
             { "java.lang.Integer", "int" },
-            { "java.lang.Boolean", "bool" },
-            { "java.lang.Byte", "char" },
+            { "java.lang.Boolean", "boolean" },
+            { "java.lang.Byte", "byte" },
             { "java.lang.Short", "short" },
             { "java.lang.Character", "char" },
             { "java.lang.Float", "float" },
             { "java.lang.Long", "long" },
-            { "java.lang.Double", "double" }
+            { "java.lang.Double", "double" },
+            { "java.lang.String", "string" }
     };
 
 }
@@ -126,7 +129,7 @@ Restricted::unbox (const std::string & type_) {
  * @param source_
  * @return
  */
-uPtr<amqp::internal::schema::Restricted>
+uPtr<amqp::internal::schema::TypeNotation>
 amqp::internal::schema::
 Restricted::make(
         uPtr<Descriptor> descriptor_,
@@ -154,36 +157,36 @@ Restricted::make(
             if (   std::equal (name_.rbegin(), name_.rbegin() + array.size(), array.rbegin(), array.rend())
                 || std::equal (name_.rbegin(), name_.rbegin() + primArray.size(), primArray.rbegin(), primArray.rend()))
             {
-                return std::make_unique<Array>(
+                return std::make_unique<TypeNotation> (Array (
                         std::move (descriptor_),
                         std::move (name_),
                         std::move (label_),
                         std::move (provides_),
-                        std::move (source_));
+                        std::move (source_)));
             } else {
-                return std::make_unique<List>(
+                return std::make_unique<TypeNotation> (List (
                         std::move (descriptor_),
                         std::move (name_),
                         std::move (label_),
                         std::move (provides_),
-                        std::move (source_));
+                        std::move (source_)));
             }
         } else {
-            return std::make_unique<Enum>(
+            return std::make_unique<TypeNotation> (Enum (
                     std::move (descriptor_),
                     std::move (name_),
                     std::move (label_),
                     std::move (provides_),
                     std::move (source_),
-                    std::move (choices_));
+                    std::move (choices_)));
         }
     } else if (source_ == "map") {
-        return std::make_unique<Map> (
+        return std::make_unique<TypeNotation> (Map (
                 std::move (descriptor_),
                 std::move (name_),
                 std::move (label_),
                 std::move (provides_),
-                std::move (source_));
+                std::move (source_)));
     } else {
         throw std::runtime_error ("Unknown restricted type");
     }
@@ -233,6 +236,38 @@ Restricted::dependsOn (const OrderedTypeNotation & rhs_) const {
 
 /*********************************************************o*********************/
 
+int
+amqp::internal::schema::
+Restricted::dependsOnRHS (const Map & lhs_) const {
+    return dependsOnMap (lhs_);
+}
+
+/******************************************************************************/
+
+int
+amqp::internal::schema::
+Restricted::dependsOnRHS (const List & lhs_) const {
+    return dependsOnList (lhs_);
+}
+
+/******************************************************************************/
+
+int
+amqp::internal::schema::
+Restricted::dependsOnRHS (const Array & lhs_) const {
+    return dependsOnArray (lhs_);
+}
+
+/******************************************************************************/
+
+int
+amqp::internal::schema::
+Restricted::dependsOnRHS (const Enum & lhs_) const {
+    return dependsOnEnum (lhs_);
+}
+
+/*********************************************************o*********************/
+
 /*
  * If the left hand side of the original call, restricted_ in this case,
  * depends on this instance then we return 1.
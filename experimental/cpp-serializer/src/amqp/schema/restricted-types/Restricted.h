@@ -30,6 +30,8 @@ namespace amqp::internal::schema {
     class List;
     class Array;
 
+    class TypeNotation;
+
 }
 
 /******************************************************************************
@@ -82,7 +84,7 @@ namespace amqp::internal::schema {
             virtual int dependsOnEnum (const Enum &) const = 0;
 
         public :
-            static std::unique_ptr<Restricted> make(
+            static std::unique_ptr<TypeNotation> make(
                     std::unique_ptr<Descriptor>,
                     std::string,
                     std::string,
@@ -90,7 +92,8 @@ namespace amqp::internal::schema {
                     std::string,
                     std::vector<uPtr<Choice>>);
 
-            Restricted (Restricted&) = delete;
+            Restricted (const Restricted &) = delete;
+            Restricted (Restricted &&) = default;
 
             Type type() const override;
 
@@ -109,6 +112,15 @@ namespace amqp::internal::schema {
 
             int dependsOnRHS (const Composite &) const override = 0;
 
+            /**
+             * Used when the concrete type of the left hand side is already
+             * known, avoids switching on its [RestrictedTypes]
+             */
+            int dependsOnRHS (const Map &) const;
+            int dependsOnRHS (const List &) const;
+            int dependsOnRHS (const Array &) const;
+            int dependsOnRHS (const Enum &) const;
+
             const decltype (m_provides) & provides() const { return m_provides; }
             const decltype (m_label) & label() const { return m_label; }
             const decltype (m_source) & source() const { return m_source; }
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <algorithm>
+
+#include "amqp/Binary.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::binary;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Every byte value, and lengths either side of the vector widths
+     */
+    std::string
+    bytes (std::size_t size_) {
+        std::string rtn (size_, '\0');
+        for (std::size_t i { 0 } ; i < size_ ; ++i) {
+            rtn[i] = static_cast<char>(i * 37 + size_);
+        }
+
+        return rtn;
+    }
+
+    /**
+     * The bytes padded base64 from the standard alphabet stands for
+     */
+    std::string
+    unbase64 (std::string_view in_) {
+        static const std::string alphabet {
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/" };
+
+        std::string rtn;
+        uint32_t bits { 0 };
+        int count { 0 };
+
+        for (auto c : in_) {
+            if (c == '=') {
+                break;
+            }
+
+            bits = (bits << 6) | static_cast<uint32_t>(alphabet.find (c));
+            if ((count += 6) >= 8) {
+                count -= 8;
+                rtn += static_cast<char>((bits >> count) & 0xffU);
+            }
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Binary, hex) { // NOLINT
+    std::string out { "x" };
+    hex (std::string ("\x00\x0f\xa5\xff", 4), out, Engine::Scalar);
+
+    EXPECT_EQ ("x000FA5FF", out);
+}
+
+/******************************************************************************/
+
+TEST (Binary, base64) { // NOLINT
+    const std::pair<std::string, std::string> vectors[] = {
+        { "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" },
+        { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" },
+        { "\xfb\xff\xfe", "+//+" }
+    };
+
+    for (const auto & [ in, expected ] : vectors) {
+        std::string out;
+        base64 (in, out, Engine::Scalar);
+
+        EXPECT_EQ (expected, out);
+    }
+}
+
+/******************************************************************************/
+
+TEST (Binary, engines) { // NOLINT
+    for (auto engine : amqp::internal::cpu::available (KERNELS)) {
+        for (std::size_t size { 0 } ; size < 200 ; ++size) {
+            auto in = bytes (size);
+
+            std::string scalar, vector;
+
+            hex (in, scalar, Engine::Scalar);
+            hex (in, vector, engine);
+            EXPECT_EQ (scalar, vector);
+
+            scalar.clear();
+            vector.clear();
+
+            base64 (in, scalar, Engine::Scalar);
+            base64 (in, vector, engine);
+            EXPECT_EQ (scalar, vector);
+        }
+    }
+}
+
+/******************************************************************************/
+
+TEST (Binary, render) { // NOLINT
+    const std::string in { "\x01\x02\x03\x04\x05", 5 };
+
+    EXPECT_EQ ("\"0102030405\"", render (in));
+
+    amqp::Rendering rendering;
+    rendering.truncate = 3;
+
+    {
+        Scope scope (rendering);
+        EXPECT_EQ ("\"010203...[5 bytes]\"", render (in));
+        EXPECT_EQ ("\"0102\"", render (in.substr (0, 2)));
+
+        rendering.binary = amqp::Rendering::Binary::Base64;
+        EXPECT_EQ ("\"AQID...[5 bytes]\"", render (in));
+    }
+
+    EXPECT_EQ ("\"0102030405\"", render (in));
+}
+
+/******************************************************************************/
+
+/**
+ * What's rendered is always a JSON string, cut short or not, and what's
+ * inside it reads back as the bytes it was cut from
+ */
+TEST (Binary, renderParse) { // NOLINT
+    const auto in = bytes (100);
+
+    amqp::Rendering rendering;
+    rendering.binary = amqp::Rendering::Binary::Base64;
+    rendering.truncate = 31;
+
+    Scope scope (rendering);
+    auto out = render (in);
+
+    ASSERT_GE (out.size(), 2U);
+    EXPECT_EQ ('"', out.front());
+    EXPECT_EQ ('"', out.back());
+    EXPECT_EQ (2U, std::count (out.begin(), out.end(), '"'));
+
+    auto inside = std::string_view (out).substr (1, out.size() - 2);
+    auto marker = inside.find ("...[");
+    ASSERT_NE (std::string_view::npos, marker);
+
+    EXPECT_EQ (in.substr (0, 31), unbase64 (inside.substr (0, marker)));
+    EXPECT_EQ ("...[100 bytes]", inside.substr (marker));
+
+    rendering.truncate = 0;
+    out = render (in);
+    EXPECT_EQ (in, unbase64 (std::string_view (out).substr (1, out.size() - 2)));
+}
+
+/******************************************************************************/
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "amqp/Budget.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+/**
+ * Readers used outside of a decode aren't charged anything
+ */
+TEST (Budget, unscoped) { // NOLINT
+    Budget::Frame frame;
+    Budget::node();
+    Budget::bytes (SIZE_MAX);
+    Budget::elements (SIZE_MAX);
+}
+
+/******************************************************************************/
+
+TEST (Budget, depth) { // NOLINT
+    amqp::Limits limits;
+    limits.depth = 2;
+
+    Budget budget (limits);
+    Budget::Scope scope (budget);
+
+    {
+        Budget::Frame f1;
+        Budget::Frame f2;
+
+        EXPECT_THROW (Budget::Frame f3, amqp::LimitExceeded);
+    }
+
+    // leaving a level gives it back
+    Budget::Frame f1;
+    Budget::Frame f2;
+}
+
+/******************************************************************************/
+
+TEST (Budget, nodes) { // NOLINT
+    amqp::Limits limits;
+    limits.nodes = 4;
+
+    Budget budget (limits);
+    Budget::Scope scope (budget);
+
+    Budget::node();
+    Budget::elements (3);
+    EXPECT_THROW (Budget::elements (4), amqp::LimitExceeded);
+
+    Budget::node();
+    Budget::node();
+    Budget::node();
+    EXPECT_THROW (Budget::node(), amqp::LimitExceeded);
+}
+
+/******************************************************************************/
+
+TEST (Budget, bytes) { // NOLINT
+    amqp::Limits limits;
+    limits.bytes = 10;
+
+    Budget budget (limits);
+    Budget::Scope scope (budget);
+
+    Budget::bytes (6);
+    Budget::bytes (4);
+    EXPECT_THROW (Budget::bytes (1), amqp::LimitExceeded);
+}
+
+/******************************************************************************/
+
+TEST (Budget, nested) { // NOLINT
+    amqp::Limits outerLimits;
+    outerLimits.nodes = 1;
+
+    Budget outer (outerLimits);
+    Budget::Scope outerScope (outer);
+
+    {
+        Budget inner { amqp::Limits() };
+        Budget::Scope innerScope (inner);
+
+        Budget::node();
+        Budget::node();
+    }
+
+    Budget::node();
+    EXPECT_THROW (Budget::node(), amqp::LimitExceeded);
+}
+
+/******************************************************************************/
+
+/**
+ * Blobs nested in one share what it left rather than each having all
+ * of it, and go on sharing it with their own nested blobs a level down
+ */
+TEST (Budget, siblings) { // NOLINT
+    amqp::Limits limits;
+    limits.nodes = 10;
+    limits.depth = 3;
+
+    Budget outer (limits);
+    {
+        Budget::Scope scope (outer);
+        Budget::node();
+        Budget::node();
+    }
+
+    auto share = outer.nested();
+    EXPECT_EQ (2U, share.depth());
+    EXPECT_EQ (8U, share.limits().nodes);
+    EXPECT_FALSE (share.expired());
+
+    for (int i { 0 } ; i < 3 ; ++i) {
+        Budget sibling (share);
+        Budget::Scope scope (sibling);
+        Budget::node();
+        Budget::node();
+    }
+
+    EXPECT_EQ (2U, share.limits().nodes);
+
+    Budget last (share);
+    Budget::Scope scope (last);
+
+    auto below = last.nested();
+    EXPECT_EQ (1U, below.depth());
+    EXPECT_EQ (2U, below.limits().nodes);
+
+    EXPECT_THROW (Budget::elements (3), amqp::LimitExceeded);
+    Budget::node();
+    Budget::node();
+    EXPECT_THROW (Budget::node(), amqp::LimitExceeded);
+}
+
+/******************************************************************************/
+
+/**
+ * The deadline is the outermost's, not however long was left when each
+ * nested blob got round to asking
+ */
+TEST (Budget, siblingsDeadline) { // NOLINT
+    amqp::Limits limits;
+    limits.time = std::chrono::milliseconds (5);
+
+    auto share = Budget (limits).nested();
+    EXPECT_FALSE (share.expired());
+
+    std::this_thread::sleep_for (std::chrono::milliseconds (10));
+
+    EXPECT_TRUE (share.expired());
+    EXPECT_EQ (0, Budget (amqp::Limits()).nested().limits().time.count());
+}
+
+/******************************************************************************/
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "amqp/Cpu.h"
+#include "amqp/JSON.h"
+#include "amqp/Binary.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::cpu;
+
+/******************************************************************************/
+
+/**
+ * Scalar is always there, a kernel only if the CPU can run it, and an
+ * engine the module hasn't a kernel for never is
+ */
+TEST (Cpu, resolve) { // NOLINT
+    const Kernels kernels { Engine::AVX2, Engine::SSE2 };
+
+    EXPECT_EQ (Engine::Scalar, resolve (Engine::Scalar, kernels, "test"));
+    EXPECT_EQ (best (kernels), resolve (Engine::Best, kernels, "test"));
+    EXPECT_EQ (Engine::Scalar, best ({ }));
+
+    EXPECT_THROW (resolve (Engine::SHANI, kernels, "test"), std::runtime_error); // NOLINT
+    EXPECT_THROW (resolve (Engine::SSE2, { }, "test"), std::runtime_error); // NOLINT
+
+    for (auto engine : kernels) {
+        if (supported (engine)) {
+            EXPECT_EQ (engine, resolve (engine, kernels, "test"));
+        } else {
+            EXPECT_THROW (resolve (engine, kernels, "test"), std::runtime_error); // NOLINT
+        }
+    }
+
+    auto all = available (kernels);
+    EXPECT_EQ (Engine::Best, all[0]);
+    EXPECT_EQ (Engine::Scalar, all[1]);
+    EXPECT_EQ (all.end(), std::find (all.begin(), all.end(), Engine::SHANI));
+}
+
+/******************************************************************************/
+
+/**
+ * Asking a module for a kernel it doesn't have is an error, not a quiet
+ * fall back to scalar
+ */
+TEST (Cpu, modules) { // NOLINT
+    std::string out;
+
+    EXPECT_THROW ( // NOLINT
+        amqp::internal::json::escape ("x", out, Engine::SSSE3),
+        std::runtime_error);
+    EXPECT_THROW ( // NOLINT
+        amqp::internal::binary::hex ("x", out, Engine::SSE2),
+        std::runtime_error);
+}
+
+/******************************************************************************/
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "proton/codec.h"
+
+#include "amqp/reader/Policy.h"
+#include "amqp/schema/described-types/Choice.h"
+#include "amqp/schema/described-types/Schema.h"
+#include "amqp/schema/described-types/Descriptor.h"
+#include "amqp/schema/restricted-types/Enum.h"
+#include "amqp/reader/restricted-readers/EnumReader.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+using namespace amqp::internal::schema;
+
+/******************************************************************************/
+
+namespace {
+
+    const std::string descriptor { "net.corda:colour" }; // NOLINT
+
+    /**
+     * Each choice is a constant and the ordinal it's written with, which
+     * may be empty
+     */
+    Enum
+    colour (const std::vector<std::pair<std::string, std::string>> & choices_) {
+        std::vector<uPtr<Choice>> choices;
+        for (const auto & [ choice, value ] : choices_) {
+            choices.emplace_back (std::make_unique<Choice> (choice, value));
+        }
+
+        return Enum (
+            std::make_unique<Descriptor> (descriptor),
+            "colour", "", { }, "list", std::move (choices));
+    }
+
+    /**
+     * The enum constant [constant_] as Corda writes it, followed by
+     * [ordinal_]
+     */
+    std::string
+    read (
+        const reader::EnumReader<reader::Strict> & reader_,
+        const std::string & constant_,
+        int32_t ordinal_
+    ) {
+        auto data = pn_data (0);
+
+        pn_data_put_described (data);
+        pn_data_enter (data);
+        pn_data_put_symbol (data, pn_bytes (descriptor.size(), descriptor.data()));
+        pn_data_put_list (data);
+        pn_data_enter (data);
+        pn_data_put_string (data, pn_bytes (constant_.size(), constant_.data()));
+        pn_data_put_int (data, ordinal_);
+        pn_data_exit (data);
+        pn_data_exit (data);
+
+        pn_data_rewind (data);
+        pn_data_next (data);
+
+        const Schema schema { std::vector<TypeNotation> { } };
+        auto rtn = reader_.dump ("e", data, schema)->dump();
+
+        pn_data_free (data);
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Constants are ordered by the ordinal each is written with, not the order
+ * the schema lists them in
+ */
+TEST (Enum, ordinals) { // NOLINT
+    auto e = colour ({ { "GREEN", "1" }, { "BLUE", "2" }, { "RED", "0" } });
+
+    EXPECT_EQ (
+        (std::vector<std::string> { "RED", "GREEN", "BLUE" }),
+        e.makeChoices());
+}
+
+/******************************************************************************/
+
+/**
+ * Those without an ordinal fill whatever ordinals are left, in order
+ */
+TEST (Enum, unnumbered) { // NOLINT
+    auto e = colour ({ { "A", "" }, { "B", "0" }, { "C", "" }, { "D", "2" } });
+
+    EXPECT_EQ (
+        (std::vector<std::string> { "B", "A", "D", "C" }),
+        e.makeChoices());
+}
+
+/******************************************************************************/
+
+/**
+ * A schema we can't order is broken, rather than quietly dropping one
+ * constant over another
+ */
+TEST (Enum, badOrdinals) { // NOLINT
+    EXPECT_THROW (colour ({ { "A", "0" }, { "B", "x" } }).makeChoices(), std::runtime_error);
+    EXPECT_THROW (colour ({ { "A", "0" }, { "B", "1x" } }).makeChoices(), std::runtime_error);
+    EXPECT_THROW (colour ({ { "A", "-1" }, { "B", "0" } }).makeChoices(), std::runtime_error);
+    EXPECT_THROW (colour ({ { "A", "0" }, { "B", "2" } }).makeChoices(), std::runtime_error);
+    EXPECT_THROW (colour ({ { "A", "1" }, { "B", "1" } }).makeChoices(), std::runtime_error);
+    EXPECT_THROW (colour ({ { "A", "" }, { "B", "0" }, { "C", "0" } }).makeChoices(), std::runtime_error);
+}
+
+/******************************************************************************/
+
+/**
+ * Read off a schema listing its constants out of order, by ordinal when
+ * it agrees with the name, by name when it doesn't and as written when
+ * the name isn't one of ours
+ */
+TEST (EnumReader, ordinals) { // NOLINT
+    auto e = colour ({ { "GREEN", "1" }, { "BLUE", "2" }, { "RED", "0" } });
+
+    reader::EnumReader<reader::Strict> reader ("colour", descriptor, e.makeChoices());
+
+    EXPECT_EQ ("e : RED", read (reader, "RED", 0));
+    EXPECT_EQ ("e : GREEN", read (reader, "GREEN", 1));
+    EXPECT_EQ ("e : BLUE", read (reader, "BLUE", 2));
+
+    EXPECT_EQ ("e : BLUE", read (reader, "BLUE", 0));
+    EXPECT_EQ ("e : GREEN", read (reader, "GREEN", 7));
+    EXPECT_EQ ("e : PINK", read (reader, "PINK", 1));
+}
+
+/******************************************************************************/
+
+/**
+ * An evolved enum reads each constant as what it's now called
+ */
+TEST (EnumReader, values) { // NOLINT
+    auto e = colour ({ { "RED", "0" }, { "GREEN", "1" } });
+
+    reader::EnumReader<reader::Strict> reader (
+        "colour", descriptor, e.makeChoices(), { "ROUGE", "VERT" });
+
+    EXPECT_EQ ("e : VERT", read (reader, "GREEN", 1));
+    EXPECT_EQ ("e : ROUGE", read (reader, "RED", 1));
+}
+
+/******************************************************************************/
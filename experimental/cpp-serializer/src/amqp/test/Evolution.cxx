@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include "amqp/Evolution.h"
+#include "amqp/schema/restricted-types/Restricted.h"
+
+#include "TestUtils.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+using namespace amqp::internal::schema;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Every version is the same type, only its descriptor changes
+     */
+    Composite
+    composite (
+        const std::string & descriptor_,
+        std::vector<uPtr<Field>> fields_
+    ) {
+        return test::composite ("root", std::move (fields_), descriptor_);
+    }
+
+    TypeNotation
+    colour (const std::string & descriptor_, std::vector<std::string> choices_) {
+        return test::restricted ("colour", "list", std::move (choices_), descriptor_);
+    }
+
+    uPtr<Field>
+    field (const std::string & name_, bool mandatory_, const std::string & default_ = "") {
+        return test::field (name_, "int", mandatory_, default_);
+    }
+
+    uPtr<const Schema>
+    expecting (TypeNotation type_) {
+        std::vector<TypeNotation> types;
+        types.emplace_back (std::move (type_));
+
+        return std::make_unique<const Schema> (std::move (types));
+    }
+
+    /**
+     * We expect c, then d which the blob doesn't have, then a, the blob
+     * has a, b and c
+     */
+    uPtr<const Schema>
+    reordered() {
+        std::vector<uPtr<Field>> fields;
+        fields.emplace_back (field ("c", true));
+        fields.emplace_back (field ("d", false, "7"));
+        fields.emplace_back (field ("a", true));
+
+        return expecting (TypeNotation (composite ("local", std::move (fields))));
+    }
+
+    Composite
+    written() {
+        std::vector<uPtr<Field>> fields;
+        fields.emplace_back (field ("a", true));
+        fields.emplace_back (field ("b", true));
+        fields.emplace_back (field ("c", true));
+
+        return composite ("remote", std::move (fields));
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Our fields in our order, each read from the blob's field of that name or
+ * given its default
+ */
+TEST (Evolution, layout) { // NOLINT
+    Evolution evolution (reordered());
+
+    auto layout = evolution.layout (written());
+
+    ASSERT_NE (nullptr, layout);
+    EXPECT_EQ ((std::vector<int> { 2, -1, 0 }), layout->source);
+    EXPECT_EQ ((std::vector<std::string> { "c", "d", "a" }), layout->names);
+    EXPECT_EQ ("7", layout->defaults[1]);
+}
+
+/******************************************************************************/
+
+/**
+ * A type with the descriptor we expect, or one we don't expect at all,
+ * is read as written
+ */
+TEST (Evolution, unchanged) { // NOLINT
+    Evolution evolution (reordered());
+
+    std::vector<uPtr<Field>> fields;
+    fields.emplace_back (field ("a", true));
+
+    EXPECT_EQ (nullptr, evolution.layout (composite ("local", std::move (fields))));
+    EXPECT_EQ (0U, evolution.size());
+}
+
+/******************************************************************************/
+
+/**
+ * A field we can't do without that the blob doesn't have
+ */
+TEST (Evolution, missingMandatory) { // NOLINT
+    std::vector<uPtr<Field>> fields;
+    fields.emplace_back (field ("a", true));
+    fields.emplace_back (field ("e", true));
+
+    Evolution evolution (expecting (TypeNotation (composite ("local", std::move (fields)))));
+
+    EXPECT_THROW (evolution.layout (written()), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * Worked out once per pair of descriptors
+ */
+TEST (Evolution, cached) { // NOLINT
+    Evolution evolution (reordered());
+
+    auto first = evolution.layout (written());
+    auto second = evolution.layout (written());
+
+    EXPECT_EQ (first, second);
+    EXPECT_EQ (1U, evolution.size());
+}
+
+/******************************************************************************/
+
+/**
+ * We renamed RED since the blob was written, which was after BLUE was
+ * added with GREEN as its default
+ */
+TEST (Evolution, constants) { // NOLINT
+    std::map<std::string, Transforms::Type, std::less<>> ours;
+    ours["colour"].emplace_back ("Rename", std::vector<std::string> { "RED", "CRIMSON" });
+
+    std::map<std::string, Transforms::Type, std::less<>> theirs;
+    theirs["colour"].emplace_back ("EnumDefault", std::vector<std::string> { "GREEN", "BLUE" });
+
+    Evolution evolution (
+        expecting (colour ("colour-2", { "CRIMSON", "GREEN" })),
+        std::make_unique<const Transforms> (std::move (ours)));
+
+    auto remote = colour ("colour-1", { "RED", "GREEN", "BLUE" });
+
+    auto constants = evolution.constants (
+        remote.get<Enum>(), Transforms (std::move (theirs)));
+
+    ASSERT_NE (nullptr, constants);
+    EXPECT_EQ ((std::vector<std::string> { "CRIMSON", "GREEN", "GREEN" }), *constants);
+}
+
+/******************************************************************************/
+
+/**
+ * Nothing says what it became, so it's read as written
+ */
+TEST (Evolution, unknownConstant) { // NOLINT
+    Evolution evolution (expecting (colour ("colour-2", { "GREEN" })));
+
+    auto remote = colour ("colour-1", { "RED", "GREEN" });
+
+    auto constants = evolution.constants (remote.get<Enum>(), Transforms());
+
+    ASSERT_NE (nullptr, constants);
+    EXPECT_EQ ((std::vector<std::string> { "RED", "GREEN" }), *constants);
+}
+
+/******************************************************************************/
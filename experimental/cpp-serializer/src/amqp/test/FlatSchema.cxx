@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "amqp/PlanFile.h"
+#include "amqp/schema/described-types/FlatSchema.h"
+
+#include "TestUtils.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+using namespace amqp::internal::schema;
+
+/******************************************************************************/
+
+namespace {
+
+    using test::restricted;
+
+    Schema
+    mixed() {
+        std::vector<TypeNotation> types;
+        types.emplace_back (restricted ("colour", "list", { "RED", "GREEN" }));
+        types.emplace_back (restricted ("java.util.List<int>", "list"));
+        types.emplace_back (restricted ("java.util.Map<int, colour>", "map"));
+
+        std::vector<uPtr<Field>> fields;
+        fields.emplace_back (test::field ("a", "colour", true));
+        fields.emplace_back (test::field ("b", "java.util.List<int>"));
+        fields.emplace_back (test::field ("c", "java.util.Map<int, colour>"));
+
+        types.emplace_back (TypeNotation (test::composite (
+            "root", std::move (fields), "", { "java.io.Serializable" })));
+
+        return Schema (std::move (types));
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Everything survives being packed, in the order it was given
+ */
+TEST (FlatSchema, roundTrip) { // NOLINT
+    auto s = mixed();
+    FlatSchema flat (s);
+
+    ASSERT_EQ (4U, flat.size());
+    EXPECT_EQ (FlatSchema::Kind::Enum, flat.type (0).kind);
+    EXPECT_EQ (FlatSchema::Kind::List, flat.type (1).kind);
+    EXPECT_EQ (FlatSchema::Kind::Map, flat.type (2).kind);
+    EXPECT_EQ (FlatSchema::Kind::Composite, flat.type (3).kind);
+
+    EXPECT_EQ (PlanFile::encode (s), PlanFile::encode (*flat.materialise()));
+}
+
+/******************************************************************************/
+
+/**
+ * Types are found by index, each string is held once however often it's
+ * used
+ */
+TEST (FlatSchema, lookup) { // NOLINT
+    auto s = mixed();
+    FlatSchema flat (s);
+
+    auto root = flat.indexOfType ("root");
+    ASSERT_TRUE (root);
+    EXPECT_EQ (3U, *root);
+    EXPECT_EQ (root, flat.indexOfDescriptor ("net.corda:root"));
+    EXPECT_FALSE (flat.indexOfType ("missing"));
+
+    const auto & type = flat.type (*root);
+    ASSERT_EQ (3U, type.fields.count);
+    EXPECT_EQ ("java.io.Serializable", flat.text (type.provides, 0));
+
+    const auto & a = flat.field (type.fields.first);
+    EXPECT_EQ ("a", flat.text (a.name));
+    EXPECT_EQ ("colour", flat.text (a.type));
+    EXPECT_TRUE (a.mandatory);
+
+    EXPECT_EQ (flat.type (0).name.offset, a.type.offset);
+
+    EXPECT_EQ ("RED", flat.text (flat.type (0).choices, 0));
+    EXPECT_EQ ("GREEN", flat.text (flat.type (0).choices, 2));
+}
+
+/******************************************************************************/
+
+/**
+ * Through the schema interfaces types are built once, when first asked for
+ */
+TEST (FlatSchema, interfaces) { // NOLINT
+    auto s = mixed();
+    FlatSchema flat (s);
+
+    auto type = flat.findDescriptor ("net.corda:root");
+    ASSERT_NE (nullptr, type);
+    EXPECT_EQ ("root", type->name());
+    EXPECT_EQ (3U, type->get<Composite>().fields().size());
+
+    EXPECT_EQ (type, flat.findType ("root"));
+    EXPECT_EQ (type, &flat.fromType ("root")->second.get());
+    EXPECT_EQ (nullptr, flat.findType ("missing"));
+}
+
+/******************************************************************************/
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+
+#include "amqp/Hash.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+/**
+ * Against the reference implementation, the last long enough to go
+ * through the 32 byte stripes
+ */
+TEST (Hash, xxh64) { // NOLINT
+    EXPECT_EQ (0xef46db3751d8e999ULL, xxh64 (""));
+    EXPECT_EQ (0xd24ec4f1a98c6e5bULL, xxh64 ("a"));
+    EXPECT_EQ (0x44bc2cf5ad770999ULL, xxh64 ("abc"));
+    EXPECT_EQ (0xfbcea83c8a378bf1ULL, xxh64 ("Nobody inspects the spammish repetition"));
+}
+
+/******************************************************************************/
+
+TEST (Hash, seed) { // NOLINT
+    EXPECT_NE (xxh64 ("abc"), xxh64 ("abc", 1));
+    EXPECT_EQ (xxh64 ("abc", 1), xxh64 ("abc", 1));
+}
+
+/******************************************************************************/
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "amqp/JSON.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::json;
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    escaped (std::string_view value_, Engine engine_ = Engine::Scalar) {
+        std::string rtn;
+        escape (value_, rtn, engine_);
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (JSON, escapes) { // NOLINT
+    EXPECT_EQ ("O=Bank A, L=London, C=GB", escaped ("O=Bank A, L=London, C=GB"));
+    EXPECT_EQ ("say \\\"hi\\\"", escaped ("say \"hi\""));
+    EXPECT_EQ ("C:\\\\corda", escaped ("C:\\corda"));
+    EXPECT_EQ ("a\\nb\\tc\\rd\\be\\ff", escaped ("a\nb\tc\rd\be\ff"));
+    EXPECT_EQ ("\\u0000\\u001f\x7f", escaped (std::string_view ("\0\x1f\x7f", 3)));
+
+    EXPECT_EQ ("\"\"", quoted (""));
+    EXPECT_EQ ("\"\\\"\"", quoted ("\""));
+}
+
+/******************************************************************************/
+
+TEST (JSON, utf8) { // NOLINT
+    // two, three and four byte sequences at either end of their ranges
+    const std::string valid[] = {
+        "\xc2\x80", "\xdf\xbf", "\xe0\xa0\x80", "\xed\x9f\xbf", "\xee\x80\x80",
+        "\xef\xbf\xbf", "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf", "Z\xc3\xbcrich"
+    };
+
+    for (const auto & v : valid) {
+        EXPECT_EQ (v, escaped (v));
+    }
+
+    // overlong, surrogate, beyond U+10FFFF, stray and cut short, a
+    // replacement for every byte
+    EXPECT_EQ ("\xef\xbf\xbd\xef\xbf\xbd", escaped ("\xc0\x80"));
+    EXPECT_EQ ("\xef\xbf\xbd\xef\xbf\xbd\xef\xbf\xbd", escaped ("\xed\xa0\x80"));
+    EXPECT_EQ ("\xef\xbf\xbd", escaped ("\xf5"));
+    EXPECT_EQ ("a\xef\xbf\xbd" "b", escaped ("a\x80" "b"));
+    EXPECT_EQ ("\xef\xbf\xbd\xef\xbf\xbd", escaped ("\xe2\x82"));
+}
+
+/******************************************************************************/
+
+/**
+ * Every engine agrees with the scalar one wherever in a run the odd
+ * character lands, including across and just past the vector widths
+ */
+TEST (JSON, engines) { // NOLINT
+    const std::string odd[] = { "\"", "\\", "\n", "\x01", "\xc3\xbc", "\xe2\x82\xac", "\xff" };
+
+    for (auto engine : amqp::internal::cpu::available (KERNELS)) {
+        for (std::size_t length { 0 } ; length < 80 ; ++length) {
+            for (const auto & o : odd) {
+                for (std::size_t at { 0 } ; at <= length ; ++at) {
+                    std::string value (length, 'x');
+                    value.insert (at, o);
+
+                    EXPECT_EQ (escaped (value), escaped (value, engine));
+                }
+            }
+        }
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "amqp/CompositeFactory.h"
+#include "amqp/LazyCompositeFactory.h"
+
+#include "TestUtils.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+using namespace amqp::internal::schema;
+
+/******************************************************************************/
+
+namespace {
+
+    using Fields = std::vector<std::pair<std::string, std::string>>;
+
+    TypeNotation
+    composite (const std::string & name_, const Fields & fields_) {
+        return TypeNotation (test::composite (name_, test::fields (fields_)));
+    }
+
+    /**
+     * Deliberately out of dependency order, the lazy factory should find
+     * its own way through it
+     */
+    Schema
+    unordered() {
+        std::vector<TypeNotation> types;
+        types.emplace_back (composite ("unused", { { "a", "long" }, { "b", "leaf" } }));
+        types.emplace_back (composite ("root", { { "a", "middle" }, { "b", "int" } }));
+        types.emplace_back (composite ("middle", { { "a", "leaf" } }));
+        types.emplace_back (composite ("leaf", { { "a", "int" } }));
+
+        return Schema (std::move (types));
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Only what the root can reach is built, the rest waits until asked for
+ */
+TEST (LazyCompositeFactory, reachable) { // NOLINT
+    auto s = unordered();
+
+    LazyCompositeFactory cf;
+    cf.process (s);
+
+    EXPECT_EQ (0U, cf.size());
+
+    auto root = cf.byDescriptor ("net.corda:root");
+    ASSERT_NE (nullptr, root);
+    EXPECT_EQ ("root", root->type());
+
+    // root, middle, leaf and int
+    EXPECT_EQ (4U, cf.size());
+
+    // already built, so nothing new
+    EXPECT_NE (nullptr, cf.byType ("leaf"));
+    EXPECT_EQ (4U, cf.size());
+
+    // the same reader whichever way we ask
+    EXPECT_EQ (root, cf.byType ("root"));
+
+    // unused and long
+    EXPECT_NE (nullptr, cf.byDescriptor ("net.corda:unused"));
+    EXPECT_EQ (6U, cf.size());
+
+    EXPECT_EQ (nullptr, cf.byDescriptor ("net.corda:missing"));
+}
+
+/******************************************************************************/
+
+/**
+ * A type whose fields are, eventually, itself is reported rather than
+ * recursing forever
+ */
+TEST (LazyCompositeFactory, cycle) { // NOLINT
+    std::vector<TypeNotation> types;
+    types.emplace_back (composite ("a", { { "b", "b" } }));
+    types.emplace_back (composite ("b", { { "a", "a" } }));
+
+    Schema s (std::move (types));
+
+    LazyCompositeFactory cf;
+    cf.process (s);
+
+    EXPECT_THROW (cf.byType ("a"), std::runtime_error);
+}
+
+/******************************************************************************/
+
+/**
+ * The eager factory needs its schema in dependency order, and never
+ * knowingly misses
+ */
+TEST (LazyCompositeFactory, eager) { // NOLINT
+    auto s = unordered();
+
+    CompositeFactory cf;
+    EXPECT_THROW (cf.process (s), std::runtime_error);
+}
+
+/******************************************************************************/
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "amqp/reader/PropertyReader.h"
+#include "amqp/reader/property-readers/PrimitiveReader.h"
+#include "amqp/schema/field-types/Field.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+TEST (PrimitiveReader, integral) { // NOLINT
+    EXPECT_EQ ("-9223372036854775808", primitives::integral (INT64_MIN));
+    EXPECT_EQ ("18446744073709551615", primitives::integral (UINT64_MAX));
+    EXPECT_EQ ("-1", primitives::Byte::format (-1));
+    EXPECT_EQ ("255", primitives::UByte::format (255));
+}
+
+/******************************************************************************/
+
+TEST (PrimitiveReader, floating) { // NOLINT
+    EXPECT_EQ ("10.100000", primitives::Double::format (10.1));
+    EXPECT_EQ (std::to_string (1e300), primitives::Double::format (1e300));
+
+    std::string out { "[ " };
+    primitives::integral (int64_t { -5 }, out);
+    out += ", ";
+    primitives::floating (-1.7976931348623157e308, out);
+
+    EXPECT_EQ ("[ -5, " + std::to_string (-1.7976931348623157e308), out);
+}
+
+/******************************************************************************/
+
+TEST (PrimitiveReader, text) { // NOLINT
+    EXPECT_EQ ("true", primitives::Boolean::format (true));
+    EXPECT_EQ ("\"hi\"", primitives::String::format ("hi"));
+    EXPECT_EQ ("\"hi\"", primitives::Symbol::format ("hi"));
+    EXPECT_EQ ("\"\xE2\x82\xAC\"", primitives::Char::format (0x20AC));
+    EXPECT_EQ ("\"\\\"\"", primitives::Char::format ('"'));
+    EXPECT_EQ ("\"a\\nb\"", primitives::Symbol::format ("a\nb"));
+    EXPECT_EQ ("\"00FF10\"", primitives::Binary::format (std::string ("\x00\xFF\x10", 3)));
+}
+
+/******************************************************************************/
+
+/**
+ * Surrogates and anything past U+10FFFF aren't characters at all
+ */
+TEST (PrimitiveReader, utf8) { // NOLINT
+    EXPECT_EQ ("A", primitives::utf8 (0x41));
+    EXPECT_EQ ("\xF0\x9F\x98\x80", primitives::utf8 (0x1F600));
+    EXPECT_EQ ("\xF4\x8F\xBF\xBF", primitives::utf8 (0x10FFFF));
+
+    for (uint32_t cp : { 0xD800U, 0xDBFFU, 0xDC00U, 0xDFFFU, 0x110000U, 0xFFFFFFFFU }) {
+        EXPECT_EQ ("\xEF\xBF\xBD", primitives::utf8 (cp)) << cp;
+    }
+
+    EXPECT_EQ ("\"\xEF\xBF\xBD\"", primitives::Char::format (0xD800));
+}
+
+/******************************************************************************/
+
+TEST (PrimitiveReader, uuid) { // NOLINT
+    pn_uuid_t uuid { {
+        0x12, 0x34, 0x56, 0x78, (char)0x9a, (char)0xbc, (char)0xde, (char)0xf0,
+        0x01, 0x23, 0x45, 0x67, (char)0x89, (char)0xab, (char)0xcd, (char)0xef
+    } };
+
+    EXPECT_EQ ("12345678-9abc-def0-0123-456789abcdef", primitives::uuid (uuid));
+    EXPECT_EQ ("\"12345678-9abc-def0-0123-456789abcdef\"", primitives::UUID::format (uuid));
+
+    // and as it's read off the wire, a string as far as JSON's concerned
+    auto data = pn_data (0);
+    pn_data_put_uuid (data, uuid);
+    pn_data_rewind (data);
+    pn_data_next (data);
+
+    EXPECT_EQ (
+        "\"12345678-9abc-def0-0123-456789abcdef\"",
+        PropertyReader::make ("uuid")->readString (data));
+
+    pn_data_free (data);
+}
+
+/******************************************************************************/
+
+TEST (PrimitiveReader, registry) { // NOLINT
+    EXPECT_EQ (20, PropertyReader::primitives().size());
+    EXPECT_EQ ("timestamp", PropertyReader::typeOf (PN_TIMESTAMP));
+    EXPECT_EQ ("char", PropertyReader::make ("char")->type());
+    EXPECT_THROW (PropertyReader::make ("not.a.Type"), std::runtime_error);
+    EXPECT_THROW (PropertyReader::typeOf (PN_LIST), std::runtime_error);
+
+    for (const auto & primitive : PropertyReader::primitives()) {
+        EXPECT_TRUE (amqp::internal::schema::Field::typeIsPrimitive (primitive));
+    }
+
+    EXPECT_FALSE (amqp::internal::schema::Field::typeIsPrimitive ("java.lang.Integer"));
+}
+
+/******************************************************************************/
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "amqp/SHA256.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::sha256;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Lengths either side of where the padding spills into a second block
+     */
+    std::vector<std::string>
+    messages() {
+        std::vector<std::string> rtn;
+        for (std::size_t i { 0 } ; i < 300 ; i += (i < 130 ? 1 : 17)) {
+            std::string message (i, '\0');
+            for (std::size_t j { 0 } ; j < i ; ++j) {
+                message[j] = static_cast<char>(j * 31 + i);
+            }
+            rtn.push_back (std::move (message));
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * FIPS 180-2's examples, on every engine this machine has
+ */
+TEST (SHA256, vectors) { // NOLINT
+    for (auto engine : amqp::internal::cpu::available (KERNELS)) {
+        EXPECT_EQ (
+            "E3B0C44298FC1C149AFBF4C8996FB92427AE41E4649B934CA495991B7852B855",
+            toString (hash ("", engine)));
+        EXPECT_EQ (
+            "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD",
+            toString (hash ("abc", engine)));
+        EXPECT_EQ (
+            "248D6A61D20638B8E5C026930C3E6039A33CE45964FF2167F6ECEDD419DB06C1",
+            toString (hash ("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", engine)));
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Hashed together, messages of all different lengths come out as they
+ * do one at a time
+ */
+TEST (SHA256, several) { // NOLINT
+    auto all = messages();
+    std::vector<std::string_view> views (all.begin(), all.end());
+
+    std::vector<Digest> expected;
+    for (const auto & message : all) {
+        expected.push_back (hash (message, Engine::Scalar));
+    }
+
+    for (auto engine : amqp::internal::cpu::available (KERNELS)) {
+        EXPECT_EQ (expected, hash (views, engine));
+    }
+
+    EXPECT_TRUE (hash (std::vector<std::string_view> { }).empty());
+}
+
+/******************************************************************************/
@@ -4,9 +4,15 @@
 #include <string>
 #include "types.h"
 
-#include "restricted-types/Map.h"
-#include "restricted-types/List.h"
-#include "restricted-types/Enum.h"
+#include <proton/codec.h>
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/schema/described-types/Choice.h"
+#include "amqp/schema/described-types/Descriptor.h"
+#include "amqp/schema/restricted-types/Map.h"
+#include "amqp/schema/restricted-types/List.h"
+#include "amqp/schema/restricted-types/Enum.h"
+#include "amqp/schema/restricted-types/Restricted.h"
 
 /******************************************************************************/
 
@@ -124,3 +130,142 @@ comp (
 }
 
 /******************************************************************************/
+
+std::string_view
+test::
+body (const std::string & blob_) {
+    return std::string_view (blob_).substr (amqp::AMQP_HEADER.size() + 1);
+}
+
+/******************************************************************************/
+
+uPtr<Field>
+test::
+field (
+    const std::string & name_,
+    const std::string & type_,
+    bool mandatory_,
+    const std::string & default_
+) {
+    return Field::make (name_, type_, { }, default_, "", mandatory_, false);
+}
+
+/******************************************************************************/
+
+std::vector<uPtr<Field>>
+test::
+fields (const std::vector<std::pair<std::string, std::string>> & fields_) {
+    std::vector<uPtr<Field>> rtn;
+
+    for (const auto & [ name, type ] : fields_) {
+        rtn.emplace_back (field (name, type));
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+Composite
+test::
+composite (
+    const std::string & name_,
+    std::vector<uPtr<Field>> fields_,
+    const std::string & descriptor_,
+    std::list<std::string> provides_
+) {
+    return Composite (
+        name_, "", std::move (provides_),
+        std::make_unique<Descriptor> (
+            "net.corda:" + (descriptor_.empty() ? name_ : descriptor_)),
+        std::move (fields_));
+}
+
+/******************************************************************************/
+
+TypeNotation
+test::
+restricted (
+    const std::string & name_,
+    const std::string & source_,
+    std::vector<std::string> choices_,
+    const std::string & descriptor_
+) {
+    std::vector<uPtr<Choice>> choices;
+    for (auto & choice : choices_) {
+        choices.emplace_back (std::make_unique<Choice> (std::move (choice), ""));
+    }
+
+    return std::move (*Restricted::make (
+        std::make_unique<Descriptor> (
+            "net.corda:" + (descriptor_.empty() ? name_ : descriptor_)),
+        name_, "", { }, source_, std::move (choices)));
+}
+
+/******************************************************************************
+ *
+ * test::BlobBuilder
+ *
+ ******************************************************************************/
+
+test::
+BlobBuilder::BlobBuilder()
+    : m_data (pn_data (0))
+{
+}
+
+/******************************************************************************/
+
+test::
+BlobBuilder::~BlobBuilder() {
+    pn_data_free (m_data);
+}
+
+/******************************************************************************/
+
+pn_data_t *
+test::
+BlobBuilder::data() const {
+    return m_data;
+}
+
+/******************************************************************************/
+
+test::BlobBuilder &
+test::
+BlobBuilder::described (const std::string & descriptor_) {
+    pn_data_put_described (m_data);
+    pn_data_enter (m_data);
+    pn_data_put_symbol (m_data, pn_bytes (descriptor_.size(), descriptor_.data()));
+    pn_data_put_list (m_data);
+    pn_data_enter (m_data);
+
+    return *this;
+}
+
+/******************************************************************************/
+
+test::BlobBuilder &
+test::
+BlobBuilder::exit() {
+    pn_data_exit (m_data);
+    pn_data_exit (m_data);
+
+    return *this;
+}
+
+/******************************************************************************/
+
+std::string
+test::
+BlobBuilder::blob (const amqp::internal::encoding::SchemaWriter & schema_) const {
+    std::string value;
+    amqp::internal::encoding::encode (m_data, value);
+
+    std::string rtn;
+    amqp::internal::encoding::envelope (rtn, value, schema_.encode());
+
+    return rtn;
+}
+
+/******************************************************************************/
@@ -1,8 +1,20 @@
 #pragma once
 
 #include <string>
-#include "restricted-types/List.h"
-#include "restricted-types/Map.h"
+#include <vector>
+#include <utility>
+#include <string_view>
+
+#include "amqp/Encoding.h"
+#include "amqp/schema/TypeNotation.h"
+#include "amqp/schema/field-types/Field.h"
+#include "amqp/schema/described-types/Composite.h"
+#include "amqp/schema/restricted-types/List.h"
+#include "amqp/schema/restricted-types/Map.h"
+
+/******************************************************************************/
+
+struct pn_data_t;
 
 /******************************************************************************/
 
@@ -18,6 +30,77 @@ namespace test {
 
     uPtr <amqp::internal::schema::Composite>
     comp (const std::string & name_, const std::vector<std::string> &);
+
+    /**
+     * Past the header and encoding byte, as CordaBytes would give it us
+     */
+    std::string_view body (const std::string & blob_);
+
+    uPtr<amqp::internal::schema::Field>
+    field (
+        const std::string & name_,
+        const std::string & type_,
+        bool mandatory_ = false,
+        const std::string & default_ = "");
+
+    /**
+     * Optional fields, each a name and a type
+     */
+    std::vector<uPtr<amqp::internal::schema::Field>>
+    fields (const std::vector<std::pair<std::string, std::string>> & fields_);
+
+    /**
+     * Described as "net.corda:" and [descriptor_], or [name_] if that's
+     * empty
+     */
+    amqp::internal::schema::Composite
+    composite (
+        const std::string & name_,
+        std::vector<uPtr<amqp::internal::schema::Field>> fields_,
+        const std::string & descriptor_ = "",
+        std::list<std::string> provides_ = { });
+
+    /**
+     * A list, map or, given [choices_], an enum, described as [composite]
+     * describes its types
+     */
+    amqp::internal::schema::TypeNotation
+    restricted (
+        const std::string & name_,
+        const std::string & source_,
+        std::vector<std::string> choices_ = { },
+        const std::string & descriptor_ = "");
+
+    /**
+     * Builds a blob's value a node at a time then wraps it, along with
+     * the schema it's written against, into a whole blob
+     */
+    class BlobBuilder {
+        private :
+            pn_data_t * m_data;
+
+        public :
+            BlobBuilder();
+            BlobBuilder (const BlobBuilder &) = delete;
+            ~BlobBuilder();
+
+            /**
+             * For putting the primitives
+             */
+            pn_data_t * data() const;
+
+            /**
+             * Start a value described by [descriptor_], whatever's put
+             * until the matching [exit] being its fields or elements
+             */
+            BlobBuilder & described (const std::string & descriptor_);
+            BlobBuilder & exit();
+
+            /**
+             * Header and all
+             */
+            std::string blob (const amqp::internal::encoding::SchemaWriter & schema_) const;
+    };
 }
 
 /******************************************************************************/
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "amqp/ReaderCache.h"
+#include "amqp/Transaction.h"
+
+#include "serialiser/Serialiser.h"
+
+#include "TestUtils.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+using namespace amqp::internal::transaction;
+
+/******************************************************************************/
+
+namespace {
+
+    using test::body;
+
+    OpaqueBytes
+    bytes (const std::string & string_) {
+        return OpaqueBytes { binding::Bytes (string_.begin(), string_.end()) };
+    }
+
+    /**
+     * Group 1 is missing, so hashed as all ones
+     */
+    WireTransaction
+    wire() {
+        WireTransaction rtn;
+
+        for (int i { 0 } ; i < 32 ; ++i) {
+            rtn.privacySalt.bytes.push_back (static_cast<uint8_t>(i));
+        }
+
+        rtn.componentGroups.push_back (ComponentGroup {
+            0, { bytes ("alpha"), bytes ("beta"), bytes ("gamma") } });
+        rtn.componentGroups.push_back (ComponentGroup {
+            2, { bytes (std::string (100, 'x')) } });
+
+        return rtn;
+    }
+
+    /**
+     * Worked out with an independent implementation of Corda's scheme
+     */
+    const std::string wireId { // NOLINT
+        "31D3FA4E136BCAA432E806AA8A61CA03B25886AE7C6BD23BA9E6A39CE2B24ED5" };
+
+}
+
+/******************************************************************************/
+
+/**
+ * Padded with zero hashes, and a single leaf is its own root
+ */
+TEST (Transaction, merkleRoot) { // NOLINT
+    auto a = sha256::hash ("a");
+
+    EXPECT_EQ (a, merkleRoot ({ a }));
+    EXPECT_EQ (
+        "D0A664079D491A97357EFA1CE1EAB5AEB566ADEF78A2B910E8D13E901E192832",
+        sha256::toString (merkleRoot ({ a, sha256::hash ("b"), sha256::hash ("c") })));
+
+    EXPECT_THROW (merkleRoot ({ }), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Transaction, id) { // NOLINT
+    for (auto engine : cpu::available (sha256::KERNELS)) {
+        EXPECT_EQ (wireId, sha256::toString (id (wire(), engine)));
+    }
+
+    auto unsalted = wire();
+    unsalted.privacySalt.bytes.pop_back();
+    EXPECT_THROW (id (unsalted), std::runtime_error); // NOLINT
+
+    auto duplicated = wire();
+    duplicated.componentGroups.push_back (duplicated.componentGroups.front());
+    EXPECT_THROW (id (duplicated), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * From a blob of the transaction itself or of one signed, which carries
+ * the transaction as a nested blob
+ */
+TEST (Transaction, fromBlob) { // NOLINT
+    serialiser::Serialiser serialiser;
+    binding::Binder binder;
+    ReaderCache cache;
+
+    auto wireBlob = serialiser.serialise (wire());
+
+    EXPECT_EQ (wireId, sha256::toString (id (body (wireBlob), binder, cache)));
+
+    SignedTransaction signedTx;
+    signedTx.txBits.bytes.assign (wireBlob.begin(), wireBlob.end());
+
+    auto signedBlob = serialiser.serialise (signedTx);
+
+    EXPECT_EQ (wireId, sha256::toString (id (body (signedBlob), binder, cache)));
+
+    // a signed transaction's bits are the transaction, never another
+    // signed one to be unwrapped in turn
+    SignedTransaction twice;
+    twice.txBits.bytes.assign (signedBlob.begin(), signedBlob.end());
+
+    EXPECT_THROW (
+        id (body (serialiser.serialise (twice)), binder, cache),
+        std::runtime_error);
+}
+
+/******************************************************************************/
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "proton/codec.h"
+
+#include "amqp/Binary.h"
+#include "amqp/reader/well-known-readers/BytesReader.h"
+#include "amqp/reader/well-known-readers/InstantReader.h"
+#include "amqp/reader/well-known-readers/ToStringReader.h"
+#include "amqp/schema/descriptors/corda-descriptors/RestrictedDescriptor.h"
+
+#include "TestUtils.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+namespace {
+
+    const std::string descriptor { "net.corda:well-known" }; // NOLINT
+
+    /**
+     * Leaves the cursor on what [builder_] built
+     */
+    pn_data_t *
+    rewound (const test::BlobBuilder & builder_) {
+        pn_data_rewind (builder_.data());
+        pn_data_next (builder_.data());
+
+        return builder_.data();
+    }
+
+    std::string
+    instant (int64_t seconds_, int32_t nanos_) {
+        test::BlobBuilder builder;
+
+        builder.described (descriptor);
+        pn_data_put_long (builder.data(), seconds_);
+        pn_data_put_int (builder.data(), nanos_);
+        builder.exit();
+
+        return InstantReader().readString (rewound (builder));
+    }
+
+    /**
+     * [bytes_] wrapped in a composite, as OpaqueBytes and SecureHash are
+     */
+    void
+    wrapped (test::BlobBuilder & builder_, const std::string & bytes_) {
+        builder_.described (descriptor);
+        pn_data_put_binary (builder_.data(), pn_bytes (bytes_.size(), bytes_.data()));
+        builder_.exit();
+    }
+
+    /**
+     * A described string, or with [binary_] binary, as the custom
+     * serialisers write them
+     */
+    void
+    bare (test::BlobBuilder & builder_, const std::string & value_, bool binary_) {
+        auto data = builder_.data();
+
+        pn_data_put_described (data);
+        pn_data_enter (data);
+        pn_data_put_symbol (data, pn_bytes (descriptor.size(), descriptor.data()));
+
+        if (binary_) {
+            pn_data_put_binary (data, pn_bytes (value_.size(), value_.data()));
+        } else {
+            pn_data_put_string (data, pn_bytes (value_.size(), value_.data()));
+        }
+
+        pn_data_exit (data);
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * As Instant.toString has them, either side of the epoch and with each
+ * width of fraction
+ */
+TEST (WellKnownReader, instant) { // NOLINT
+    EXPECT_EQ ("1970-01-01T00:00:00Z", instant (0, 0));
+    EXPECT_EQ ("2001-09-09T01:46:40.500Z", instant (1000000000, 500000000));
+    EXPECT_EQ ("2000-02-29T12:00:00.000001Z", instant (951825600, 1000));
+    EXPECT_EQ ("1969-12-31T23:59:59.123456789Z", instant (-1, 123456789));
+
+    test::BlobBuilder builder;
+    builder.described (descriptor);
+    pn_data_put_long (builder.data(), 60);
+    pn_data_put_int (builder.data(), 7);
+    builder.exit();
+
+    auto i = std::any_cast<InstantReader::Instant> (InstantReader().read (rewound (builder)));
+
+    EXPECT_EQ (60, i.seconds);
+    EXPECT_EQ (7, i.nanos);
+
+    test::BlobBuilder wrong;
+    wrong.described (descriptor);
+    pn_data_put_int (wrong.data(), 60);
+    wrong.exit();
+
+    EXPECT_THROW (InstantReader().readString (rewound (wrong)), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * Upper case hex, as Corda's toString has them, whether wrapped or not
+ */
+TEST (WellKnownReader, bytes) { // NOLINT
+    const std::string bytes { "\x00\x01\xab\xff", 4 };
+
+    test::BlobBuilder opaque;
+    wrapped (opaque, bytes);
+
+    BytesReader opaqueReader ("net.corda.core.utilities.OpaqueBytes", true);
+
+    EXPECT_EQ ("\"0001ABFF\"", opaqueReader.readString (rewound (opaque)));
+    EXPECT_EQ (
+        (std::vector<uint8_t> { 0x00, 0x01, 0xab, 0xff }),
+        std::any_cast<std::vector<uint8_t>> (opaqueReader.read (rewound (opaque))));
+
+    test::BlobBuilder key;
+    bare (key, bytes, true);
+
+    EXPECT_EQ (
+        "\"0001ABFF\"",
+        BytesReader ("java.security.PublicKey", false).readString (rewound (key)));
+
+    amqp::Rendering rendering;
+    rendering.binary = amqp::Rendering::Binary::Base64;
+
+    amqp::internal::binary::Scope scope (rendering);
+    EXPECT_EQ ("\"AAGr/w==\"", opaqueReader.readString (rewound (opaque)));
+}
+
+/******************************************************************************/
+
+/**
+ * A hash is exactly 32 bytes, rendered as hex
+ */
+TEST (WellKnownReader, sha256) { // NOLINT
+    std::string hash (32, '\0');
+    for (std::size_t i { 0 } ; i < hash.size() ; ++i) {
+        hash[i] = static_cast<char>(i * 8);
+    }
+
+    test::BlobBuilder builder;
+    wrapped (builder, hash);
+
+    SHA256Reader reader;
+
+    EXPECT_EQ (
+        "\"0008101820283038404850586068707880889098A0A8B0B8C0C8D0D8E0E8F0F8\"",
+        reader.readString (rewound (builder)));
+
+    auto read = std::any_cast<std::array<uint8_t, 32>> (reader.read (rewound (builder)));
+
+    EXPECT_EQ (0x00, read[0]);
+    EXPECT_EQ (0xf8, read[31]);
+
+    test::BlobBuilder shortHash;
+    wrapped (shortHash, hash.substr (1));
+
+    EXPECT_THROW (reader.read (rewound (shortHash)), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * The string written is the rendering
+ */
+TEST (WellKnownReader, toString) { // NOLINT
+    ToStringReader reader ("javax.security.auth.x500.X500Principal");
+
+    test::BlobBuilder builder;
+    bare (builder, "O=Bank A, L=London, C=GB", false);
+
+    EXPECT_EQ ("O=Bank A, L=London, C=GB", reader.readString (rewound (builder)));
+    EXPECT_EQ (
+        "O=Bank A, L=London, C=GB",
+        std::any_cast<std::string> (reader.read (rewound (builder))));
+
+    test::BlobBuilder binary;
+    bare (binary, "1.50", true);
+
+    EXPECT_THROW (reader.readString (rewound (binary)), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * They're found by name, and only those we know are let through a schema
+ */
+TEST (WellKnownReader, make) { // NOLINT
+    using amqp::internal::schema::descriptors::RestrictedDescriptor;
+
+    EXPECT_EQ ("java.math.BigDecimal", WellKnownReader::make ("java.math.BigDecimal")->type());
+    EXPECT_EQ (nullptr, WellKnownReader::make ("java.util.UUID"));
+
+    EXPECT_FALSE (RestrictedDescriptor::customSerialised ("java.util.List<int>", "list"));
+    EXPECT_FALSE (RestrictedDescriptor::customSerialised ("java.util.Map<int, int>", "map"));
+    EXPECT_TRUE (RestrictedDescriptor::customSerialised ("java.time.Instant", "java.time.Instant$Proxy"));
+    EXPECT_THROW ( // NOLINT
+        RestrictedDescriptor::customSerialised ("java.util.UUID", "string"),
+        std::runtime_error);
+}
+
+/******************************************************************************/
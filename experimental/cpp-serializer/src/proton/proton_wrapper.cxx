@@ -2,6 +2,7 @@
 
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 #include <iostream>
 
 #include <proton/types.h>
@@ -105,6 +106,27 @@ proton::is_symbol (pn_data_t * data_) {
 
 /******************************************************************************/
 
+/**
+ * Check the current node is the symbol [expected_], comparing it in place
+ * rather than copying it out of the proton buffer first
+ */
+void
+proton::is_symbol (pn_data_t * data_, const std::string & expected_) {
+    is_symbol (data_);
+
+    auto symbol = pn_data_get_symbol (data_);
+
+    if (symbol.size != expected_.size()
+        || !std::equal (symbol.start, symbol.start + symbol.size, expected_.begin()))
+    {
+        throw std::runtime_error (
+            "Expected " + expected_ + " but found "
+                + std::string (symbol.start, symbol.size));
+    }
+}
+
+/******************************************************************************/
+
 void
 proton::is_list (pn_data_t * data_) {
     if (pn_data_type(data_) != PN_LIST) {
@@ -4,6 +4,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <sys/types.h>
 
 #include <proton/types.h>
 #include <proton/codec.h>
@@ -28,6 +29,7 @@ namespace proton {
     void is_list (pn_data_t *);
     void is_ulong (pn_data_t *);
     void is_symbol (pn_data_t *);
+    void is_symbol (pn_data_t *, const std::string &);
     void is_string (pn_data_t *, bool allowNull = false);
     void is_described (pn_data_t *);
 
@@ -104,6 +106,17 @@ namespace proton {
         return T{};
     }
 
+    /*
+     * Specialisations live in proton_wrapper.cxx, they need declaring here
+     * otherwise callers silently instantiate the default above instead
+     */
+    template<> int32_t readAndNext<int32_t> (pn_data_t *, bool);
+    template<> std::string readAndNext<std::string> (pn_data_t *, bool);
+    template<> bool readAndNext<bool> (pn_data_t *, bool);
+    template<> double readAndNext<double> (pn_data_t *, bool);
+    template<> long readAndNext<long> (pn_data_t *, bool);
+    template<> u_long readAndNext<u_long> (pn_data_t *, bool);
+
 }
 
 /******************************************************************************/